@@ -0,0 +1,52 @@
+#pragma once
+
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "types.hpp"
+
+#include <vector>
+
+namespace raymino
+{
+/**
+ * @brief standard playfield with hidden rows, the size the game runs at
+ */
+constexpr Size FIELD_SIZE{10, 24};
+
+/**
+ * @brief mid game playfield, deterministic so runs stay comparable
+ * @param stackHeight rows from the bottom that hold cells
+ * @param fullRows of stackHeight at the bottom without holes, ready to be cleared
+ * @return Grid rows with a single hole each & a jagged surface in the top two rows
+ */
+inline Grid makeStack(int stackHeight, int fullRows = 0)
+{
+	std::vector<Grid::Cell> cells(FIELD_SIZE.area(), 0);
+	for(int row = 0; row < stackHeight; ++row)
+	{
+		const int yPos = FIELD_SIZE.height - 1 - row;
+		const int hole = row < fullRows ? -1 : ((row * 7) + 3) % FIELD_SIZE.width;
+		const bool isSurface = row >= stackHeight - 2;
+		for(int xPos = 0; xPos < FIELD_SIZE.width; ++xPos)
+		{
+			const bool isGap = xPos == hole || (isSurface && (xPos + row) % 3 == 0);
+			cells[static_cast<size_t>((yPos * FIELD_SIZE.width) + xPos)] =
+			    isGap ? Grid::Cell{0} : static_cast<Grid::Cell>(1 + ((xPos + row) % 7));
+		}
+	}
+	return Grid{FIELD_SIZE, cells};
+}
+
+/**
+ * @param field playfield to drop into
+ * @param tetromino at its spawn rotation
+ * @param xPos column of the left edge of the collision
+ * @return Tetromino resting on the stack
+ */
+inline Tetromino dropped(const Grid& field, Tetromino tetromino, int xPos)
+{
+	tetromino.position = {xPos, 0};
+	tetromino.position.y += field.dropDistance(tetromino.position, tetromino.collision());
+	return tetromino;
+}
+} // namespace raymino
@@ -0,0 +1,208 @@
+#include "gameplay.hpp"
+
+#include "boards.hpp"
+#include "grid.hpp"
+#include "input.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "types.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace raymino;
+
+namespace
+{
+template<RotationSystem TSys>
+void benchmarkBasicRotation(const char* name)
+{
+	const std::vector<Tetromino> tetrominos = makeBaseMinos<TSys>();
+
+	BENCHMARK(name)
+	{
+		int sum = 0;
+		for(Tetromino tetromino : tetrominos)
+		{
+			for(int rotation = 0; rotation < 4; ++rotation)
+			{
+				tetromino.rotation = rotation;
+				sum += basicRotation<TSys>(tetromino, 1).rotation + basicRotation<TSys>(tetromino, -1).position.x;
+			}
+		}
+		return sum;
+	};
+}
+
+template<WallKicks TSys>
+void benchmarkWallKick(const char* name)
+{
+	// Tetrominos resting in the stack & against both walls, where the basic rotation tends to fail
+	const Grid field = makeStack(8);
+	std::vector<Tetromino> tetrominos;
+	for(const Tetromino& tetromino : makeBaseMinos<RotationSystem::Super>())
+	{
+		for(const int xPos : {0, 3, FIELD_SIZE.width - tetromino.collision().getSize().width})
+		{
+			tetrominos.push_back(dropped(field, tetromino, xPos));
+		}
+	}
+
+	BENCHMARK(name)
+	{
+		int sum = 0;
+		for(const Tetromino& tetromino : tetrominos)
+		{
+			const Offset right = basicRotation<RotationSystem::Super>(tetromino, 1);
+			const Offset left = basicRotation<RotationSystem::Super>(tetromino, -1);
+			sum += wallKick<TSys>(field, tetromino, right).position.x + wallKick<TSys>(field, tetromino, left).rotation;
+		}
+		return sum;
+	};
+}
+
+template<TSpin TTSpin>
+void benchmarkTSpinCheck(const char* name)
+{
+	const Grid field = makeStack(8);
+	const std::vector<Tetromino> tetrominos = makeBaseMinos<RotationSystem::Super>();
+	std::vector<Tetromino> minosT;
+	for(int xPos = 0; xPos + 3 <= FIELD_SIZE.width; ++xPos)
+	{
+		minosT.push_back(dropped(field, *find(tetrominos, TetrominoType::T), xPos));
+	}
+	const Offset lastMovement{{0, 0}, 1};
+
+	BENCHMARK(name)
+	{
+		size_t spins = 0;
+		for(const Tetromino& minoT : minosT)
+		{
+			spins += static_cast<size_t>(tSpinCheck<TTSpin>(field, minoT, lastMovement) != ScoreEvent::LineClear);
+		}
+		return spins;
+	};
+}
+
+template<ShuffleType TType>
+void benchmarkShuffledIndices(const char* name)
+{
+	const std::vector<Tetromino> tetrominos = makeBaseMinos<RotationSystem::Super>();
+	AnyShuffledIndices shuffled = makeShuffledIndices<TType>(tetrominos);
+	std::mt19937_64 rng{42};
+	IndexQueue indices;
+
+	// refill the preview the way Game does after every locked piece
+	BENCHMARK(name)
+	{
+		size_t sum = 0;
+		for(int piece = 0; piece < 100; ++piece)
+		{
+			shuffled.fill(indices, 7, rng);
+			sum += indices.front();
+			indices.pop_front();
+		}
+		return sum;
+	};
+}
+} // namespace
+
+TEST_CASE("eraseFullLines", "[gameplay][benchmark]")
+{
+	const Grid field = makeStack(12, 4);
+
+	BENCHMARK_ADVANCED("4 of 12 rows full")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<Grid> fields(static_cast<size_t>(meter.runs()), field);
+		meter.measure(
+		    [&](int run)
+		    {
+			    return eraseFullLines(fields[static_cast<size_t>(run)]);
+		    });
+	};
+}
+
+TEST_CASE("countFullLines", "[gameplay][benchmark]")
+{
+	const Grid field = makeStack(12, 2);
+	const std::vector<Tetromino> tetrominos = makeBaseMinos<RotationSystem::Super>();
+	std::vector<Tetromino> resting;
+	for(const Tetromino& tetromino : tetrominos)
+	{
+		resting.push_back(dropped(field, tetromino, 2));
+	}
+
+	BENCHMARK("all Tetrominos")
+	{
+		size_t lines = 0;
+		for(const Tetromino& tetromino : resting)
+		{
+			lines += countFullLines(field, tetromino);
+		}
+		return lines;
+	};
+}
+
+TEST_CASE("basicRotation", "[gameplay][benchmark]")
+{
+	benchmarkBasicRotation<RotationSystem::Original>("Original");
+	benchmarkBasicRotation<RotationSystem::Super>("Super");
+	benchmarkBasicRotation<RotationSystem::Arika>("Arika");
+	benchmarkBasicRotation<RotationSystem::Sega>("Sega");
+	benchmarkBasicRotation<RotationSystem::NintendoLeft>("NintendoLeft");
+	benchmarkBasicRotation<RotationSystem::NintendoRight>("NintendoRight");
+}
+
+TEST_CASE("wallKick", "[gameplay][benchmark]")
+{
+	benchmarkWallKick<WallKicks::None>("None");
+	benchmarkWallKick<WallKicks::Arika>("Arika");
+	benchmarkWallKick<WallKicks::Super>("Super");
+}
+
+TEST_CASE("tSpinCheck", "[gameplay][benchmark]")
+{
+	benchmarkTSpinCheck<TSpin::Immobile>("Immobile");
+	benchmarkTSpinCheck<TSpin::ThreeCorner>("ThreeCorner");
+	benchmarkTSpinCheck<TSpin::Lenient>("Lenient");
+	benchmarkTSpinCheck<TSpin::None>("None");
+}
+
+TEST_CASE("AnyShuffledIndices::fill", "[gameplay][benchmark]")
+{
+	benchmarkShuffledIndices<ShuffleType::Random>("Random");
+	benchmarkShuffledIndices<ShuffleType::SingleBag>("SingleBag");
+	benchmarkShuffledIndices<ShuffleType::DoubleBag>("DoubleBag");
+	benchmarkShuffledIndices<ShuffleType::TripleBag>("TripleBag");
+	benchmarkShuffledIndices<ShuffleType::TGMH4>("TGMH4");
+	benchmarkShuffledIndices<ShuffleType::TGM35>("TGM35");
+	benchmarkShuffledIndices<ShuffleType::NES>("NES");
+}
+
+TEST_CASE("Simulation::save", "[gameplay][benchmark]")
+{
+	const Settings settings;
+	Simulation simulation{settings, 42, PieceColors{1, 2, 3, 4, 5, 6, 7}};
+	InputSnapshot drop;
+	drop.set(InputSnapshot::HardDrop, true, true, false);
+	for(int piece = 0; piece < 20; ++piece)
+	{
+		simulation.step(1.0f / 60, drop);
+	}
+	const Simulation::Snapshot snapshot = simulation.save();
+
+	BENCHMARK("save")
+	{
+		return simulation.save();
+	};
+	BENCHMARK("restore")
+	{
+		simulation.restore(snapshot);
+		return simulation.score;
+	};
+}
@@ -0,0 +1,119 @@
+#include "grid.hpp"
+
+#include "boards.hpp"
+#include "gameplay.hpp"
+#include "smallgrid.hpp"
+#include "types.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <vector>
+
+using namespace raymino;
+
+TEST_CASE("Grid::overlapAt", "[Grid][benchmark]")
+{
+	const Grid field = makeStack(8);
+	const std::vector<Tetromino> tetrominos = makeBaseMinos<RotationSystem::Super>();
+	const Tetromino& minoT = *find(tetrominos, TetrominoType::T);
+	const Grid gridT{minoT.collision().getSize(), {0, 1, 0, 1, 1, 1, 0, 0, 0}};
+
+	// every position a T can take in the rows around the surface of the stack
+	BENCHMARK("PieceGrid")
+	{
+		size_t overlaps = 0;
+		for(int rotation = 0; rotation < 4; ++rotation)
+		{
+			for(int yPos = 10; yPos < 18; ++yPos)
+			{
+				for(int xPos = -1; xPos < FIELD_SIZE.width; ++xPos)
+				{
+					overlaps += field.overlapAt({xPos, yPos}, minoT.collision(rotation));
+				}
+			}
+		}
+		return overlaps;
+	};
+	BENCHMARK("Grid")
+	{
+		size_t overlaps = 0;
+		for(int yPos = 10; yPos < 18; ++yPos)
+		{
+			for(int xPos = -1; xPos < FIELD_SIZE.width; ++xPos)
+			{
+				overlaps += field.overlapAt({xPos, yPos}, gridT);
+			}
+		}
+		return overlaps;
+	};
+}
+
+TEST_CASE("Grid::dropDistance", "[Grid][benchmark]")
+{
+	const Grid field = makeStack(8);
+	const std::vector<Tetromino> tetrominos = makeBaseMinos<RotationSystem::Super>();
+
+	BENCHMARK("all Tetrominos & columns")
+	{
+		int distance = 0;
+		for(const Tetromino& tetromino : tetrominos)
+		{
+			for(int xPos = 0; xPos + tetromino.collision().getSize().width <= FIELD_SIZE.width; ++xPos)
+			{
+				distance += field.dropDistance({xPos, 0}, tetromino.collision());
+			}
+		}
+		return distance;
+	};
+}
+
+TEST_CASE("Grid::setAt", "[Grid][benchmark]")
+{
+	const Grid field = makeStack(8);
+	const std::vector<Tetromino> tetrominos = makeBaseMinos<RotationSystem::Super>();
+	const Tetromino tetromino = dropped(field, *find(tetrominos, TetrominoType::L), 4);
+
+	BENCHMARK_ADVANCED("lock Tetromino")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<Grid> fields(static_cast<size_t>(meter.runs()), field);
+		meter.measure(
+		    [&](int run)
+		    {
+			    Grid& target = fields[static_cast<size_t>(run)];
+			    target.setAt(tetromino.position, tetromino.collision());
+			    return target.getColumnTop(4);
+		    });
+	};
+}
+
+TEST_CASE("Grid::rotate", "[Grid][benchmark]")
+{
+	Grid field = makeStack(8);
+	Grid square({255, 255}, 0);
+	Grid wide({255, 200}, 0);
+	square.setAt({100, 100}, field);
+	wide.setAt({100, 100}, field);
+
+	BENCHMARK("10x24")
+	{
+		field.rotate(1);
+		return field.getSize();
+	};
+	BENCHMARK("255x255")
+	{
+		square.rotate(1);
+		return square.getSize();
+	};
+	BENCHMARK("255x200")
+	{
+		wide.rotate(1);
+		return wide.getSize();
+	};
+	BENCHMARK("255x200 transpose")
+	{
+		wide.transpose();
+		return wide.getSize();
+	};
+}
@@ -0,0 +1,101 @@
+#include "placement.hpp"
+
+#include "boards.hpp"
+#include "bot.hpp"
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "perfectclear.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "threadpool.hpp"
+#include "types.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <thread>
+
+using namespace raymino;
+
+TEST_CASE("PlacementSearch::search", "[PlacementSearch][benchmark]")
+{
+	const Settings settings;
+	const Simulation simulation{settings, 42, PieceColors{1, 2, 3, 4, 5, 6, 7}};
+	PlacementSearch search{settings};
+	const Grid empty{FIELD_SIZE, 0};
+	const Grid stack = makeStack(8);
+
+	BENCHMARK("all Tetrominos, empty")
+	{
+		size_t placements = 0;
+		for(const Tetromino& tetromino : simulation.baseTetrominos)
+		{
+			placements += search.search(empty, tetromino).size();
+		}
+		return placements;
+	};
+	BENCHMARK("all Tetrominos, stack")
+	{
+		size_t placements = 0;
+		for(const Tetromino& tetromino : simulation.baseTetrominos)
+		{
+			placements += search.search(stack, tetromino).size();
+		}
+		return placements;
+	};
+}
+
+TEST_CASE("Bot::plan", "[Bot][benchmark]")
+{
+	const Settings settings;
+	Simulation simulation{settings, 42, PieceColors{1, 2, 3, 4, 5, 6, 7}};
+	simulation.playfield = makeStack(8);
+	Bot single{settings, BotWeights{}, 1};
+	ThreadPool pool{std::thread::hardware_concurrency()};
+	Bot threaded{settings, BotWeights{}, 1, &pool};
+
+	BENCHMARK("lookahead 1")
+	{
+		return single.plan(simulation).score;
+	};
+	BENCHMARK("lookahead 1, thread pool")
+	{
+		return threaded.plan(simulation).score;
+	};
+
+	const BotRollouts rollouts{64, 6, 4};
+	Bot singleRollouts{settings, BotWeights{}, 1, nullptr, rollouts};
+	Bot threadedRollouts{settings, BotWeights{}, 1, &pool, rollouts};
+	BENCHMARK("lookahead 1, 64 rollouts")
+	{
+		return singleRollouts.plan(simulation).score;
+	};
+	BENCHMARK("lookahead 1, 64 rollouts, thread pool")
+	{
+		return threadedRollouts.plan(simulation).score;
+	};
+}
+
+TEST_CASE("PerfectClearSolver::solve", "[PerfectClearSolver][benchmark]")
+{
+	const Settings settings;
+	Simulation simulation{settings, 1, PieceColors{1, 2, 3, 4, 5, 6, 7}};
+	const Size size = simulation.playfield.getSize();
+	// 4 lines with 7 pieces, solvable for this seed
+	simulation.playfield.setAt({0, size.height - 2}, Grid{{10, 1}, {1, 1, 0, 0, 0, 0, 1, 1, 1, 1}});
+	simulation.playfield.setAt({0, size.height - 1}, Grid{{10, 1}, {1, 1, 1, 0, 0, 0, 0, 1, 1, 1}});
+	ThreadPool pool{std::thread::hardware_concurrency()};
+
+	// a new solver each time, so no dead ends are known from the last run
+	BENCHMARK("7 pieces")
+	{
+		PerfectClearSolver solver{settings};
+		return solver.solve(simulation, 7).size();
+	};
+	BENCHMARK("7 pieces, thread pool")
+	{
+		PerfectClearSolver solver{settings, &pool};
+		return solver.solve(simulation, 7).size();
+	};
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+namespace raymino
+{
+/**
+ * @return uint64_t number of heap allocations made by the calling thread so far
+ * @remarks only available with ENABLE_ALLOCATION_COUNTER, over-aligned allocations are not counted
+ */
+uint64_t allocationCount() noexcept;
+} // namespace raymino
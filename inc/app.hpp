@@ -2,6 +2,7 @@
 
 #include "savefile.hpp"
 #include "scenes.hpp"
+#include "settings.hpp"
 #include "types.hpp"
 
 #include <raylib.h>
@@ -14,6 +15,7 @@
 #include <initializer_list>
 #include <limits>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -25,36 +27,7 @@ namespace raymino
 class App
 {
 public:
-	struct alignas(int64_t) Settings
-	{
-		RotationSystem rotationSystem = RotationSystem::Super;
-		WallKicks wallKicks = WallKicks::Super;
-		LockDown lockDown = LockDown::Extended;
-		SoftDrop softDrop = SoftDrop::NonLocking;
-		InstantDrop instantDrop = InstantDrop::Hard;
-		TSpin tSpin = TSpin::ThreeCorner;
-		ShuffleType shuffleType = ShuffleType::SingleBag;
-		ScoringSystem scoringSystem = ScoringSystem::Guideline;
-		LevelGoal levelGoal = LevelGoal::Fixed;
-		bool holdPiece = true;
-		bool ghostPiece = true;
-		uint8_t fieldWidth = 10;
-		uint8_t fieldHeight = 20;
-		uint8_t previewCount = 6;
-		[[maybe_unused]] uint8_t _reserved_[2]{}; // NOLINT(*-avoid-c-arrays)
-
-		bool operator==(const Settings& rhs) const noexcept;
-		bool operator!=(const Settings& rhs) const noexcept;
-		bool operator>(const Settings& rhs) const noexcept;
-		bool operator<(const Settings& rhs) const noexcept;
-		[[nodiscard]] int compare(const Settings& rhs) const noexcept;
-
-		static constexpr int SCREEN_WIDTH = 600;
-		static constexpr int SCREEN_HEIGHT = 600;
-		static constexpr float LOCK_DELAY = 0.5f;
-		static constexpr float DELAYED_AUTO_SHIFT = 1.0f / 6.0f;
-		static constexpr float AUTO_REPEAT_RATE = 1.0f / 30.0f;
-	};
+	using Settings = raymino::Settings;
 	struct alignas(int64_t) KeyBinds
 	{
 		int16_t moveRight = KEY_RIGHT;
@@ -268,6 +241,10 @@ public:
 	uint32_t activeSettingsPreset;
 	HighScores highScores;
 	TextBuffer<20> seed;
+	/**
+	 * @brief replay file Scene::Replay plays back
+	 */
+	std::string replayPath;
 
 	/**
 	 * @brief return active KeyBinds preset
@@ -281,7 +258,12 @@ public:
 
 	static constexpr const char* SAVE_PATH = "save.raymino";
 	static constexpr const char* IDB_PATH = "raymino";
+	static constexpr const char* REPLAY_DIRECTORY = "replays";
 	static constexpr size_t MAX_PRESETS = std::numeric_limits<uint16_t>::max();
+	/**
+	 * @brief ticks run at most per frame, time beyond that is dropped so a stall does not snowball
+	 */
+	static constexpr int MAX_TICKS_PER_FRAME = Settings::TICK_RATE / 4;
 #if defined(PLATFORM_WEB)
 	static constexpr size_t MAX_SCORES = 1300;
 #else
@@ -308,8 +290,9 @@ public:
 	/**
 	 * @brief saves SaveFile to disc, compressing with sinfl
 	 * @param save SaveFile
+	 * @param path to store at
 	 */
-	static void storeFile(const SaveFile& save);
+	static void storeFile(const SaveFile& save, const char* path = SAVE_PATH);
 
 	[[nodiscard]] SaveFile serialize() const;
 	void deserialize(const SaveFile& save);
@@ -318,5 +301,11 @@ private:
 	raylib::Window window;
 	std::unique_ptr<IScene> currentScene;
 	std::unique_ptr<IScene> nextScene = nullptr;
+	float tickAccumulator = 0;
+#if defined(RAYMINO_ALLOCATION_COUNTER)
+	static constexpr uint32_t ALLOCATION_WARMUP_FRAMES = 60;
+	uint32_t sceneFrames = 0;
+	uint64_t frameAllocations = 0;
+#endif
 };
 } // namespace raymino
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "app.hpp"
+#include "bot.hpp"
+#include "game.hpp"
+#include "scenes.hpp"
+#include "simulation.hpp"
+#include "threadpool.hpp"
+
+#include <memory>
+
+namespace raymino
+{
+/**
+ * @brief game played by a Bot, the Menu switches to it after a while without input, any key returns to the Menu
+ */
+struct Attract : IScene
+{
+	explicit Attract(App& app);
+	void Update(App& app) override;
+	void FixedUpdate(App& app) override;
+	void Draw(App& app) override;
+	void PreDestruct(App& app) override;
+	[[nodiscard]] bool isAllocationFree() const noexcept override;
+
+	/**
+	 * @brief Menu idle seconds before it switches to Attract
+	 */
+	static constexpr float IDLE_SECONDS = 60;
+	static constexpr const char* HintText = "Press any key";
+
+	Simulation simulation;
+	GameView view;
+	/**
+	 * @brief nullptr where threads are not available, the bot searches on the main thread then
+	 */
+	std::unique_ptr<ThreadPool> pool;
+	Bot bot;
+};
+} // namespace raymino
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "input.hpp"
+#include "placement.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "threadpool.hpp"
+#include "transposition.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raymino
+{
+/**
+ * @brief weights of the board features a Bot scores placements with, higher scores are better
+ */
+struct BotWeights
+{
+	float aggregateHeight = -0.51f;
+	float holes = -0.36f;
+	float bumpiness = -0.18f;
+	/**
+	 * @brief depth of columns lower than both neighbours, beyond the first row
+	 */
+	float wellDepth = -0.1f;
+	/**
+	 * @brief cells in the hidden rows, the game is lost soon after
+	 */
+	float hiddenCells = -10.0f;
+	/**
+	 * @brief reward per placement by lines it cleared
+	 */
+	std::array<float, 5> lineClears{0.0f, 0.76f, 1.52f, 2.28f, 4.0f};
+};
+
+/**
+ * @brief Monte Carlo lookahead past the previews, the best candidates of the search are scored again by greedy
+ * rollouts over piece sequences sampled from the randomizer state, see AnyShuffledIndices::sample
+ */
+struct BotRollouts
+{
+	/**
+	 * @brief sampled sequences per candidate, 0 turns rollouts off
+	 */
+	size_t samples = 0;
+	/**
+	 * @brief pieces sampled past the previews
+	 */
+	size_t depth = 6;
+	/**
+	 * @brief best scored candidates of the search rolled out
+	 */
+	size_t candidates = 4;
+};
+
+/**
+ * @brief board features of a playfield after a placement
+ */
+struct BoardFeatures
+{
+	int aggregateHeight;
+	int holes;
+	int bumpiness;
+	int wellDepth;
+	int hiddenCells;
+};
+
+/**
+ * @param field playfield including the hidden rows
+ * @return BoardFeatures of field
+ * @pre field.hasRowBits()
+ */
+[[nodiscard]] BoardFeatures boardFeatures(const Grid& field) noexcept;
+
+/**
+ * @return weighted sum of features
+ */
+[[nodiscard]] float evaluate(const BoardFeatures& features, const BotWeights& weights) noexcept;
+
+/**
+ * @brief plays a Simulation by pressing the same buttons a player would
+ * @remarks every placement of the current piece & the hold piece is scored by the best placements of the preview
+ * pieces after it, the placements of the current piece are split between the workers of the pool
+ * the best score of each playfield & remaining previews is kept in a transposition table shared by the workers, so a
+ * playfield reached by placing pieces in another order, by another worker or in an earlier plan is searched once
+ * with BotRollouts the best candidates are chosen between by their mean rollout score instead, each rollout places
+ * the previews & sampled pieces after the candidate at their best placement by weights, without hold, the rollouts
+ * are split between the workers & seeded by the position, so the choice does not depend on the thread count either
+ */
+class Bot
+{
+public:
+	/**
+	 * @brief slots of the transposition table, 1 MiB
+	 */
+	static constexpr size_t TABLE_CAPACITY = size_t{1} << 16U;
+
+	struct Plan
+	{
+		bool useHold;
+		Offset target;
+		std::vector<PlacementMove> path;
+		float score;
+	};
+
+	/**
+	 * @param settings rules of the games to play
+	 * @param weights to score placements with
+	 * @param lookahead preview pieces searched after the current one, limited by Settings::previewCount
+	 * @param pool spreads the search over its workers, nullptr searches on the calling thread
+	 * @param rollouts lookahead past the previews
+	 * @warning pool may not be the one running the caller, waiting for the search would wait for the caller too
+	 */
+	Bot(const Settings& settings, const BotWeights& weights, size_t lookahead, ThreadPool* pool = nullptr,
+	    const BotRollouts& rollouts = {});
+
+	/**
+	 * @return best placement for the current piece of simulation, an empty path if nothing can be placed
+	 */
+	[[nodiscard]] Plan plan(const Simulation& simulation);
+
+	/**
+	 * @brief follow plan, planning again for each new piece or when gravity moved the piece off the path
+	 * @return input for the next step of simulation, every press is followed by a step without buttons
+	 */
+	InputSnapshot next(const Simulation& simulation);
+
+private:
+	/**
+	 * @brief a piece the search starts with, the current one or the one swapped in by hold
+	 */
+	struct Root
+	{
+		bool useHold;
+		const Tetromino* tetromino;
+		std::vector<size_t> previews;
+		/**
+		 * @brief index of the next pieces the previews start at, 1 if hold takes the first one
+		 */
+		size_t firstPreview;
+	};
+	struct Candidate
+	{
+		size_t rootIdx;
+		Placement placement;
+	};
+	/**
+	 * @brief buffers of one worker, a search & playfield for every lookahead depth, and a search & the playfields of
+	 * a greedy step for rollouts
+	 */
+	struct Context
+	{
+		std::vector<PlacementSearch> searches;
+		std::vector<Grid> fields;
+		PlacementSearch rolloutSearch;
+		std::array<Grid, 3> rolloutFields;
+	};
+
+	[[nodiscard]] float scoreCandidate(Context& context, const Grid& field, const Candidate& candidate);
+	/**
+	 * @return score of the best placements of the previews of root from depth on, cached in table
+	 */
+	[[nodiscard]] float bestScore(Context& context, const Root& root, size_t depth);
+	/**
+	 * @return index into candidates of the best mean rollout score among the best scored candidates
+	 */
+	[[nodiscard]] size_t rolloutBest(const Simulation& simulation);
+	/**
+	 * @return score of candidate followed by the greedy placements of sequence from the first preview of its root
+	 */
+	[[nodiscard]] float rollout(Context& context, const Grid& field, const Candidate& candidate,
+	    const IndexQueue& sequence);
+
+	const Simulation* simulation;
+	BotWeights weights;
+	size_t lookahead;
+	ThreadPool* pool;
+	BotRollouts rollouts;
+	std::array<Root, 2> roots;
+	std::array<PlacementSearch, 2> rootSearches;
+	std::vector<Candidate> candidates;
+	std::vector<float> scores;
+	/**
+	 * @brief indices into candidates that are rolled out, the sampled sequences & a score per candidate & sequence
+	 */
+	std::vector<size_t> rolledOut;
+	std::vector<IndexQueue> sequences;
+	std::vector<float> rolloutScores;
+	std::vector<Context> contexts;
+	TranspositionTable<float> table;
+
+	Plan current;
+	size_t nextMove;
+	uint32_t plannedPiece;
+	int expectedY;
+	bool isPlanned;
+	bool isHolding;
+	bool isReleasing;
+	bool acceptY;
+};
+} // namespace raymino
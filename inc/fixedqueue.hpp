@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+namespace raymino
+{
+/**
+ * @brief FIFO queue with inline storage for at most TCapacity elements
+ * @remarks elements are kept contiguous, pop_front only advances the head and push_back moves the remaining
+ * elements to the front once the end of the storage is reached, iterators are invalidated by push_back
+ */
+template<typename T, size_t TCapacity>
+class FixedQueue
+{
+public:
+	static_assert(TCapacity > 0);
+
+	[[nodiscard]] static constexpr size_t capacity() noexcept
+	{
+		return TCapacity;
+	}
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return tail - head;
+	}
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return tail == head;
+	}
+
+	/**
+	 * @throws std::length_error if full
+	 */
+	void push_back(const T& value)
+	{
+		if(tail == TCapacity)
+		{
+			if(head == 0)
+			{
+				throw std::length_error("FixedQueue capacity exceeded");
+			}
+			std::copy(begin(), end(), items.begin());
+			tail -= head;
+			head = 0;
+		}
+		items[tail] = value;
+		++tail;
+	}
+	/**
+	 * @pre !empty()
+	 */
+	void pop_front() noexcept
+	{
+		++head;
+	}
+	[[nodiscard]] const T& front() const noexcept
+	{
+		return items[head];
+	}
+	[[nodiscard]] const T& operator[](size_t idx) const noexcept
+	{
+		return items[head + idx];
+	}
+
+	[[nodiscard]] T* begin() noexcept
+	{
+		return items.data() + head;
+	}
+	[[nodiscard]] T* end() noexcept
+	{
+		return items.data() + tail;
+	}
+	[[nodiscard]] const T* begin() const noexcept
+	{
+		return items.data() + head;
+	}
+	[[nodiscard]] const T* end() const noexcept
+	{
+		return items.data() + tail;
+	}
+
+private:
+	std::array<T, TCapacity> items{};
+	size_t head = 0;
+	size_t tail = 0;
+};
+} // namespace raymino
@@ -1,32 +1,42 @@
 #pragma once
 
 #include "app.hpp"
-#include "gameplay.hpp"
-#include "grid.hpp"
+#include "graphics.hpp"
 #include "gui.hpp"
 #include "input.hpp"
+#include "replay.hpp"
 #include "scenes.hpp"
-#include "timer.hpp"
+#include "simulation.hpp"
 #include "types.hpp"
 
-#include <cstddef>
-#include <deque>
-#include <memory>
-#include <random>
 #include <vector>
 
 namespace raymino
 {
-struct Game : IScene
+/**
+ * @brief the colors GameView draws Grid::Cell values with
+ */
+extern const ColorMap minoColors;
+
+/**
+ * @return PieceColors as index into minoColors
+ */
+PieceColors makePieceColors();
+
+/**
+ * @return InputSnapshot of the gameplay keys for this frame
+ */
+InputSnapshot pollInput(const App::KeyBinds& keyBinds) noexcept;
+
+/**
+ * @brief playfield, previews, score & status of a single player game, drawn from whichever Simulation a scene shows
+ */
+struct GameView
 {
-	explicit Game(App& app);
-	void Update(App& app) override;
-	void Draw(App& app) override;
-	void PreDestruct(App& app) override;
+	explicit GameView(const Simulation& simulation);
+	void draw(const Simulation& simulation) const;
 
-	std::deque<size_t> fillIndices(size_t minIndices);
 	[[nodiscard]] int cellSizeExtended() const noexcept;
-	Tetromino getNextTetromino(size_t minIndices);
 
 	enum class State
 	{
@@ -35,32 +45,40 @@ struct Game : IScene
 		GameOver,
 	};
 
-	Grid playfield;
 	Rect playfieldBounds;
-	std::vector<Tetromino> baseTetrominos;
 	std::vector<XY> previewOffsetsMain;
-	size_t holdPieceIdx;
-	std::mt19937_64 rng;
-	std::unique_ptr<IShuffledIndices> shuffledIndicesFunc;
-	std::deque<size_t> nextTetrominoIndices;
 	int previewElementHeightExtended;
 	std::vector<XY> previewOffsetsExtended;
-	Tetromino currentTetromino;
-	std::unique_ptr<IScoringSystem> scoringSystem;
 	NumberBuffer score;
 	State state;
-	decltype(levelUp(LevelGoal{})) levelUpFunc;
-	LevelState levelState;
-	Timer lockDelay;
-	int lockCounter;
-	bool isLocking;
-	bool holdPieceLocked;
 	bool isHighScore;
-	decltype(tSpinCheck(TSpin{})) tSpinFunc;
-	Timer gravity;
-	KeyAction moveRight;
-	decltype(basicRotation(RotationSystem{})) basicRotationFunc;
-	decltype(wallKick(WallKicks{})) wallKickFunc;
-	KeyAction rotateRight;
+};
+
+struct Game : IScene
+{
+	explicit Game(App& app);
+	void Update(App& app) override;
+	void FixedUpdate(App& app) override;
+	void Draw(App& app) override;
+	void PreDestruct(App& app) override;
+	[[nodiscard]] bool isAllocationFree() const noexcept override;
+
+	/**
+	 * @brief write the session to its own file in App::REPLAY_DIRECTORY, once
+	 */
+	void storeReplay();
+
+	Replay replay;
+	Simulation simulation;
+	GameView view;
+	/**
+	 * @brief input polled since the last tick
+	 */
+	InputSnapshot pendingInput;
+	bool isReplayStored;
+	/**
+	 * @brief the replay grew its buffers this frame, done while paused or once its reserve runs out mid-game
+	 */
+	bool isReplayGrowing;
 };
 } // namespace raymino
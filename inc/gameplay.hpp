@@ -1,15 +1,19 @@
 #pragma once
 
+#include "fixedqueue.hpp"
 #include "grid.hpp"
+#include "smallgrid.hpp"
 #include "types.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
-#include <deque>
-#include <memory>
+#include <limits>
 #include <random>
 #include <tuple>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
 namespace raymino
@@ -49,21 +53,60 @@ struct Offset
 };
 struct Tetromino : public Offset
 {
+	/**
+	 * @param offset initial position & rotation
+	 * @param minoType TetrominoType
+	 * @param shape collision at rotation 0, other rotation states get precomputed
+	 */
+	Tetromino(Offset offset, TetrominoType minoType, const PieceGrid& shape) :
+	    Offset{offset}, type{minoType}, shapes{shape, rotated(shape, 1), rotated(shape, 2), rotated(shape, 3)}
+	{
+	}
+
 	TetrominoType type;
-	Grid collision;
+	/**
+	 * @brief collision for all 4 rotation states, indexed by rotation & 0b11
+	 */
+	std::array<PieceGrid, 4> shapes;
+
+	/**
+	 * @return collision for current rotation
+	 */
+	[[nodiscard]] const PieceGrid& collision() const noexcept
+	{
+		return collision(rotation);
+	}
+	/**
+	 * @param rotationState any rotation, wraps around
+	 * @return collision for rotationState
+	 */
+	[[nodiscard]] const PieceGrid& collision(int rotationState) const noexcept
+	{
+		return shapes[static_cast<size_t>(rotationState) & size_t{0b11}];
+	}
+
+	/**
+	 * @brief only moves the rotation state index, shapes stay untouched
+	 */
 	Tetromino& operator+=(Offset other) noexcept
 	{
 		Offset::operator+=(other);
-		collision.rotate(other.rotation);
 		return *this;
 	}
 	Tetromino& operator-=(Offset other) noexcept
 	{
 		Offset::operator-=(other);
-		collision.rotate(-other.rotation);
 		return *this;
 	}
+
+private:
+	static PieceGrid rotated(PieceGrid shape, int steps) noexcept
+	{
+		shape.rotate(steps);
+		return shape;
+	}
 };
+static_assert(std::is_trivially_copyable_v<Tetromino>);
 
 /**
  * @tparam TSys RotationSystem that the Tetrominos will be used with
@@ -129,6 +172,7 @@ Offset (*wallKick(WallKicks tsys) noexcept)(const Grid& field, const Tetromino&
  * @return Rect with offset inside grid & true size
  */
 Rect findTrueSize(const Grid& grid) noexcept;
+Rect findTrueSize(const PieceGrid& grid) noexcept;
 
 /**
  * @brief centered absolut position to place Tetromino (rounded left)
@@ -202,11 +246,48 @@ ScoreEvent tSpinCheck(const Grid& field, const Tetromino& tetromino, Offset last
 ScoreEvent (*tSpinCheck(TSpin tspin) noexcept)(const Grid& field, const Tetromino& tetromino, Offset offset) noexcept;
 
 /**
- * @brief potentially stateful ScoringSystem
+ * @param event ScoreEvent of a locked piece
+ * @param lines cleared by it
+ * @return rows of garbage the clear sends to a versus opponent
  */
-struct IScoringSystem
+uint32_t attackLines(ScoreEvent event, uint32_t lines) noexcept;
+
+namespace scoring
+{
+struct BPS
+{
+	[[nodiscard]] int64_t process(ScoreEvent event, uint32_t lines, uint32_t level) const noexcept;
+};
+struct Sega
+{
+	[[nodiscard]] int64_t process(ScoreEvent event, uint32_t lines, uint32_t level) const noexcept;
+};
+struct Nintendo
 {
-	virtual ~IScoringSystem() = default;
+	[[nodiscard]] int64_t process(ScoreEvent event, uint32_t lines, uint32_t level) const noexcept;
+};
+struct Guideline
+{
+	[[nodiscard]] int64_t process(ScoreEvent event, uint32_t lines, uint32_t level) noexcept;
+
+	bool wasLastEventDifficult = false;
+	uint32_t lastPerfectClearLines = 0;
+	int clearCounter = 0;
+	int combo = -1;
+};
+} // namespace scoring
+
+/**
+ * @brief potentially stateful ScoringSystem, one of a closed set stored inline so copies include the state
+ */
+class AnyScoringSystem
+{
+public:
+	using Variant = std::variant<scoring::Guideline, scoring::BPS, scoring::Sega, scoring::Nintendo>;
+
+	explicit AnyScoringSystem(Variant scoringSystem) noexcept : system{scoringSystem}
+	{
+	}
 
 	/**
 	 * @param event ScoreEvent to process
@@ -214,51 +295,186 @@ struct IScoringSystem
 	 * @param level
 	 * @return int64_t score for event
 	 */
-	[[nodiscard]] virtual int64_t process(ScoreEvent event, uint32_t lines, uint32_t level) noexcept = 0;
+	[[nodiscard]] int64_t process(ScoreEvent event, uint32_t lines, uint32_t level) noexcept
+	{
+		return std::visit(
+		    [&](auto& scoring)
+		    {
+			    return scoring.process(event, lines, level);
+		    },
+		    system);
+	}
+
+private:
+	Variant system;
 };
 
 /**
  * @tparam TSys ScoringSystem to use
- * @return std::unique_ptr<IScoringSystem> of TSys ScoringSystem
+ * @return AnyScoringSystem holding TSys ScoringSystem
  */
 template<ScoringSystem TSys>
-std::unique_ptr<IScoringSystem> makeScoringSystem();
+AnyScoringSystem makeScoringSystem();
 
 /**
  * @param tsys ScoringSystem
  * @return makeScoringSystem function pointer
  */
-std::unique_ptr<IScoringSystem> (*makeScoringSystem(ScoringSystem tsys))();
+AnyScoringSystem (*makeScoringSystem(ScoringSystem tsys))();
+
+/**
+ * @brief upcoming indices into the base Tetrominos, fixed size so refilling never allocates
+ */
+using IndexQueue = FixedQueue<size_t, 64>;
 
+namespace shuffling
+{
 /**
- * @brief potentially stateful shuffledIndices
+ * @brief most base Tetrominos a shuffler supports, sizes the inline state
  */
-struct IShuffledIndices
+constexpr size_t MAX_INDICES = 7;
+
+struct Random
+{
+	void fill(IndexQueue& indices, size_t minIndices, std::mt19937_64& rng) const;
+
+	size_t indexCount;
+};
+struct MultiBag
+{
+	void fill(IndexQueue& indices, size_t minIndices, std::mt19937_64& rng) const;
+
+	size_t bagSize;
+	size_t indexCount;
+};
+struct TGMH4
+{
+	static constexpr size_t FILL = std::numeric_limits<size_t>::max();
+
+	explicit TGMH4(const std::vector<Tetromino>& baseTetrominos);
+	TGMH4(const std::vector<Tetromino>& baseTetrominos, size_t rollMax);
+
+	/**
+	 * @brief shuffle the initial history once, with the game rng so the sequence only depends on its seed
+	 */
+	void shuffleHistory(std::mt19937_64& rng);
+	void pushHistory(size_t value) noexcept;
+	[[nodiscard]] bool isInHistory(size_t idx) const noexcept;
+	[[nodiscard]] size_t roll(std::mt19937_64& rng) const;
+	void fill(IndexQueue& indices, size_t minIndices, std::mt19937_64& rng);
+
+	std::array<size_t, 4> history{FILL, FILL, FILL, FILL};
+	size_t rollMax;
+	uint8_t historyIdx : 2;
+	bool isHistoryShuffled = false;
+};
+struct TGM35 : TGMH4
 {
-	virtual ~IShuffledIndices() = default;
+	static constexpr size_t BAG_COPIES = 5;
+
+	/**
+	 * @throws std::length_error if there are more than MAX_INDICES baseTetrominos
+	 */
+	explicit TGM35(const std::vector<Tetromino>& baseTetrominos);
+
+	void updateBag(size_t bagIdx) noexcept;
+	/**
+	 * @return the piece drawn least often that is not in the history
+	 */
+	[[nodiscard]] size_t starvedOutsideHistory() const noexcept;
+	void fill(IndexQueue& indices, size_t minIndices, std::mt19937_64& rng);
+
+	size_t indexCount;
+	std::array<uint32_t, MAX_INDICES> lru{};
+	std::array<uint8_t, MAX_INDICES * BAG_COPIES> bag{};
+};
+struct NES
+{
+	void fill(IndexQueue& indices, size_t minIndices, std::mt19937_64& rng);
+
+	size_t indexCount;
+	size_t previous = std::numeric_limits<size_t>::max();
+};
+} // namespace shuffling
+
+/**
+ * @brief potentially stateful shuffledIndices, one of a closed set stored inline so copies include the state
+ */
+class AnyShuffledIndices
+{
+public:
+	using Variant = std::variant<shuffling::Random, shuffling::MultiBag, shuffling::TGMH4, shuffling::TGM35,
+	    shuffling::NES>;
+
+	explicit AnyShuffledIndices(Variant shuffled) noexcept : shuffler{shuffled}
+	{
+	}
 
 	/**
 	 * @brief add random indices to indices
 	 * @param indices index list
 	 * @param minIndices in indices
 	 * @param rng random engine
+	 * @throws std::length_error if minIndices don't fit into indices
+	 */
+	void fill(IndexQueue& indices, size_t minIndices, std::mt19937_64& rng)
+	{
+		std::visit(
+		    [&](auto& shuffled)
+		    {
+			    shuffled.fill(indices, minIndices, rng);
+		    },
+		    shuffler);
+	}
+
+	/**
+	 * @brief a plausible continuation of indices, drawn from a copy of the state without changing it
+	 * @param indices queue filled by this, the first visible ones are known to the player
+	 * @param visible indices kept as they are
+	 * @param minIndices in the result
+	 * @param rng random engine of the sample, not the one of the game, so the real future does not leak
+	 * @return indices with the unseen ones replaced & more added
+	 * @remarks MultiBag queues the rest of the current bag behind the visible indices, the pieces left in it are known
+	 * by counting but their order is not, so it is shuffled again, the other shufflers draw nothing beyond minIndices
+	 * & continue from their history, drought counts or previous roll
+	 * @throws std::length_error if minIndices don't fit into indices
 	 */
-	virtual void fill(std::deque<size_t>& indices, size_t minIndices, std::mt19937_64& rng) = 0;
+	[[nodiscard]] IndexQueue sample(const IndexQueue& indices, size_t visible, size_t minIndices,
+	    std::mt19937_64& rng) const
+	{
+		IndexQueue sampled = indices;
+		Variant future = shuffler;
+		std::visit(
+		    [&](auto& shuffled)
+		    {
+			    if constexpr(std::is_same_v<std::decay_t<decltype(shuffled)>, shuffling::MultiBag>)
+			    {
+				    std::shuffle(std::next(sampled.begin(), static_cast<ptrdiff_t>(std::min(visible, sampled.size()))),
+				        sampled.end(), rng);
+			    }
+			    shuffled.fill(sampled, minIndices, rng);
+		    },
+		    future);
+		return sampled;
+	}
+
+private:
+	Variant shuffler;
 };
 
 /**
  * @tparam TType ShuffleType
  * @param baseMinos to shuffle from
- * @return std::unique_ptr<IShuffledIndices> of TType ShuffleType
+ * @return AnyShuffledIndices holding TType ShuffleType
  */
 template<ShuffleType TType>
-std::unique_ptr<IShuffledIndices> makeShuffledIndices(const std::vector<Tetromino>& baseMinos);
+AnyShuffledIndices makeShuffledIndices(const std::vector<Tetromino>& baseMinos);
 
 /**
  * @param ttype ShuffleType
  * @return makeShuffledIndices function pointer
  */
-std::unique_ptr<IShuffledIndices> (*makeShuffledIndices(ShuffleType ttype))(const std::vector<Tetromino>& baseMinos);
+AnyShuffledIndices (*makeShuffledIndices(ShuffleType ttype))(const std::vector<Tetromino>& baseMinos);
 
 struct LevelState
 {
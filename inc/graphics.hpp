@@ -1,6 +1,7 @@
 #pragma once
 
 #include "grid.hpp"
+#include "smallgrid.hpp"
 #include "types.hpp"
 
 #include <raylib.h>
@@ -36,6 +37,8 @@ private:
  */
 void drawCells(
     const Grid& grid, XY at, int cellSize, int borderSize, const ColorMap& minoColors, uint8_t alpha = 255) noexcept;
+void drawCells(const PieceGrid& grid, XY at, int cellSize, int borderSize, const ColorMap& minoColors,
+    uint8_t alpha = 255) noexcept;
 
 /**
  * @param grid to draw background of
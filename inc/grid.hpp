@@ -1,27 +1,47 @@
 #pragma once
 
+#include "smallgrid.hpp"
 #include "types.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdlib>
 #include <cstdint>
-#include <functional>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
 namespace raymino
 {
+template<int TMaxWidth, int TMaxHeight>
+struct GridSnapshot;
+
 class Grid
 {
 public:
 	using Cell = uint8_t;
-	using TTransformFunc = Cell(Cell);
+	using RowBits = uint64_t;
 	static constexpr Cell oobVal = 0xFF;
+	static constexpr int rowBitsWidth = std::numeric_limits<RowBits>::digits;
+	static_assert(std::is_same_v<Cell, PieceGrid::Cell> && std::is_same_v<RowBits, PieceGrid::RowBits>);
 	Grid() = delete;
 	Grid(Size size, Cell fill);
 	/**
 	 * @throws std::logic_error on size mismatch
 	 */
 	Grid(Size size, const std::vector<Cell>& grid);
-	Grid(const Grid& other, std::function<TTransformFunc> func);
+	/**
+	 * @param other Grid to copy
+	 * @param func callable Cell(Cell) applied to every cell of other
+	 */
+	template<typename TFunc>
+	Grid(const Grid& other, TFunc func) :
+	    cells(other.cells.size()), size{std::abs(other.size.width), std::abs(other.size.height)}
+	{
+		transformRange(other.cells.data(), cells.data(), cells.size(), func);
+		updateCaches();
+	}
 
 	/**
 	 * @param topLeft XY offset for other inside this
@@ -29,6 +49,7 @@ public:
 	 * @return size_t 1 based index into other where overlap occurred
 	 */
 	[[nodiscard]] size_t overlapAt(XY topLeft, const Grid& other) const noexcept;
+	[[nodiscard]] size_t overlapAt(XY topLeft, const PieceGrid& other) const noexcept;
 
 	[[nodiscard]] bool isSquare() const noexcept
 	{
@@ -47,19 +68,135 @@ public:
 	 */
 	[[nodiscard]] Cell getAt(XY topLeft, Cell oobValue = oobVal) const noexcept;
 
-	void transformCells(std::function<TTransformFunc> func) noexcept;
-	void rotate(int steps) noexcept;
-	void transpose() noexcept;
-	void reverseRows() noexcept;
-	void setAt(XY topLeft, const Grid& other) noexcept;
-	[[nodiscard]] auto begin() noexcept
+	/**
+	 * @return true if occupancy is tracked per row (width <= rowBitsWidth)
+	 */
+	[[nodiscard]] bool hasRowBits() const noexcept
 	{
-		return cells.begin();
+		return size.width <= rowBitsWidth;
 	}
-	[[nodiscard]] auto end() noexcept
+
+	/**
+	 * @param yPos row
+	 * @return RowBits bit x set if cell x != 0, 0 for rows outside grid
+	 * @pre hasRowBits()
+	 */
+	[[nodiscard]] RowBits getRowBits(int yPos) const noexcept
 	{
-		return cells.end();
+		return yPos < 0 || yPos >= size.height ? 0 : rowBits[static_cast<size_t>(yPos)];
+	}
+
+	/**
+	 * @return Zobrist hash of the occupied cells, equal for grids of equal occupancy regardless of colors & how they
+	 * got there, 0 without row bits
+	 * @remarks kept up to date by every change, setAt & eraseFullRows only rehash the rows they change
+	 */
+	[[nodiscard]] uint64_t getHash() const noexcept
+	{
+		return hash;
+	}
+
+	/**
+	 * @param xPos column
+	 * @return int row of the highest occupied cell, height if the column is empty, 0 outside grid
+	 */
+	[[nodiscard]] int getColumnTop(int xPos) const noexcept
+	{
+		return xPos < 0 || xPos >= size.width ? 0 : columnTops[static_cast<size_t>(xPos)];
+	}
+
+	/**
+	 * @param topLeft XY offset for other inside this
+	 * @param other Grid to drop
+	 * @return int rows other can move down before overlapping
+	 * @pre overlapAt(topLeft, other) == 0
+	 */
+	[[nodiscard]] int dropDistance(XY topLeft, const Grid& other) const noexcept;
+	[[nodiscard]] int dropDistance(XY topLeft, const PieceGrid& other) const noexcept;
+
+	/**
+	 * @return RowBits of a row with all cells set
+	 */
+	[[nodiscard]] RowBits fullRowBits() const noexcept;
+
+	/**
+	 * @param topLeft XY offset for other inside this
+	 * @param other Grid to place
+	 * @param yPos row of this
+	 * @return RowBits of other landing in row yPos, clipped to this
+	 * @pre hasRowBits() && other.hasRowBits()
+	 */
+	[[nodiscard]] RowBits placedRowBits(XY topLeft, const Grid& other, int yPos) const noexcept;
+	[[nodiscard]] RowBits placedRowBits(XY topLeft, const PieceGrid& other, int yPos) const noexcept;
+
+	/**
+	 * @param func callable Cell(Cell) applied to every cell
+	 */
+	template<typename TFunc>
+	void transformCells(TFunc func) noexcept
+	{
+		transformRange(cells.data(), cells.data(), cells.size(), func);
+		updateCaches();
 	}
+	/**
+	 * @param func callable Cell(Cell) applied to every cell != 0, cells == 0 are kept
+	 */
+	template<typename TFunc>
+	void transformOccupied(TFunc func) noexcept
+	{
+		transformRange(cells.data(), cells.data(), cells.size(),
+		    [&func](Cell cell)
+		    {
+			    return cell != 0 ? static_cast<Cell>(func(cell)) : cell;
+		    });
+		updateCaches();
+	}
+	/**
+	 * @param value for every cell
+	 */
+	void fill(Cell value) noexcept;
+	/**
+	 * @brief sets every cell != 0 to color, occupancy is unchanged for color != 0
+	 * @param color new Cell value
+	 */
+	void recolor(Cell color) noexcept;
+	void rotate(int steps) noexcept;
+	void transpose() noexcept;
+	void reverseRows() noexcept;
+	void setAt(XY topLeft, const Grid& other) noexcept;
+	void setAt(XY topLeft, const PieceGrid& other) noexcept;
+
+	/**
+	 * @brief removes all full rows, moving the rows above down
+	 * @return uint32_t number of rows removed
+	 */
+	uint32_t eraseFullRows() noexcept;
+
+	/**
+	 * @brief moves all rows up, the lowest rows are filled with fill except for one gap
+	 * @param rows to insert, clamped to height
+	 * @param fill Cell value of the inserted rows
+	 * @param gapColumn left empty in every inserted row
+	 * @return true if occupied cells were pushed out of the top
+	 */
+	bool pushUp(int rows, Cell fill, int gapColumn) noexcept;
+
+	/**
+	 * @return true if all cells 0
+	 */
+	[[nodiscard]] bool isEmpty() const noexcept;
+
+	/**
+	 * @param yPos row
+	 * @return true if no cell in row is 0, false for rows outside grid
+	 */
+	[[nodiscard]] bool isRowFull(int yPos) const noexcept;
+
+	/**
+	 * @return true if size has compile-time specialized kernels (standard 10x20 playfield + hidden rows)
+	 */
+	[[nodiscard]] bool hasFixedKernels() const noexcept;
+
 	[[nodiscard]] auto begin() const noexcept
 	{
 		return cells.begin();
@@ -76,21 +213,106 @@ public:
 	{
 		return cells.rend();
 	}
-	[[nodiscard]] auto rbegin() noexcept
+	[[nodiscard]] bool operator==(const Grid& other) const noexcept
 	{
-		return cells.rbegin();
+		return size == other.size && cells == other.cells;
 	}
-	[[nodiscard]] auto rend() noexcept
+
+	/**
+	 * @brief copy cells & caches into snapshot
+	 * @pre size fits into TMaxWidth x TMaxHeight
+	 */
+	template<int TMaxWidth, int TMaxHeight>
+	void save(GridSnapshot<TMaxWidth, TMaxHeight>& snapshot) const noexcept
 	{
-		return cells.rend();
+		std::copy(cells.begin(), cells.end(), snapshot.cells.begin());
+		std::copy(rowBits.begin(), rowBits.end(), snapshot.rowBits.begin());
+		std::copy(columnTops.begin(), columnTops.end(), snapshot.columnTops.begin());
+		snapshot.hash = hash;
 	}
-	[[nodiscard]] bool operator==(const Grid& other) noexcept
+	/**
+	 * @brief copy cells & caches back from snapshot, nothing is recomputed
+	 * @pre snapshot was saved from a Grid of the same size
+	 */
+	template<int TMaxWidth, int TMaxHeight>
+	void restore(const GridSnapshot<TMaxWidth, TMaxHeight>& snapshot) noexcept
 	{
-		return size == other.size && cells == other.cells;
+		std::copy_n(snapshot.cells.begin(), cells.size(), cells.begin());
+		std::copy_n(snapshot.rowBits.begin(), rowBits.size(), rowBits.begin());
+		std::copy_n(snapshot.columnTops.begin(), columnTops.size(), columnTops.begin());
+		hash = snapshot.hash;
 	}
 
 private:
+	/**
+	 * @brief hot operations, specialized for fixed dimensions & selected on size change
+	 */
+	struct Kernels
+	{
+		size_t (Grid::*overlapAtPiece)(XY topLeft, const PieceGrid& other) const noexcept;
+		uint32_t (Grid::*eraseFullRows)() noexcept;
+		bool (Grid::*isEmpty)() const noexcept;
+		bool isFixed;
+	};
+	template<typename TDims>
+	static const Kernels* kernelsFor() noexcept;
+	static const Kernels* selectKernels(Size gridSize) noexcept;
+
+	/**
+	 * @remarks plain indexed loop over raw pointers so simple callables get inlined & vectorized
+	 */
+	template<typename TFunc>
+	static void transformRange(const Cell* source, Cell* target, size_t count, TFunc func) noexcept
+	{
+		for(size_t idx = 0; idx < count; ++idx)
+		{
+			target[idx] = static_cast<Cell>(func(source[idx]));
+		}
+	}
+	/**
+	 * @brief moves every cell (x, y) to targetIndex(x, y) & swaps width and height
+	 */
+	template<typename TIndexFunc>
+	void remapCells(TIndexFunc targetIndex) noexcept;
+	void updateCaches() noexcept;
+	void updateRowBits() noexcept;
+	void updateColumnTops(int fromRow) noexcept;
+	/**
+	 * @return XOR of the Zobrist keys of rows [first, last)
+	 * @pre hasRowBits()
+	 */
+	[[nodiscard]] uint64_t rowsHash(int first, int last) const noexcept;
+	template<typename TDims, typename TOther>
+	[[nodiscard]] size_t overlapAtImpl(XY topLeft, const TOther& other) const noexcept;
+	template<typename TDims>
+	uint32_t eraseFullRowsImpl() noexcept;
+	template<typename TDims>
+	[[nodiscard]] bool isEmptyImpl() const noexcept;
+	template<typename TOther>
+	void setAtImpl(XY topLeft, const TOther& other) noexcept;
+	template<typename TOther>
+	[[nodiscard]] int dropDistanceImpl(XY topLeft, const TOther& other) const noexcept;
+
 	std::vector<Cell> cells;
+	std::vector<RowBits> rowBits;
+	std::vector<int> columnTops;
+	uint64_t hash = 0;
 	Size size;
+	const Kernels* kernels = nullptr;
+};
+
+/**
+ * @brief inline copy of a Grid with at most TMaxWidth x TMaxHeight cells, trivially copyable
+ * @remarks only the first width * height cells are used, see Grid::save & Grid::restore
+ */
+template<int TMaxWidth, int TMaxHeight>
+struct GridSnapshot
+{
+	static_assert(TMaxWidth > 0 && TMaxHeight > 0);
+
+	std::array<Grid::Cell, static_cast<size_t>(TMaxWidth) * static_cast<size_t>(TMaxHeight)> cells{};
+	std::array<Grid::RowBits, static_cast<size_t>(TMaxHeight)> rowBits{};
+	std::array<int, static_cast<size_t>(TMaxWidth)> columnTops{};
+	uint64_t hash = 0;
 };
 } // namespace raymino
@@ -6,6 +6,87 @@
 
 namespace raymino
 {
+/**
+ * @brief state of the gameplay buttons for a single step, independent of the input device
+ */
+struct InputSnapshot
+{
+	enum Button : uint8_t
+	{
+		MoveRight = 1U << 0U,
+		MoveLeft = 1U << 1U,
+		RotateRight = 1U << 2U,
+		RotateLeft = 1U << 3U,
+		SoftDrop = 1U << 4U,
+		HardDrop = 1U << 5U,
+		Hold = 1U << 6U,
+	};
+
+	/**
+	 * @brief set state of button
+	 * @param button to set
+	 * @param isDown held during this step
+	 * @param isPressed went down since the last step
+	 * @param isReleased went up since the last step
+	 */
+	void set(Button button, bool isDown, bool isPressed, bool isReleased) noexcept
+	{
+		down = isDown ? static_cast<uint8_t>(down | button) : down;
+		pressed = isPressed ? static_cast<uint8_t>(pressed | button) : pressed;
+		released = isReleased ? static_cast<uint8_t>(released | button) : released;
+	}
+	/**
+	 * @brief snapshot of button going down this step, no other button held
+	 */
+	[[nodiscard]] static InputSnapshot tap(Button button) noexcept
+	{
+		InputSnapshot input;
+		input.set(button, true, true, false);
+		return input;
+	}
+	/**
+	 * @brief take the down state of a later snapshot, keep the edges not consumed by a step yet
+	 */
+	void merge(const InputSnapshot& later) noexcept
+	{
+		down = later.down;
+		pressed = static_cast<uint8_t>(pressed | later.pressed);
+		released = static_cast<uint8_t>(released | later.released);
+	}
+	/**
+	 * @brief clear pressed & released once a step saw them
+	 */
+	void consumeEdges() noexcept
+	{
+		pressed = 0;
+		released = 0;
+	}
+	[[nodiscard]] bool isDown(Button button) const noexcept
+	{
+		return (down & button) != 0;
+	}
+	[[nodiscard]] bool isPressed(Button button) const noexcept
+	{
+		return (pressed & button) != 0;
+	}
+	[[nodiscard]] bool isReleased(Button button) const noexcept
+	{
+		return (released & button) != 0;
+	}
+	[[nodiscard]] bool operator==(const InputSnapshot& other) const noexcept
+	{
+		return down == other.down && pressed == other.pressed && released == other.released;
+	}
+	[[nodiscard]] bool operator!=(const InputSnapshot& other) const noexcept
+	{
+		return !operator==(other);
+	}
+
+	uint8_t down = 0;
+	uint8_t pressed = 0;
+	uint8_t released = 0;
+};
+
 struct KeyAction
 {
 	enum class State : uint8_t
@@ -22,21 +103,23 @@ struct KeyAction
 	};
 
 	KeyAction() = delete;
-	KeyAction(float repeatDelay, float repeatRate, int16_t rkey, int16_t lkey = 0) noexcept :
-	    repeatDelay{repeatDelay}, delayTimer{repeatRate}, rkey{rkey}, lkey{lkey}
+	KeyAction(
+	    float repeatDelay, float repeatRate, InputSnapshot::Button rbutton, InputSnapshot::Button lbutton) noexcept :
+	    repeatDelay{repeatDelay}, delayTimer{repeatRate}, rbutton{rbutton}, lbutton{lbutton}
 	{
 	}
 
 	/**
-	 * @brief check key state
+	 * @brief check button state, repeats while held after repeatDelay
 	 * @param delta seconds
+	 * @param input button state for this step
 	 * @return key state & value
 	 */
-	Return tick(float delta) noexcept;
+	Return tick(float delta, const InputSnapshot& input) noexcept;
 
 	float repeatDelay;
 	Timer delayTimer;
-	int16_t rkey;
-	int16_t lkey;
+	InputSnapshot::Button rbutton;
+	InputSnapshot::Button lbutton;
 };
 } // namespace raymino
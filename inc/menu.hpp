@@ -67,6 +67,10 @@ struct Menu : public IScene
 		KeyBinds,
 	};
 	State state = State::Settings;
+	/**
+	 * @brief seconds without keyboard or mouse input, switches to Scene::Attract after Attract::IDLE_SECONDS
+	 */
+	float idleSeconds = 0;
 
 	static constexpr const char* GroupBoxGameText = "Game";
 	static constexpr const char* ButtonStartGameText = "Start Game";
@@ -161,10 +165,10 @@ struct Menu : public IScene
 	static constexpr int SpinnerPreviewCountMax = 10;
 	static constexpr int SpinnerFieldWidthMin = 5;
 	int SpinnerFieldWidthValue = SpinnerFieldWidthMin;
-	static constexpr int SpinnerFieldWidthMax = 22;
+	static constexpr int SpinnerFieldWidthMax = App::Settings::MAX_FIELD_WIDTH;
 	static constexpr int SpinnerFieldHeightMin = 10;
 	int SpinnerFieldHeightValue = SpinnerFieldHeightMin;
-	static constexpr int SpinnerFieldHeightMax = 45;
+	static constexpr int SpinnerFieldHeightMax = App::Settings::MAX_FIELD_HEIGHT;
 
 	App::HighScoreEntry::NameT TextBoxPlayerNameBuffer;
 	using KeyBufferT = TextBuffer<20>;
@@ -3,6 +3,7 @@
 #include "cstring_view.hpp"
 #include "gameplay.hpp"
 #include "grid.hpp"
+#include "smallgrid.hpp"
 #include "types.hpp"
 
 #include <ostream>
@@ -14,6 +15,7 @@ std::ostream& operator<<(std::ostream& ostream, const Size& value);
 std::ostream& operator<<(std::ostream& ostream, const Rect& value);
 std::ostream& operator<<(std::ostream& ostream, const Offset& value);
 std::ostream& operator<<(std::ostream& ostream, const Grid& value);
+std::ostream& operator<<(std::ostream& ostream, const PieceGrid& value);
 std::ostream& operator<<(std::ostream& ostream, const TSpinCornerCountResult& value);
 std::ostream& operator<<(std::ostream& ostream, const LevelState& value);
 std::ostream& operator<<(std::ostream& ostream, const CStringView& value);
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "grid.hpp"
+#include "placement.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "threadpool.hpp"
+#include "transposition.hpp"
+#include "types.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raymino
+{
+/**
+ * @brief one piece of a perfect clear, placed in order
+ */
+struct PerfectClearStep
+{
+	/**
+	 * @brief press hold before following path
+	 */
+	bool useHold;
+	/**
+	 * @brief index into Simulation::baseTetrominos of the placed piece
+	 */
+	size_t pieceIdx;
+	Offset target;
+	/**
+	 * @brief moves from where the piece starts, see Bot::Plan::path
+	 * @remarks searched from just above the rows to clear, the moves have the same effect anywhere above them
+	 */
+	std::vector<PlacementMove> path;
+};
+
+/**
+ * @brief finds a sequence of placements of the known pieces that leaves the playfield empty
+ * @remarks depth first over the current piece, hold & the visible previews, for each number of lines to clear from
+ * the lowest one, the placements of the first piece are split between the workers of the pool
+ * branches are pruned with bitboards before searching placements: the cells left to fill must be a multiple of 4 &
+ * fit into the pieces left, columns filled in every remaining row split the rows into parts that are each a multiple of
+ * 4, and the difference between empty cells in even & odd columns, which line clears keep, must be within what the
+ * remaining L, J, T & I pieces can change it by
+ * dead ends are kept in a transposition table shared by the workers & later solves
+ */
+class PerfectClearSolver
+{
+public:
+	/**
+	 * @brief slots of the dead end table, 2 MiB
+	 */
+	static constexpr size_t TABLE_CAPACITY = size_t{1} << 17U;
+
+	/**
+	 * @param settings rules of the games to solve
+	 * @param pool spreads the search over its workers, nullptr searches on the calling thread
+	 * @warning pool may not be the one running the caller, see Bot
+	 */
+	explicit PerfectClearSolver(const Settings& settings, ThreadPool* pool = nullptr);
+
+	/**
+	 * @param simulation game to solve from its current piece on
+	 * @param maxPieces most pieces to place
+	 * @return placements clearing the fewest lines, then the first found in order of the first piece's placements,
+	 * empty if there is no perfect clear with the known pieces
+	 * @remarks equal for any number of workers
+	 */
+	[[nodiscard]] std::vector<PerfectClearStep> solve(const Simulation& simulation, size_t maxPieces);
+
+private:
+	/**
+	 * @brief the pieces a node can still place, the next one of sequence at position & the held one
+	 */
+	struct Node
+	{
+		size_t position;
+		size_t holdIdx;
+		int linesLeft;
+	};
+	/**
+	 * @brief a placement of the next piece & the node it leads to, those of the first piece are the worker tasks
+	 */
+	struct Child
+	{
+		bool useHold;
+		size_t pieceIdx;
+		Placement placement;
+		Node node;
+	};
+	/**
+	 * @brief buffers of one worker, per depth a search for the next & the held piece, a playfield & the children,
+	 * and the placements leading to the current node
+	 */
+	struct Context
+	{
+		std::vector<PlacementSearch> searches;
+		std::vector<Grid> fields;
+		std::vector<std::vector<Child>> children;
+		std::vector<Child> chosen;
+	};
+
+	/**
+	 * @param field with every cell in the lowest node.linesLeft rows
+	 * @param piecesLeft to fill them with
+	 * @return false if the bitboard checks prove that the rows can not be cleared
+	 */
+	[[nodiscard]] bool isFeasible(const Grid& field, const Node& node, size_t piecesLeft) const noexcept;
+	/**
+	 * @brief place child onto field & clear lines, child.node.linesLeft is reduced by the lines cleared
+	 * @return false if the result is not feasible
+	 */
+	[[nodiscard]] bool applyChild(Grid& field, Child& child, size_t piecesLeft) const noexcept;
+	/**
+	 * @brief fill children with the placements within the rows to clear of the next piece, followed by those of the
+	 * one hold swaps in
+	 * @param start the next piece at its starting offset
+	 */
+	void listChildren(PlacementSearch& next, PlacementSearch& held, const Grid& field, const Node& node,
+	    bool isHoldLocked, const Tetromino& start, std::vector<Child>& children) const;
+	/**
+	 * @param childIdx of the root child the search is below, it stops once an earlier one is solved
+	 * @return true if a perfect clear was found, context.chosen holds its placements
+	 */
+	[[nodiscard]] bool search(Context& context, size_t depth, const Node& node, size_t childIdx);
+	[[nodiscard]] std::vector<PerfectClearStep> steps(const Context& context) const;
+	[[nodiscard]] uint64_t deadKey(const Grid& field, const Node& node) const noexcept;
+
+	ThreadPool* pool;
+	Settings rules;
+	const Simulation* simulation;
+	std::vector<size_t> sequence;
+	size_t maxDepth;
+	std::vector<Child> rootChildren;
+	std::array<PlacementSearch, 2> rootSearches;
+	std::vector<Context> contexts;
+	std::vector<std::vector<PerfectClearStep>> solutions;
+	/**
+	 * @brief rootChildren are handed out in order to the workers as they get done
+	 */
+	std::atomic<size_t> nextChild;
+	/**
+	 * @brief lowest index of rootChildren with a solution, workers stop searching children after it
+	 */
+	std::atomic<size_t> firstSolved;
+	/**
+	 * @brief most pieces each dead end was searched with
+	 */
+	TranspositionTable<uint8_t> deadEnds;
+};
+} // namespace raymino
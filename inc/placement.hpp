@@ -0,0 +1,139 @@
+#pragma once
+
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "types.hpp"
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raymino
+{
+/**
+ * @brief single input on the way to a placement, the final lock (hard drop) is implied
+ */
+enum class PlacementMove : uint8_t
+{
+	MoveLeft,
+	MoveRight,
+	RotateRight,
+	RotateLeft,
+	/**
+	 * @brief soft drop until the piece lands
+	 */
+	SoftDrop,
+};
+
+/**
+ * @brief view of the moves leading to a Placement, valid until the next PlacementSearch::search
+ */
+struct PlacementPath
+{
+	const PlacementMove* first;
+	const PlacementMove* last;
+
+	[[nodiscard]] const PlacementMove* begin() const noexcept
+	{
+		return first;
+	}
+	[[nodiscard]] const PlacementMove* end() const noexcept
+	{
+		return last;
+	}
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return static_cast<size_t>(last - first);
+	}
+	[[nodiscard]] PlacementMove operator[](size_t idx) const noexcept
+	{
+		return first[idx];
+	}
+};
+
+/**
+ * @brief resting position & rotation (0-3) a piece can lock at
+ */
+struct Placement
+{
+	Offset offset;
+	uint32_t pathBegin;
+	uint32_t pathLength;
+};
+
+/**
+ * @brief enumerates every placement a piece can reach on a playfield with the move & rotation rules of a game
+ * @remarks breadth first over (x, y, rotation) states with a visited bitset, so every path is a shortest one
+ * all buffers are held inline or reused, searching does not allocate once the result vectors have grown
+ */
+class PlacementSearch
+{
+public:
+	/**
+	 * @brief positions a piece can take beyond the playfield edges, its collision is at most 4x4
+	 */
+	static constexpr int MARGIN = 3;
+	static constexpr size_t MAX_STATES = static_cast<size_t>(Settings::MAX_FIELD_WIDTH + MARGIN) *
+	                                     (Settings::MAX_FIELD_HEIGHT + Simulation::HIDDEN_HEIGHT + MARGIN) * 4;
+
+	/**
+	 * @param settings rotation system & wall kicks to move with
+	 */
+	explicit PlacementSearch(const Settings& settings);
+
+	/**
+	 * @brief find every distinct placement of tetromino, placements covering equal cells are only listed once
+	 * @param field playfield to place on
+	 * @param tetromino piece at its starting offset, usually where it spawned
+	 * @return placements in order of path length, empty if tetromino overlaps at its start, valid until the next search
+	 * @pre field is at most Settings::MAX_FIELD_WIDTH x (MAX_FIELD_HEIGHT + Simulation::HIDDEN_HEIGHT)
+	 */
+	const std::vector<Placement>& search(const Grid& field, const Tetromino& tetromino);
+
+	/**
+	 * @return moves from the starting offset of the last search to placement
+	 */
+	[[nodiscard]] PlacementPath path(const Placement& placement) const noexcept;
+
+	/**
+	 * @brief search implementation for one RulePolicy, search dispatches to the one matching settings
+	 */
+	template<typename TRules>
+	void searchWith(const Grid& field, const Tetromino& tetromino);
+	using SearchFunc = void (PlacementSearch::*)(const Grid& field, const Tetromino& tetromino);
+
+private:
+	using StateIdx = uint16_t;
+	static_assert(MAX_STATES <= 0xFFFF);
+
+	struct Step
+	{
+		StateIdx parent;
+		PlacementMove move;
+	};
+
+	[[nodiscard]] StateIdx stateAt(Offset offset) const noexcept;
+	[[nodiscard]] Offset offsetAt(StateIdx state) const noexcept;
+	/**
+	 * @param state resting state found by the search
+	 * @param sameCells state of the rotation with the same cells & the lowest index
+	 */
+	void addPlacement(StateIdx state, StateIdx sameCells, Offset offset);
+
+	SearchFunc searchFunc;
+	Size fieldSize;
+	std::bitset<MAX_STATES> visited;
+	/**
+	 * @brief resting states already listed, see addPlacement
+	 */
+	std::bitset<MAX_STATES> landed;
+	std::array<Step, MAX_STATES> steps;
+	std::array<StateIdx, MAX_STATES> queue;
+	std::vector<Placement> placements;
+	std::vector<PlacementMove> moves;
+};
+} // namespace raymino
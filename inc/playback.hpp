@@ -0,0 +1,82 @@
+#pragma once
+
+#include "replay.hpp"
+#include "simulation.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace raymino
+{
+/**
+ * @brief steps a Simulation through a Replay & seeks within it
+ * @remarks a keyframe of the whole game state is kept every KEYFRAME_INTERVAL steps the first time playback passes
+ * it, seeking restores the closest one so it costs at most KEYFRAME_INTERVAL steps once the target was reached before
+ */
+class Playback
+{
+public:
+	static constexpr uint32_t KEYFRAME_INTERVAL = 600;
+
+	/**
+	 * @param replay to play back
+	 * @param colors Cell value of each TetrominoType
+	 */
+	Playback(Replay replay, const PieceColors& colors);
+	// the reader & keyframes point into recording
+	Playback(const Playback&) = delete;
+	Playback(Playback&&) = delete;
+	Playback& operator=(const Playback&) = delete;
+	Playback& operator=(Playback&&) = delete;
+	~Playback() = default;
+
+	/**
+	 * @brief step ticks of Settings::TICK_SECONDS until seconds more of game time are played back, carries over- &
+	 * undershoot to the next call
+	 * @return steps taken
+	 */
+	uint32_t advanceTime(double seconds);
+
+	/**
+	 * @return steps taken, less than steps at the end of the replay
+	 */
+	uint32_t advance(uint32_t steps);
+
+	/**
+	 * @param target step, clamped to length()
+	 */
+	void seek(uint32_t target);
+
+	[[nodiscard]] uint32_t position() const noexcept;
+	[[nodiscard]] uint32_t length() const noexcept;
+	[[nodiscard]] bool isFinished() const noexcept;
+
+	/**
+	 * @return seconds of game time played back
+	 */
+	[[nodiscard]] double elapsed() const noexcept;
+
+	/**
+	 * @return seconds of game time of the whole replay
+	 */
+	[[nodiscard]] double duration() const noexcept;
+
+	[[nodiscard]] const Simulation& simulation() const noexcept;
+	[[nodiscard]] const Replay& replay() const noexcept;
+
+private:
+	struct Keyframe
+	{
+		Simulation::Snapshot snapshot;
+		Replay::Reader reader;
+	};
+
+	bool step();
+
+	Replay recording;
+	Simulation current;
+	Replay::Reader reader;
+	double timeBudget = 0;
+	std::vector<Keyframe> keyframes;
+};
+} // namespace raymino
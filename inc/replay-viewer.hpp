@@ -0,0 +1,53 @@
+#pragma once
+
+#include "app.hpp"
+#include "game.hpp"
+#include "playback.hpp"
+#include "replay.hpp"
+#include "scenes.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace raymino
+{
+/**
+ * @brief plays back App::replayPath at selectable speed, seeking with the slider or arrow keys
+ */
+struct ReplayViewer : IScene
+{
+	ReplayViewer(App& app, Replay recording);
+	void Update(App& app) override;
+	void FixedUpdate(App& app) override;
+	void Draw(App& app) override;
+	void PreDestruct(App& app) override;
+	[[nodiscard]] bool isAllocationFree() const noexcept override;
+
+	/**
+	 * @brief read a file written by Game::storeReplay
+	 * @throws std::runtime_error if the file is missing or holds no replay
+	 */
+	static Replay load(const char* path);
+
+	/**
+	 * @brief step as far as the frame budget allows
+	 */
+	void advanceUnlimited();
+
+	static constexpr std::array<float, 3> SPEEDS{1, 2, 8};
+	static constexpr int SPEED_UNLIMITED = static_cast<int>(SPEEDS.size());
+	static constexpr const char* ToggleGroupSpeedText = "1x;2x;8x;Max";
+	static constexpr std::chrono::milliseconds UNLIMITED_FRAME_BUDGET{8};
+	static constexpr uint32_t UNLIMITED_STEPS_PER_CHECK = 64;
+	static constexpr uint32_t SKIP_STEPS = Settings::TICK_RATE * 5;
+
+	Playback playback;
+	GameView view;
+	int ToggleGroupSpeedActive;
+	float SliderBarPositionValue;
+	bool isPlaying;
+};
+} // namespace raymino
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "input.hpp"
+#include "savefile.hpp"
+#include "settings.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raymino
+{
+/**
+ * @brief recording of a game session: seed, settings & input changes, enough to step a Simulation again
+ * @remarks every step is one tick of Settings::TICK_SECONDS, the tick rate is stored once in the Info instead of a
+ * delta per step
+ */
+class Replay
+{
+public:
+	struct ChunkType
+	{
+		enum : decltype(SaveFile::Chunk::Header::type) // NOLINT(*-enum-size)
+		{
+			Info = 20,
+			// 21 held per step frame deltas, before steps were fixed ticks
+			Inputs = 22,
+		};
+	};
+
+	struct alignas(int64_t) Info
+	{
+		uint64_t seed;
+		Settings settings;
+		uint32_t steps;
+		/**
+		 * @brief steps per second, Settings::TICK_RATE
+		 */
+		uint32_t tickRate;
+	};
+	static_assert(sizeof(Info) == 32);
+
+	/**
+	 * @brief reads the steps of a Replay back in order
+	 * @remarks the Replay has to outlive the Reader and must not be recorded to while reading
+	 */
+	class Reader
+	{
+	public:
+		explicit Reader(const Replay& replay);
+
+		/**
+		 * @param[out] input for the step
+		 * @return false once all steps are read
+		 * @throws std::range_error if the data is truncated
+		 */
+		bool next(InputSnapshot& input);
+
+		/**
+		 * @return steps read so far
+		 */
+		[[nodiscard]] uint32_t position() const noexcept;
+
+	private:
+		const Replay* replay;
+		size_t inputPos = 0;
+		uint32_t step = 0;
+		uint64_t unchangedSteps = 0;
+		uint8_t down = 0;
+	};
+
+	/**
+	 * @param seed the Simulation is created with
+	 * @param settings the Simulation is created with
+	 */
+	Replay(uint64_t seed, const Settings& settings);
+
+	/**
+	 * @brief append a step of Settings::TICK_SECONDS
+	 * @param input for the step
+	 */
+	void record(const InputSnapshot& input);
+
+	/**
+	 * @return true if the next record() fits into the reserved capacity & does not allocate
+	 */
+	[[nodiscard]] bool canRecord() const noexcept;
+	/**
+	 * @brief reserve another chunk of input bytes once less than half of one is left, so a caller that has to stay
+	 * allocation free while recording can grow the buffer at a moment of its choosing
+	 * @return true if it allocated
+	 */
+	bool reserveAhead();
+
+	[[nodiscard]] const Info& info() const noexcept;
+	[[nodiscard]] Reader reader() const;
+
+	/**
+	 * @return encoded bytes of input changes, without the Info
+	 */
+	[[nodiscard]] size_t encodedBytes() const noexcept;
+
+	[[nodiscard]] SaveFile serialize() const;
+
+	/**
+	 * @throws std::runtime_error if the save does not contain a replay or one of another tick rate
+	 * @throws std::range_error if a chunk has the wrong size
+	 */
+	static Replay deserialize(const SaveFile& save);
+
+private:
+	Info header;
+	std::vector<uint8_t> inputs; // varint steps without change, then down bits & explicit edges if needed
+	uint64_t unchangedSteps = 0;
+	uint8_t prevDown = 0;
+};
+} // namespace raymino
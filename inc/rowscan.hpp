@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace raymino
+{
+/**
+ * @param row first cell of the row
+ * @param width cells in row
+ * @return uint64_t bit x set if row[x] != 0
+ * @pre width <= 64
+ * @remarks uses SSE2/AVX2 when available at compile time, scalar otherwise
+ */
+uint64_t rowOccupancyBits(const uint8_t* row, int width) noexcept;
+
+/**
+ * @param cells first cell
+ * @param count cells to test
+ * @return true if no cell is 0
+ */
+bool allCellsSet(const uint8_t* cells, size_t count) noexcept;
+
+/**
+ * @param cells first cell
+ * @param count cells to test
+ * @return true if every cell is 0
+ */
+bool allCellsClear(const uint8_t* cells, size_t count) noexcept;
+} // namespace raymino
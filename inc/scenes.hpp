@@ -13,6 +13,12 @@ struct IScene
 	 * @brief called every frame before draw to run update logic
 	 */
 	virtual void Update(class App& app) = 0;
+	/**
+	 * @brief called at Settings::TICK_RATE between Update & Draw, as often as needed to catch up to the frame time
+	 */
+	virtual void FixedUpdate([[maybe_unused]] class App& app)
+	{
+	}
 	/**
 	 * @brief called every frame after update to draw everything
 	 */
@@ -21,6 +27,13 @@ struct IScene
 	 * @brief should be called once before destruction
 	 */
 	virtual void PreDestruct(class App& app) = 0;
+	/**
+	 * @brief true if Update & Draw are expected to not allocate, checked with ENABLE_ALLOCATION_COUNTER
+	 */
+	[[nodiscard]] virtual bool isAllocationFree() const noexcept
+	{
+		return false;
+	}
 	virtual ~IScene() = default;
 };
 
@@ -32,6 +45,9 @@ enum class Scene
 	Game,
 	Menu,
 	Loading,
+	Replay,
+	Versus,
+	Attract,
 };
 
 /**
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace raymino
+{
+/**
+ * @brief game rules, trivially copyable & compared bytewise, stored as is in the save file
+ */
+struct alignas(int64_t) Settings
+{
+	RotationSystem rotationSystem = RotationSystem::Super;
+	WallKicks wallKicks = WallKicks::Super;
+	LockDown lockDown = LockDown::Extended;
+	SoftDrop softDrop = SoftDrop::NonLocking;
+	InstantDrop instantDrop = InstantDrop::Hard;
+	TSpin tSpin = TSpin::ThreeCorner;
+	ShuffleType shuffleType = ShuffleType::SingleBag;
+	ScoringSystem scoringSystem = ScoringSystem::Guideline;
+	LevelGoal levelGoal = LevelGoal::Fixed;
+	bool holdPiece = true;
+	bool ghostPiece = true;
+	uint8_t fieldWidth = 10;
+	uint8_t fieldHeight = 20;
+	uint8_t previewCount = 6;
+	[[maybe_unused]] uint8_t _reserved_[2]{}; // NOLINT(*-avoid-c-arrays)
+
+	bool operator==(const Settings& rhs) const noexcept;
+	bool operator!=(const Settings& rhs) const noexcept;
+	bool operator>(const Settings& rhs) const noexcept;
+	bool operator<(const Settings& rhs) const noexcept;
+	[[nodiscard]] int compare(const Settings& rhs) const noexcept;
+
+	static constexpr int SCREEN_WIDTH = 600;
+	static constexpr int SCREEN_HEIGHT = 600;
+	static constexpr float LOCK_DELAY = 0.5f;
+	static constexpr float DELAYED_AUTO_SHIFT = 1.0f / 6.0f;
+	static constexpr float AUTO_REPEAT_RATE = 1.0f / 30.0f;
+	static constexpr int MAX_FIELD_WIDTH = 22;
+	static constexpr int MAX_FIELD_HEIGHT = 45;
+	static constexpr int TICK_RATE = 240;
+	static constexpr float TICK_SECONDS = 1.0f / TICK_RATE;
+};
+
+namespace presets
+{
+struct NamedSettings
+{
+	std::string_view name;
+	Settings settings;
+};
+
+NamedSettings SettingsGuideline() noexcept;
+NamedSettings SettingsNES() noexcept;
+NamedSettings SettingsTGMLike() noexcept;
+
+/**
+ * @return all built in Settings, in the order the menu lists them
+ */
+std::array<NamedSettings, 3> builtinSettings() noexcept;
+} // namespace presets
+} // namespace raymino
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "input.hpp"
+#include "settings.hpp"
+#include "timer.hpp"
+#include "types.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace raymino
+{
+/**
+ * @brief Cell value for each TetrominoType, indexed by TetrominoType
+ */
+using PieceColors = std::array<Grid::Cell, 7>;
+
+/**
+ * @param seedText user seed, random if empty
+ * @return seed for Simulation
+ */
+size_t hashSeedString(std::string_view seedText);
+
+/**
+ * @brief the per move rules of a Simulation, fixed at compile time so step calls them directly
+ * @remarks rules used once per piece (t-spin, level, scoring & shuffle) stay selected at runtime, a policy over every
+ * rule enum would need thousands of step instantiations
+ */
+template<RotationSystem TRotation, WallKicks TWallKicks>
+struct RulePolicy
+{
+	static Offset rotate(const Tetromino& mino, int rotation)
+	{
+		return basicRotation<TRotation>(mino, rotation);
+	}
+	static Offset kick(const Grid& field, const Tetromino& tetromino, Offset offset) noexcept
+	{
+		return wallKick<TWallKicks>(field, tetromino, offset);
+	}
+};
+
+/**
+ * @brief the rules engine, advances a game by explicit time steps & input snapshots
+ * @remarks deterministic: equal settings, seed & steps result in equal games, no platform calls
+ * copies are independent games, the shuffler & scoring state is held by value
+ */
+struct Simulation
+{
+	static constexpr int HIDDEN_HEIGHT = 4;
+	static constexpr int LOCKDOWN_MAX_RESET = 15;
+	static constexpr size_t NO_HOLD_PIECE = std::numeric_limits<size_t>::max();
+	static constexpr Grid::Cell GARBAGE_COLOR = 8;
+
+	/**
+	 * @brief everything step changes, trivially copyable so saving & restoring is a flat copy without allocations
+	 * @remarks settings, baseTetrominos & the selected rule functions are fixed for a game and not part of it
+	 */
+	struct Snapshot
+	{
+		GridSnapshot<Settings::MAX_FIELD_WIDTH, Settings::MAX_FIELD_HEIGHT + HIDDEN_HEIGHT> playfield;
+		size_t holdPieceIdx;
+		std::mt19937_64 rng;
+		AnyShuffledIndices shuffledIndices;
+		IndexQueue nextTetrominoIndices;
+		Tetromino currentTetromino;
+		AnyScoringSystem scoringSystem;
+		int64_t score;
+		LevelState levelState;
+		Timer lockDelay;
+		int lockCounter;
+		bool isLocking;
+		bool holdPieceLocked;
+		bool isGameOver;
+		uint32_t lockedPieces;
+		std::array<uint32_t, 5> lineClears;
+		Timer gravity;
+		KeyAction moveRight;
+		KeyAction rotateRight;
+		std::minstd_rand garbageRng;
+		uint32_t pendingGarbage;
+		uint32_t linesSent;
+	};
+
+	/**
+	 * @param gameSettings rules to play by
+	 * @param seed for the Tetromino sequence
+	 * @param colors Cell value of each TetrominoType
+	 * @param garbageCell Cell value of received garbage rows
+	 * @throws std::length_error if the playfield exceeds Settings::MAX_FIELD_WIDTH x MAX_FIELD_HEIGHT
+	 */
+	Simulation(const Settings& gameSettings, uint64_t seed, const PieceColors& colors,
+	    Grid::Cell garbageCell = GARBAGE_COLOR);
+
+	/**
+	 * @return copy of the current game state
+	 */
+	[[nodiscard]] Snapshot save() const noexcept;
+	/**
+	 * @brief continue from snapshot, the game plays on exactly as it did after save
+	 * @pre snapshot was saved by a Simulation with equal settings & colors
+	 */
+	void restore(const Snapshot& snapshot) noexcept;
+
+	/**
+	 * @brief advance the game
+	 * @param delta seconds since the last step
+	 * @param input button state for this step
+	 * @remarks does nothing once isGameOver
+	 */
+	void step(float delta, const InputSnapshot& input);
+
+	/**
+	 * @brief step implementation for one RulePolicy, step dispatches to the one matching settings
+	 */
+	template<typename TRules>
+	void stepWith(float delta, const InputSnapshot& input);
+	using StepFunc = void (Simulation::*)(float delta, const InputSnapshot& input);
+
+	/**
+	 * @brief garbage from a versus opponent, raised into the playfield when the next piece locks without a clear
+	 * @remarks lines the player sends first cancel pending garbage
+	 */
+	void queueGarbage(uint32_t lines) noexcept;
+
+	/**
+	 * @return Zobrist hash of the playfield occupancy, the falling piece, hold & the visible preview pieces
+	 * @remarks timers, score & randomizer state are not part of it, it identifies a position for search, not a game
+	 */
+	[[nodiscard]] uint64_t positionHash() const noexcept;
+
+	IndexQueue fillIndices(size_t minIndices);
+	Tetromino getNextTetromino(size_t minIndices);
+
+	Settings settings;
+	Grid playfield;
+	std::vector<Tetromino> baseTetrominos;
+	size_t holdPieceIdx;
+	std::mt19937_64 rng;
+	AnyShuffledIndices shuffledIndices;
+	IndexQueue nextTetrominoIndices;
+	Tetromino currentTetromino;
+	AnyScoringSystem scoringSystem;
+	int64_t score;
+	decltype(levelUp(LevelGoal{})) levelUpFunc;
+	LevelState levelState;
+	Timer lockDelay;
+	int lockCounter;
+	bool isLocking;
+	bool holdPieceLocked;
+	bool isGameOver;
+	uint32_t lockedPieces;
+	/**
+	 * @brief locked pieces by lines they cleared, more than 4 lines count as 4
+	 */
+	std::array<uint32_t, 5> lineClears;
+	decltype(tSpinCheck(TSpin{})) tSpinFunc;
+	Timer gravity;
+	KeyAction moveRight;
+	KeyAction rotateRight;
+	std::minstd_rand garbageRng;
+	uint32_t pendingGarbage;
+	/**
+	 * @brief garbage sent to versus opponents in total, after cancelling pending garbage
+	 */
+	uint32_t linesSent;
+	Grid::Cell garbageColor;
+	StepFunc stepFunc;
+};
+static_assert(std::is_trivially_copyable_v<Simulation::Snapshot>);
+} // namespace raymino
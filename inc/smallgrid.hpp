@@ -0,0 +1,205 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+
+namespace raymino
+{
+/**
+ * @brief Grid with inline storage for at most TMaxWidth x TMaxHeight cells
+ * @remarks trivially copyable, cells are stored row major with a stride of the current width
+ */
+template<int TMaxWidth, int TMaxHeight>
+class SmallGrid
+{
+public:
+	using Cell = uint8_t;
+	using RowBits = uint64_t;
+	static constexpr Cell oobVal = 0xFF;
+	static_assert(TMaxWidth > 0 && TMaxHeight > 0);
+	static_assert(TMaxWidth <= std::numeric_limits<RowBits>::digits, "SmallGrid rows need to fit into RowBits");
+
+	/**
+	 * @throws std::logic_error if size exceeds capacity
+	 */
+	SmallGrid(Size gridSize, Cell fill) : size{gridSize}
+	{
+		checkCapacity(gridSize);
+		std::fill(cells.begin(), cells.end(), fill);
+		updateRowBits();
+	}
+	/**
+	 * @throws std::logic_error on size mismatch or if size exceeds capacity
+	 */
+	SmallGrid(Size gridSize, std::initializer_list<Cell> grid) : size{gridSize}
+	{
+		checkCapacity(gridSize);
+		if(grid.size() != gridSize.area())
+		{
+			throw std::logic_error("size mismatch");
+		}
+		std::copy(grid.begin(), grid.end(), cells.begin());
+		updateRowBits();
+	}
+
+	[[nodiscard]] bool isSquare() const noexcept
+	{
+		return size.width == size.height;
+	}
+
+	[[nodiscard]] Size getSize() const noexcept
+	{
+		return size;
+	}
+
+	/**
+	 * @param topLeft offset
+	 * @param oobValue = SmallGrid::oobVal
+	 * @return Cell cell value
+	 */
+	[[nodiscard]] Cell getAt(XY topLeft, Cell oobValue = oobVal) const noexcept
+	{
+		if(topLeft.x < 0 || topLeft.x >= size.width || topLeft.y >= size.height || topLeft.y < 0)
+		{
+			return oobValue;
+		}
+		return cells[index(topLeft.x, topLeft.y)];
+	}
+
+	[[nodiscard]] static constexpr bool hasRowBits() noexcept
+	{
+		return true;
+	}
+
+	/**
+	 * @param yPos row
+	 * @return RowBits bit x set if cell x != 0, 0 for rows outside grid
+	 */
+	[[nodiscard]] RowBits getRowBits(int yPos) const noexcept
+	{
+		return yPos < 0 || yPos >= size.height ? 0 : rowBits[static_cast<size_t>(yPos)];
+	}
+
+	template<typename TFunc>
+	void transformCells(TFunc func) noexcept
+	{
+		std::transform(begin(), end(), cells.begin(), func);
+		updateRowBits();
+	}
+	void fill(Cell value) noexcept
+	{
+		std::fill(cells.begin(), cells.end(), value);
+		updateRowBits();
+	}
+	/**
+	 * @brief sets every cell != 0 to color
+	 */
+	void recolor(Cell color) noexcept
+	{
+		for(Cell& cell : cells)
+		{
+			cell = cell != 0 ? color : Cell{0};
+		}
+		if(color == 0)
+		{
+			rowBits.fill(0);
+		}
+	}
+	void rotate(int steps) noexcept
+	{
+		steps %= 4;
+		while(steps != 0)
+		{
+			if(steps < 0)
+			{
+				reverseRows();
+				transpose();
+				++steps;
+			}
+			else
+			{
+				transpose();
+				reverseRows();
+				--steps;
+			}
+		}
+	}
+	void transpose() noexcept
+	{
+		static_assert(TMaxWidth == TMaxHeight, "transpose needs a square capacity");
+		const SmallGrid source{*this};
+		std::swap(size.width, size.height);
+		for(int yPos = 0; yPos < size.height; ++yPos)
+		{
+			for(int xPos = 0; xPos < size.width; ++xPos)
+			{
+				cells[index(xPos, yPos)] = source.cells[source.index(yPos, xPos)];
+			}
+		}
+		updateRowBits();
+	}
+	void reverseRows() noexcept
+	{
+		for(int yPos = 0; yPos < size.height; ++yPos)
+		{
+			const auto rowBegin = cells.begin() + static_cast<ptrdiff_t>(index(0, yPos));
+			std::reverse(rowBegin, rowBegin + size.width);
+		}
+		updateRowBits();
+	}
+
+	[[nodiscard]] auto begin() const noexcept
+	{
+		return cells.begin();
+	}
+	[[nodiscard]] auto end() const noexcept
+	{
+		return cells.begin() + static_cast<ptrdiff_t>(size.area());
+	}
+	[[nodiscard]] bool operator==(const SmallGrid& other) const noexcept
+	{
+		return size == other.size && std::equal(begin(), end(), other.begin());
+	}
+
+private:
+	static void checkCapacity(Size gridSize)
+	{
+		if(gridSize.width < 0 || gridSize.height < 0 || gridSize.width > TMaxWidth || gridSize.height > TMaxHeight)
+		{
+			throw std::logic_error("size exceeds capacity");
+		}
+	}
+	[[nodiscard]] size_t index(int xPos, int yPos) const noexcept
+	{
+		return (static_cast<size_t>(yPos) * static_cast<size_t>(size.width)) + static_cast<size_t>(xPos);
+	}
+	void updateRowBits() noexcept
+	{
+		rowBits.fill(0);
+		for(int yPos = 0; yPos < size.height; ++yPos)
+		{
+			for(int xPos = 0; xPos < size.width; ++xPos)
+			{
+				rowBits[static_cast<size_t>(yPos)] |= static_cast<RowBits>(cells[index(xPos, yPos)] != 0)
+				                                      << static_cast<unsigned>(xPos);
+			}
+		}
+	}
+
+	std::array<Cell, static_cast<size_t>(TMaxWidth) * static_cast<size_t>(TMaxHeight)> cells{};
+	std::array<RowBits, static_cast<size_t>(TMaxHeight)> rowBits{};
+	Size size;
+};
+
+/**
+ * @brief collision shape of a single Tetromino
+ */
+using PieceGrid = SmallGrid<4, 4>;
+} // namespace raymino
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace raymino
+{
+/**
+ * @brief fixed set of worker threads with a task queue each, idle workers steal from the others
+ * @remarks tasks are pushed round robin, owners take from the back & thieves from the front of a queue
+ */
+class ThreadPool
+{
+public:
+	using Task = std::function<void()>;
+
+	/**
+	 * @param threadCount workers to start, at least 1
+	 */
+	explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency());
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	ThreadPool& operator=(ThreadPool&&) = delete;
+	/**
+	 * @brief finishes all queued tasks, then joins the workers
+	 */
+	~ThreadPool();
+
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return workers.size();
+	}
+
+	/**
+	 * @brief queue task to run on any worker
+	 */
+	void submit(Task task);
+
+	/**
+	 * @brief block until all submitted tasks finished, the calling thread helps out meanwhile
+	 * @throws the first exception a task threw since the last wait
+	 */
+	void wait();
+
+	/**
+	 * @brief run func(index) for every index in [0, count) & wait for it
+	 * @param count indices
+	 * @param grain indices per task, 0 to pick one that gives each worker a few tasks to steal
+	 * @param func callable void(size_t)
+	 */
+	template<typename TFunc>
+	void parallelFor(size_t count, size_t grain, TFunc func)
+	{
+		if(grain == 0)
+		{
+			grain = std::max<size_t>(1, count / (size() * 8));
+		}
+		for(size_t first = 0; first < count; first += grain)
+		{
+			const size_t last = std::min(first + grain, count);
+			submit(
+			    [first, last, &func]
+			    {
+				    for(size_t index = first; index < last; ++index)
+				    {
+					    func(index);
+				    }
+			    });
+		}
+		wait();
+	}
+
+private:
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	void work(size_t queueIdx);
+	bool tryTake(size_t queueIdx, Task& task);
+	void run(Task& task) noexcept;
+
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> workers;
+	std::mutex stateMutex;
+	std::condition_variable wakeWorkers;
+	std::condition_variable allDone;
+	size_t queued = 0;
+	size_t pending = 0;
+	std::atomic<size_t> nextQueue{0};
+	std::exception_ptr firstException;
+	bool isStopping = false;
+};
+} // namespace raymino
@@ -2,28 +2,38 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 
 namespace raymino
 {
 struct Timer
 {
 	/**
-	 * @brief accumulate delta, will decrease elapsed until elapsed < delay
+	 * @brief accumulate delta, removes whole delays from elapsed so elapsed < delay
 	 * @param delta seconds
-	 * @return true if elapsed became >= delay
+	 * @return number of delays that elapsed
 	 */
-	bool step(float delta) noexcept
+	uint32_t step(float delta) noexcept
 	{
 		elapsed += delta;
+		if(elapsed < delay)
+		{
+			return 0;
+		}
+		auto steps = static_cast<uint32_t>(elapsed / delay);
+		elapsed -= static_cast<float>(steps) * delay;
+		// the division may round across a whole delay
 		if(elapsed >= delay)
 		{
-			while(elapsed >= delay)
-			{
-				elapsed -= delay;
-			}
-			return true;
+			elapsed -= delay;
+			steps += 1;
+		}
+		else if(elapsed < 0)
+		{
+			elapsed += delay;
+			steps -= 1;
 		}
-		return false;
+		return steps;
 	}
 	/**
 	 * @brief accumulate delta, needs manual reset
@@ -80,4 +90,8 @@ constexpr std::array DELAYS{
     1.f / 1200,
 };
 constexpr size_t MAX_SPEED_LEVEL = DELAYS.size() - 1;
+/**
+ * @brief 20 rows per frame at 60 fps, gravity at or above this drops pieces to the floor instantly
+ */
+constexpr float TWENTY_G_DELAY = 1.f / (20 * 60);
 } // namespace raymino
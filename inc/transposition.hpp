@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace raymino
+{
+/**
+ * @brief fixed size cache of search results keyed by Zobrist hashes, shared by concurrent searches without locks
+ * @remarks each slot holds the value & the key XOR the value in two relaxed atomics, a slot torn by concurrent
+ * stores fails the key check on lookup instead of returning a value of another position
+ * a store always replaces the slot of its key, results of different positions mapping to one slot evict each other
+ */
+template<typename TValue>
+class TranspositionTable
+{
+public:
+	static_assert(std::is_trivially_copyable_v<TValue> && sizeof(TValue) <= sizeof(uint32_t));
+
+	/**
+	 * @param capacity slots, rounded up to a power of two
+	 */
+	explicit TranspositionTable(size_t capacity) : slots(roundUp(capacity) * 2), mask{roundUp(capacity) - 1}
+	{
+	}
+
+	[[nodiscard]] size_t capacity() const noexcept
+	{
+		return mask + 1;
+	}
+
+	/**
+	 * @return value last stored for key, empty if the slot was never stored to or holds another key
+	 */
+	[[nodiscard]] std::optional<TValue> find(uint64_t key) const noexcept
+	{
+		const size_t slot = (key & mask) * 2;
+		const uint64_t data = slots[slot + 1].load(std::memory_order_relaxed);
+		const uint64_t check = slots[slot].load(std::memory_order_relaxed);
+		if((data & OCCUPIED) == 0 || (check ^ data) != key)
+		{
+			return std::nullopt;
+		}
+		TValue value{};
+		const auto bits = static_cast<uint32_t>(data);
+		std::memcpy(&value, &bits, sizeof(TValue));
+		return value;
+	}
+
+	void store(uint64_t key, TValue value) noexcept
+	{
+		uint32_t bits = 0;
+		std::memcpy(&bits, &value, sizeof(TValue));
+		const uint64_t data = OCCUPIED | bits;
+		const size_t slot = (key & mask) * 2;
+		slots[slot].store(key ^ data, std::memory_order_relaxed);
+		slots[slot + 1].store(data, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @pre no concurrent find or store
+	 */
+	void clear() noexcept
+	{
+		for(std::atomic<uint64_t>& slot : slots)
+		{
+			slot.store(0, std::memory_order_relaxed);
+		}
+	}
+
+private:
+	/**
+	 * @brief set in the data of every stored slot, so an empty slot never matches key 0
+	 */
+	static constexpr uint64_t OCCUPIED = uint64_t{1} << 32U;
+
+	[[nodiscard]] static size_t roundUp(size_t capacity) noexcept
+	{
+		size_t rounded = 1;
+		while(rounded < capacity)
+		{
+			rounded *= 2;
+		}
+		return rounded;
+	}
+
+	/**
+	 * @brief check & data of each slot next to each other, so a lookup touches one cache line
+	 */
+	std::vector<std::atomic<uint64_t>> slots;
+	size_t mask;
+};
+} // namespace raymino
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "app.hpp"
+#include "input.hpp"
+#include "scenes.hpp"
+#include "types.hpp"
+#include "versus.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace raymino
+{
+/**
+ * @brief two players on one keyboard, the second one's inputs take a detour through a LoopbackTransport to exercise
+ * the rollback of VersusSession like a remote peer would
+ */
+struct VersusGame : IScene
+{
+	explicit VersusGame(App& app);
+	void Update(App& app) override;
+	void FixedUpdate(App& app) override;
+	void Draw(App& app) override;
+	void PreDestruct(App& app) override;
+	[[nodiscard]] bool isAllocationFree() const noexcept override;
+
+	/**
+	 * @return fixed keys of the second player, left hand side of the keyboard
+	 */
+	static App::KeyBinds secondPlayerKeyBinds() noexcept;
+
+	static constexpr size_t PLAYER_COUNT = 2;
+	static constexpr uint32_t LATENCY_TICKS = Settings::TICK_RATE / 10;
+
+	enum class State
+	{
+		Running,
+		Paused,
+		GameOver,
+	};
+
+	VersusSession session;
+	LoopbackTransport transport;
+	App::KeyBinds secondKeyBinds;
+	std::array<Rect, PLAYER_COUNT> playfieldBounds;
+	/**
+	 * @brief input polled since the last tick, per player
+	 */
+	std::array<InputSnapshot, PLAYER_COUNT> pendingInputs;
+	uint32_t lastResimulated;
+	uint32_t maxResimulated;
+	State state;
+};
+} // namespace raymino
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "fixedqueue.hpp"
+#include "grid.hpp"
+#include "input.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace raymino
+{
+/**
+ * @brief N games played against each other, sending garbage on line clears
+ * @remarks inputs may arrive late: missing inputs are predicted from the last known one, once the real input differs
+ * the session restores the snapshot of that tick & resimulates up to the present with the corrected inputs
+ */
+class VersusSession
+{
+public:
+	/**
+	 * @brief ticks that can be rolled back, inputs arriving later stall the session
+	 */
+	static constexpr uint32_t ROLLBACK_TICKS = Settings::TICK_RATE / 4;
+
+	/**
+	 * @param settings rules for every player
+	 * @param seed shared by all players, everyone gets the same pieces
+	 * @param playerCount at least 1
+	 * @param colors Cell value of each TetrominoType
+	 * @param garbageCell Cell value of received garbage rows
+	 */
+	VersusSession(const Settings& settings, uint64_t seed, size_t playerCount, const PieceColors& colors,
+	    Grid::Cell garbageCell);
+
+	/**
+	 * @brief confirm the input of a player for inputTick, inputs of a player need to arrive in tick order
+	 * @return false if the input was not the next one expected from the player or too far ahead of tick()
+	 */
+	bool addInput(size_t playerIdx, uint32_t inputTick, const InputSnapshot& input) noexcept;
+
+	/**
+	 * @return true if a player's inputs are so late that the next tick could not be rolled back anymore
+	 */
+	[[nodiscard]] bool isStalled() const noexcept;
+
+	/**
+	 * @brief resimulate from the earliest mispredicted tick, then simulate tick()
+	 * @return false if stalled, nothing is simulated then
+	 */
+	bool advance() noexcept;
+
+	/**
+	 * @return the next tick to simulate
+	 */
+	[[nodiscard]] uint32_t tick() const noexcept;
+	/**
+	 * @return the next tick the player has to send an input for
+	 */
+	[[nodiscard]] uint32_t confirmedTick(size_t playerIdx) const noexcept;
+	/**
+	 * @return ticks resimulated by the last advance
+	 */
+	[[nodiscard]] uint32_t resimulatedTicks() const noexcept;
+	/**
+	 * @return true once at most one player is left & all inputs up to the tick that happened in are confirmed, so no
+	 * rollback can change the result anymore
+	 * @remarks the session keeps advancing after that, inputs of late players still arrive for the earlier ticks
+	 */
+	[[nodiscard]] bool isFinished() const noexcept;
+	/**
+	 * @return the player left when the result was decided, NO_WINNER before isFinished or if everyone lost in the same
+	 * tick
+	 */
+	[[nodiscard]] size_t winner() const noexcept;
+
+	[[nodiscard]] size_t playerCount() const noexcept;
+	[[nodiscard]] const Simulation& player(size_t playerIdx) const noexcept;
+
+	static constexpr size_t NO_WINNER = std::numeric_limits<size_t>::max();
+
+private:
+	/**
+	 * @brief inputs are kept for ticks ahead of tick() as well
+	 */
+	static constexpr uint32_t INPUT_TICKS = ROLLBACK_TICKS * 2;
+	static constexpr uint32_t NO_ROLLBACK = std::numeric_limits<uint32_t>::max();
+	static constexpr uint32_t UNDECIDED = std::numeric_limits<uint32_t>::max();
+
+	void simulate(uint32_t simulatedTick) noexcept;
+	/**
+	 * @brief record decidedTick & decidedWinner once at most one player is left after simulatedTick
+	 */
+	void decide(uint32_t simulatedTick) noexcept;
+	[[nodiscard]] InputSnapshot& inputAt(size_t playerIdx, uint32_t inputTick) noexcept;
+	[[nodiscard]] Simulation::Snapshot& snapshotAt(size_t playerIdx, uint32_t snapshotTick) noexcept;
+
+	std::vector<Simulation> players;
+	/**
+	 * @brief ring of the state at the start of the last ROLLBACK_TICKS ticks, per player
+	 */
+	std::vector<Simulation::Snapshot> snapshots;
+	/**
+	 * @brief ring of the confirmed or predicted input per tick & player
+	 */
+	std::vector<InputSnapshot> inputs;
+	std::vector<uint32_t> confirmedTicks;
+	std::vector<uint32_t> sentBefore;
+	uint32_t currentTick = 0;
+	uint32_t rollbackTick = NO_ROLLBACK;
+	uint32_t resimulated = 0;
+	/**
+	 * @brief tick after the one at most one player was left in, predicted until every input up to it is confirmed
+	 */
+	uint32_t decidedTick = UNDECIDED;
+	size_t decidedWinner = NO_WINNER;
+};
+
+/**
+ * @brief stands in for the network between versus sessions, delivers inputs after a fixed latency
+ */
+class LoopbackTransport
+{
+public:
+	struct Packet
+	{
+		size_t player;
+		uint32_t tick;
+		InputSnapshot input;
+	};
+
+	/**
+	 * @param latencyTicks between send & delivery
+	 */
+	explicit LoopbackTransport(uint32_t latencyTicks) noexcept;
+
+	/**
+	 * @throws std::length_error if more packets are in flight than the queue holds
+	 */
+	void send(const Packet& packet);
+	/**
+	 * @param now current tick, packets count as sent at their own tick
+	 * @param packet set to the oldest packet sent at least latency ticks before now
+	 * @return false if no packet is due
+	 */
+	bool receive(uint32_t now, Packet& packet) noexcept;
+
+	uint32_t latency;
+
+private:
+	FixedQueue<Packet, 256> inFlight;
+};
+} // namespace raymino
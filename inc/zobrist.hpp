@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace raymino
+{
+/**
+ * @brief Zobrist keys of game states, a state hashes to the XOR of the keys of its parts
+ * @remarks keys are derived by mixing the part with a per kind salt instead of a random table, so they are equal in
+ * every build & process and any row content has one
+ */
+namespace zobrist
+{
+/**
+ * @return splitmix64 finalizer of value, a bijection on 64 bit values
+ */
+[[nodiscard]] constexpr uint64_t mix(uint64_t value) noexcept
+{
+	value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+	return value ^ (value >> 31U);
+}
+
+/**
+ * @return salt of the idx-th key of a kind, far apart from the salts of other indices & kinds
+ */
+[[nodiscard]] constexpr uint64_t salt(uint64_t kind, uint64_t idx) noexcept
+{
+	return mix((kind << 32U) + idx + 1) & ~0xFFFFFFFFULL;
+}
+
+/**
+ * @param yPos row of a playfield
+ * @param bits occupancy of the row, see Grid::getRowBits
+ * @return key of the row, 0 for empty rows so an empty playfield hashes to 0 at any height
+ * @remarks row bits of a playfield are narrower than 32 bit, so they never reach the salt
+ */
+[[nodiscard]] constexpr uint64_t row(int yPos, uint64_t bits) noexcept
+{
+	return bits == 0 ? 0 : mix(bits ^ salt(1, static_cast<uint64_t>(yPos)));
+}
+
+/**
+ * @param type TetrominoType of the falling piece
+ * @param xPos, yPos, rotation Offset of the falling piece
+ */
+[[nodiscard]] constexpr uint64_t piece(size_t type, int xPos, int yPos, int rotation) noexcept
+{
+	const uint64_t offset = (static_cast<uint64_t>(static_cast<uint16_t>(xPos)) << 16U) |
+	                        static_cast<uint64_t>(static_cast<uint16_t>(yPos));
+	return mix(salt(2, (type * 4) + static_cast<uint64_t>(rotation & 0b11)) ^ offset);
+}
+
+/**
+ * @param pieceIdx held piece, Simulation::NO_HOLD_PIECE if none
+ * @param isLocked hold may not be used until the next piece
+ */
+[[nodiscard]] constexpr uint64_t hold(size_t pieceIdx, bool isLocked) noexcept
+{
+	return mix(salt(3, ((uint64_t{pieceIdx} + 1) * 2) + (isLocked ? 1 : 0)));
+}
+
+/**
+ * @param position in the queue of upcoming pieces, 0 is the next one
+ * @param pieceIdx piece at position
+ */
+[[nodiscard]] constexpr uint64_t queued(size_t position, size_t pieceIdx) noexcept
+{
+	return mix(salt(4, position) ^ pieceIdx);
+}
+
+/**
+ * @param count rows a search still has to clear
+ */
+[[nodiscard]] constexpr uint64_t linesLeft(int count) noexcept
+{
+	return mix(salt(5, static_cast<uint64_t>(count)));
+}
+
+/**
+ * @param first, last range of upcoming piece indices
+ * @return XOR of the queued keys, 0 for an empty range
+ */
+template<typename TIter>
+[[nodiscard]] constexpr uint64_t queue(TIter first, TIter last) noexcept
+{
+	uint64_t hash = 0;
+	for(size_t position = 0; first != last; ++first, ++position)
+	{
+		hash ^= queued(position, static_cast<size_t>(*first));
+	}
+	return hash;
+}
+} // namespace zobrist
+} // namespace raymino
@@ -0,0 +1,63 @@
+#include "allocation-counter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace raymino
+{
+static thread_local uint64_t allocations = 0;
+
+uint64_t allocationCount() noexcept
+{
+	return allocations;
+}
+} // namespace raymino
+
+void* operator new(std::size_t size)
+{
+	++raymino::allocations;
+	if(void* ptr = std::malloc(size == 0 ? 1 : size))
+	{
+		return ptr;
+	}
+	throw std::bad_alloc{};
+}
+void* operator new[](std::size_t size)
+{
+	return ::operator new(size);
+}
+void* operator new(std::size_t size, [[maybe_unused]] const std::nothrow_t& tag) noexcept
+{
+	++raymino::allocations;
+	return std::malloc(size == 0 ? 1 : size);
+}
+void* operator new[](std::size_t size, [[maybe_unused]] const std::nothrow_t& tag) noexcept
+{
+	return ::operator new(size, std::nothrow);
+}
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+void operator delete(void* ptr, [[maybe_unused]] std::size_t size) noexcept
+{
+	std::free(ptr);
+}
+void operator delete[](void* ptr, [[maybe_unused]] std::size_t size) noexcept
+{
+	std::free(ptr);
+}
+void operator delete(void* ptr, [[maybe_unused]] const std::nothrow_t& tag) noexcept
+{
+	std::free(ptr);
+}
+void operator delete[](void* ptr, [[maybe_unused]] const std::nothrow_t& tag) noexcept
+{
+	std::free(ptr);
+}
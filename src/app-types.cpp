@@ -33,27 +33,6 @@ bool App::HighScores::add(std::string_view name, int64_t score, const Settings&
 	return entryPos == recordPos;
 }
 
-bool App::Settings::operator==(const App::Settings& rhs) const noexcept
-{
-	return compare(rhs) == 0;
-}
-bool App::Settings::operator!=(const App::Settings& rhs) const noexcept
-{
-	return compare(rhs) != 0;
-}
-bool App::Settings::operator>(const App::Settings& rhs) const noexcept
-{
-	return compare(rhs) > 0;
-}
-bool App::Settings::operator<(const App::Settings& rhs) const noexcept
-{
-	return compare(rhs) < 0;
-}
-int App::Settings::compare(const App::Settings& rhs) const noexcept
-{
-	return std::memcmp(this, &rhs, sizeof(App::Settings));
-}
-
 bool App::KeyBinds::operator==(const App::KeyBinds& rhs) const noexcept
 {
 	return compare(rhs) == 0;
@@ -18,67 +18,31 @@
 #include <limits>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
 #if defined(PLATFORM_WEB)
 #include <emscripten/emscripten.h>
 #endif
+#if defined(RAYMINO_ALLOCATION_COUNTER)
+#include "allocation-counter.hpp"
 
-namespace raymino
-{
-namespace presets
-{
-App::Presets<App::Settings>::Item SettingsNES()
-{
-	App::Settings settings{};
-	settings.rotationSystem = RotationSystem::NintendoRight;
-	settings.wallKicks = WallKicks::None;
-	settings.lockDown = LockDown::Instant;
-	settings.softDrop = SoftDrop::Locking;
-	settings.instantDrop = InstantDrop::None;
-	settings.tSpin = TSpin::None;
-	settings.shuffleType = ShuffleType::NES;
-	settings.scoringSystem = ScoringSystem::Nintendo;
-	settings.levelGoal = LevelGoal::Fixed;
-	settings.holdPiece = false;
-	settings.ghostPiece = false;
-	settings.fieldWidth = 10;
-	settings.fieldHeight = 20;
-	settings.previewCount = 1;
-	return {"Nintendo NES", settings};
-}
+#include <cassert>
+#endif
 
-App::Presets<App::Settings>::Item SettingsTGMLike()
+namespace raymino
 {
-	App::Settings settings{};
-	settings.rotationSystem = RotationSystem::Arika;
-	settings.wallKicks = WallKicks::Arika;
-	settings.lockDown = LockDown::Classic;
-	settings.softDrop = SoftDrop::Locking;
-	settings.instantDrop = InstantDrop::Sonic;
-	settings.tSpin = TSpin::Lenient;
-	settings.shuffleType = ShuffleType::TGM35;
-	settings.scoringSystem = ScoringSystem::Guideline;
-	settings.levelGoal = LevelGoal::Fixed;
-	settings.holdPiece = false;
-	settings.ghostPiece = true;
-	settings.fieldWidth = 10;
-	settings.fieldHeight = 20;
-	settings.previewCount = 1;
-	return {"TGM Like", settings};
-}
-
-App::Presets<App::Settings>::Item SettingsGuideline()
+App::Presets<App::Settings>::Item toItem(presets::NamedSettings named)
 {
-	return {"Guideline", {}};
+	return {named.name, named.settings};
 }
-} // namespace presets
 
 App::App() :
     playerName{"Mino"},
     keyBindsPresets{{"Default", {}}},
-    settingsPresets{{presets::SettingsGuideline(), presets::SettingsNES(), presets::SettingsTGMLike()}},
+    settingsPresets{{toItem(presets::SettingsGuideline()), toItem(presets::SettingsNES()),
+        toItem(presets::SettingsTGMLike())}},
     activeKeyBindsPreset{0},
     activeSettingsPreset{0},
     window{Settings::SCREEN_WIDTH, Settings::SCREEN_HEIGHT, "raymino", FLAG_VSYNC_HINT}
@@ -95,15 +59,40 @@ void UpdateDraw(void* app)
 
 void App::UpdateDraw()
 {
+#if defined(RAYMINO_ALLOCATION_COUNTER)
+	const uint64_t allocationsBefore = allocationCount();
+	++sceneFrames;
+#endif
 	if(nextScene)
 	{
 		currentScene = std::move(nextScene);
+#if defined(RAYMINO_ALLOCATION_COUNTER)
+		sceneFrames = 0;
+#endif
 	}
 	currentScene->Update(*this);
+	tickAccumulator = std::min(tickAccumulator + ::GetFrameTime(), MAX_TICKS_PER_FRAME * Settings::TICK_SECONDS);
+	while(tickAccumulator >= Settings::TICK_SECONDS)
+	{
+		currentScene->FixedUpdate(*this);
+		tickAccumulator -= Settings::TICK_SECONDS;
+	}
 
 	window.BeginDrawing();
 	currentScene->Draw(*this);
 	window.EndDrawing();
+#if defined(RAYMINO_ALLOCATION_COUNTER)
+	frameAllocations = allocationCount() - allocationsBefore;
+	if(sceneFrames > ALLOCATION_WARMUP_FRAMES && !nextScene && currentScene->isAllocationFree())
+	{
+		if(frameAllocations != 0)
+		{
+			::TraceLog(LOG_WARNING, "RAYMINO: %llu allocations in allocation free frame",
+			    static_cast<unsigned long long>(frameAllocations));
+		}
+		assert(frameAllocations == 0);
+	}
+#endif
 }
 
 void App::Run()
@@ -138,6 +127,15 @@ void App::QueueSceneSwitch(Scene scene)
 	case Scene::Loading:
 		nextScene = MakeScene<Scene::Loading>(*this);
 		break;
+	case Scene::Replay:
+		nextScene = MakeScene<Scene::Replay>(*this);
+		break;
+	case Scene::Versus:
+		nextScene = MakeScene<Scene::Versus>(*this);
+		break;
+	case Scene::Attract:
+		nextScene = MakeScene<Scene::Attract>(*this);
+		break;
 	}
 }
 
@@ -213,7 +211,7 @@ SaveFile App::decompressFile(const void* compressedData, uint32_t size)
 	return SaveFile{std::move(decompressedData)};
 }
 
-void App::storeFile(const SaveFile& save)
+void App::storeFile(const SaveFile& save, const char* path)
 {
 	auto deflateState = std::make_unique<::sdefl>();
 	const int saveBufferSize = static_cast<int>(save.size() - HeaderSize);
@@ -227,23 +225,29 @@ void App::storeFile(const SaveFile& save)
 	deflateBuffer.resize(HeaderSize + static_cast<size_t>(deflateDataSize));
 
 #if defined(PLATFORM_WEB)
-	std::vector<uint8_t>* asyncData = new std::vector<uint8_t>(std::move(deflateBuffer));
+	struct AsyncData
+	{
+		std::string path;
+		std::vector<uint8_t> buffer;
+	};
+	auto* asyncData = new AsyncData{path, std::move(deflateBuffer)};
 	::emscripten_idb_async_store(
-	    IDB_PATH, SAVE_PATH, asyncData->data(), static_cast<int>(asyncData->size()), asyncData,
+	    IDB_PATH, asyncData->path.c_str(), asyncData->buffer.data(), static_cast<int>(asyncData->buffer.size()),
+	    asyncData,
 	    [](void* data)
 	    {
-		    auto* asyncData = static_cast<std::vector<uint8_t>*>(data);
-		    ::TraceLog(LOG_INFO, "FILEIO: [%s] File saved successfully", SAVE_PATH);
+		    auto* asyncData = static_cast<AsyncData*>(data);
+		    ::TraceLog(LOG_INFO, "FILEIO: [%s] File saved successfully", asyncData->path.c_str());
 		    delete asyncData;
 	    },
 	    [](void* data)
 	    {
-		    auto* asyncData = static_cast<std::vector<uint8_t>*>(data);
-		    ::TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to save file", SAVE_PATH);
+		    auto* asyncData = static_cast<AsyncData*>(data);
+		    ::TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to save file", asyncData->path.c_str());
 		    delete asyncData;
 	    });
 #else
-	::SaveFileData(SAVE_PATH, deflateBuffer.data(), static_cast<int>(deflateBuffer.size()));
+	::SaveFileData(path, deflateBuffer.data(), static_cast<int>(deflateBuffer.size()));
 #endif
 }
 
@@ -0,0 +1,84 @@
+#include "attract.hpp"
+
+#include "app.hpp"
+#include "bot.hpp"
+#include "game.hpp"
+#include "scenes.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "threadpool.hpp"
+
+#include <raylib.h>
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+namespace raymino
+{
+template<>
+std::unique_ptr<IScene> MakeScene<Scene::Attract>(App& app)
+{
+	return std::make_unique<Attract>(app);
+}
+
+std::unique_ptr<ThreadPool> makeBotPool()
+{
+#if defined(PLATFORM_WEB)
+	return nullptr;
+#else
+	// one core stays with the main thread
+	return std::make_unique<ThreadPool>(std::max(std::thread::hardware_concurrency(), 2U) - 1);
+#endif
+}
+
+Attract::Attract(App& app) :
+    simulation{app.settings(), hashSeedString({}), makePieceColors()},
+    view{simulation},
+    pool{makeBotPool()},
+    bot{simulation.settings, BotWeights{}, 1, pool.get()}
+{
+}
+
+void Attract::PreDestruct([[maybe_unused]] App& app)
+{
+	// demo games are neither recorded nor scored
+}
+
+bool Attract::isAllocationFree() const noexcept
+{
+	return false;
+}
+
+void Attract::Update(App& app)
+{
+	if(::GetKeyPressed() != 0 || ::IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+	{
+		app.QueueSceneSwitch(Scene::Menu);
+		view.state = GameView::State::GameOver;
+	}
+}
+
+void Attract::FixedUpdate(App& app)
+{
+	if(view.state != GameView::State::Running)
+	{
+		return;
+	}
+	simulation.step(Settings::TICK_SECONDS, bot.next(simulation));
+	view.score += simulation.score - view.score.value();
+	if(simulation.isGameOver)
+	{
+		view.state = GameView::State::GameOver;
+		app.QueueSceneSwitch(Scene::Attract);
+	}
+}
+
+void Attract::Draw([[maybe_unused]] App& app)
+{
+	view.draw(simulation);
+	constexpr int fontSize = 20;
+	::DrawText(HintText, (App::Settings::SCREEN_WIDTH - ::MeasureText(HintText, fontSize)) / 2,
+	    App::Settings::SCREEN_HEIGHT - (fontSize * 2), fontSize, DARKGRAY);
+}
+} // namespace raymino
@@ -0,0 +1,401 @@
+#include "bot.hpp"
+
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "input.hpp"
+#include "placement.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "threadpool.hpp"
+#include "transposition.hpp"
+#include "zobrist.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace raymino
+{
+/**
+ * @brief score of a placement that tops out or of a piece that can not be placed at all
+ */
+constexpr float LOSS = -1e9f;
+
+BoardFeatures boardFeatures(const Grid& field) noexcept
+{
+	const Size size = field.getSize();
+	BoardFeatures features{0, 0, 0, 0, 0};
+	Grid::RowBits covered = 0;
+	for(int yPos = 0; yPos < size.height; ++yPos)
+	{
+		const Grid::RowBits row = field.getRowBits(yPos);
+		features.holes += static_cast<int>(std::bitset<64>{covered & ~row}.count());
+		if(yPos < Simulation::HIDDEN_HEIGHT)
+		{
+			features.hiddenCells += static_cast<int>(std::bitset<64>{row}.count());
+		}
+		covered |= row;
+	}
+	for(int xPos = 0; xPos < size.width; ++xPos)
+	{
+		const int height = size.height - field.getColumnTop(xPos);
+		features.aggregateHeight += height;
+		const int left = xPos == 0 ? size.height : size.height - field.getColumnTop(xPos - 1);
+		const int right = xPos + 1 == size.width ? size.height : size.height - field.getColumnTop(xPos + 1);
+		if(xPos + 1 < size.width)
+		{
+			features.bumpiness += std::abs(height - right);
+		}
+		features.wellDepth += std::max(std::min(left, right) - height - 1, 0);
+	}
+	return features;
+}
+
+float evaluate(const BoardFeatures& features, const BotWeights& weights) noexcept
+{
+	return (weights.aggregateHeight * static_cast<float>(features.aggregateHeight)) +
+	       (weights.holes * static_cast<float>(features.holes)) +
+	       (weights.bumpiness * static_cast<float>(features.bumpiness)) +
+	       (weights.wellDepth * static_cast<float>(features.wellDepth)) +
+	       (weights.hiddenCells * static_cast<float>(features.hiddenCells));
+}
+
+/**
+ * @brief lock tetromino at placement into field
+ * @return lines cleared
+ */
+uint32_t place(Grid& field, const Tetromino& tetromino, const Placement& placement) noexcept
+{
+	field.setAt(placement.offset.position, tetromino.collision(placement.offset.rotation));
+	return field.eraseFullRows();
+}
+
+/**
+ * @brief pieces a rollout sequence may ask for, MultiBag adds up to a whole bag past them into the queue
+ */
+constexpr size_t MAX_SAMPLED = IndexQueue::capacity() / 2;
+
+Bot::Bot(const Settings& settings, const BotWeights& botWeights, size_t maxLookahead, ThreadPool* workers,
+    const BotRollouts& botRollouts) :
+    simulation{nullptr},
+    weights{botWeights},
+    lookahead{std::min<size_t>(maxLookahead, settings.previewCount)},
+    pool{workers},
+    rollouts{botRollouts},
+    roots{},
+    rootSearches{PlacementSearch{settings}, PlacementSearch{settings}},
+    table{TABLE_CAPACITY},
+    current{false, Offset{}, {}, 0},
+    nextMove{0},
+    plannedPiece{0},
+    expectedY{0},
+    isPlanned{false},
+    isHolding{false},
+    isReleasing{false},
+    acceptY{false}
+{
+	const Grid field{{settings.fieldWidth, settings.fieldHeight + Simulation::HIDDEN_HEIGHT}, 0};
+	contexts.resize(pool == nullptr ? 1 : pool->size(),
+	    Context{std::vector<PlacementSearch>(lookahead, PlacementSearch{settings}),
+	        std::vector<Grid>(lookahead + 1, field), PlacementSearch{settings}, {field, field, field}});
+	rollouts.depth = std::min(rollouts.depth, MAX_SAMPLED - std::min<size_t>(MAX_SAMPLED, settings.previewCount + 1U));
+}
+
+Bot::Plan Bot::plan(const Simulation& game)
+{
+	simulation = &game;
+	const IndexQueue& nextIndices = game.nextTetrominoIndices;
+	size_t rootCount = 1;
+	roots[0].useHold = false;
+	roots[0].tetromino = &game.currentTetromino;
+	roots[0].previews.assign(nextIndices.begin(), nextIndices.begin() + static_cast<ptrdiff_t>(lookahead));
+	roots[0].firstPreview = 0;
+	if(game.settings.holdPiece && !game.holdPieceLocked)
+	{
+		const bool isHoldEmpty = game.holdPieceIdx == Simulation::NO_HOLD_PIECE;
+		const size_t skipped = isHoldEmpty ? 1 : 0;
+		const size_t previews = std::min(lookahead, nextIndices.size() - skipped);
+		roots[1].useHold = true;
+		roots[1].tetromino = &game.baseTetrominos[isHoldEmpty ? nextIndices.front() : game.holdPieceIdx];
+		roots[1].previews.assign(nextIndices.begin() + static_cast<ptrdiff_t>(skipped),
+		    nextIndices.begin() + static_cast<ptrdiff_t>(skipped + previews));
+		roots[1].firstPreview = skipped;
+		rootCount = 2;
+	}
+
+	candidates.clear();
+	for(size_t rootIdx = 0; rootIdx < rootCount; ++rootIdx)
+	{
+		for(const Placement& placement : rootSearches[rootIdx].search(game.playfield, *roots[rootIdx].tetromino))
+		{
+			candidates.push_back({rootIdx, placement});
+		}
+	}
+	scores.assign(candidates.size(), LOSS);
+	const auto scoreStriped = [this, &game](size_t contextIdx)
+	{
+		for(size_t idx = contextIdx; idx < candidates.size(); idx += contexts.size())
+		{
+			scores[idx] = scoreCandidate(contexts[contextIdx], game.playfield, candidates[idx]);
+		}
+	};
+	if(pool == nullptr)
+	{
+		scoreStriped(0);
+	}
+	else
+	{
+		pool->parallelFor(contexts.size(), 1, scoreStriped);
+	}
+
+	Plan best{false, game.currentTetromino, {}, LOSS};
+	if(candidates.empty())
+	{
+		return best;
+	}
+	// the first of equal scores, so the choice does not depend on the thread count
+	size_t bestIdx = static_cast<size_t>(std::max_element(scores.begin(), scores.end()) - scores.begin());
+	best.score = scores[bestIdx];
+	if(rollouts.samples > 0 && rollouts.candidates > 0)
+	{
+		bestIdx = rolloutBest(game);
+		best.score = scores[bestIdx];
+	}
+	const Candidate& chosen = candidates[bestIdx];
+	const PlacementPath path = rootSearches[chosen.rootIdx].path(chosen.placement);
+	best.useHold = roots[chosen.rootIdx].useHold;
+	best.target = chosen.placement.offset;
+	best.path.assign(path.begin(), path.end());
+	return best;
+}
+
+size_t Bot::rolloutBest(const Simulation& game)
+{
+	rolledOut.resize(candidates.size());
+	std::iota(rolledOut.begin(), rolledOut.end(), size_t{0});
+	const size_t count = std::min(rollouts.candidates, candidates.size());
+	std::partial_sort(rolledOut.begin(), rolledOut.begin() + static_cast<ptrdiff_t>(count), rolledOut.end(),
+	    [this](size_t lhs, size_t rhs)
+	    {
+		    return scores[lhs] > scores[rhs] || (scores[lhs] == scores[rhs] && lhs < rhs);
+	    });
+	rolledOut.resize(count);
+
+	// every candidate is rolled out over the same sequences, so they differ by their placements & not by their luck
+	const IndexQueue& nextIndices = game.nextTetrominoIndices;
+	const size_t visible = std::min<size_t>(game.settings.previewCount, nextIndices.size());
+	const size_t length = game.settings.previewCount + rollouts.depth + 1;
+	sequences.resize(rollouts.samples);
+	const uint64_t position = game.positionHash();
+	for(size_t sampleIdx = 0; sampleIdx < sequences.size(); ++sampleIdx)
+	{
+		std::mt19937_64 rng{zobrist::mix(position + sampleIdx)};
+		sequences[sampleIdx] = game.shuffledIndices.sample(nextIndices, visible, length, rng);
+	}
+
+	rolloutScores.assign(count * sequences.size(), LOSS);
+	const auto rollOutStriped = [this, &game](size_t contextIdx)
+	{
+		for(size_t idx = contextIdx; idx < rolloutScores.size(); idx += contexts.size())
+		{
+			rolloutScores[idx] = rollout(contexts[contextIdx], game.playfield,
+			    candidates[rolledOut[idx / sequences.size()]], sequences[idx % sequences.size()]);
+		}
+	};
+	if(pool == nullptr)
+	{
+		rollOutStriped(0);
+	}
+	else
+	{
+		pool->parallelFor(contexts.size(), 1, rollOutStriped);
+	}
+
+	size_t bestIdx = rolledOut.front();
+	float bestMean = LOSS;
+	for(size_t rank = 0; rank < count; ++rank)
+	{
+		const auto first = rolloutScores.begin() + static_cast<ptrdiff_t>(rank * sequences.size());
+		const float mean = std::accumulate(first, first + static_cast<ptrdiff_t>(sequences.size()), 0.0f) /
+		                   static_cast<float>(sequences.size());
+		if(mean > bestMean)
+		{
+			bestMean = mean;
+			bestIdx = rolledOut[rank];
+		}
+	}
+	return bestIdx;
+}
+
+float Bot::rollout(Context& context, const Grid& field, const Candidate& candidate, const IndexQueue& sequence)
+{
+	const Root& root = roots[candidate.rootIdx];
+	Grid& board = context.rolloutFields[0];
+	board = field;
+	float score = weights.lineClears[std::min<size_t>(place(board, *root.tetromino, candidate.placement), 4)];
+	const size_t last = root.firstPreview + simulation->settings.previewCount + rollouts.depth;
+	for(size_t idx = root.firstPreview; idx < last; ++idx)
+	{
+		const Tetromino& tetromino = simulation->baseTetrominos[sequence[idx]];
+		float best = LOSS;
+		float bestReward = 0.0f;
+		for(const Placement& placement : context.rolloutSearch.search(board, tetromino))
+		{
+			Grid& placed = context.rolloutFields[1];
+			placed = board;
+			const float reward = weights.lineClears[std::min<size_t>(place(placed, tetromino, placement), 4)];
+			const float value = reward + evaluate(boardFeatures(placed), weights);
+			if(value > best)
+			{
+				best = value;
+				bestReward = reward;
+				std::swap(placed, context.rolloutFields[2]);
+			}
+		}
+		if(best == LOSS)
+		{
+			return LOSS;
+		}
+		std::swap(board, context.rolloutFields[2]);
+		score += bestReward;
+	}
+	return score + evaluate(boardFeatures(board), weights);
+}
+
+float Bot::scoreCandidate(Context& context, const Grid& field, const Candidate& candidate)
+{
+	const Root& root = roots[candidate.rootIdx];
+	Grid& placed = context.fields[0];
+	placed = field;
+	const uint32_t lines = place(placed, *root.tetromino, candidate.placement);
+	return weights.lineClears[std::min<size_t>(lines, 4)] + bestScore(context, root, 0);
+}
+
+float Bot::bestScore(Context& context, const Root& root, size_t depth)
+{
+	const Grid& field = context.fields[depth];
+	if(depth == root.previews.size())
+	{
+		return evaluate(boardFeatures(field), weights);
+	}
+	// the previews are keyed by their position from depth on, so the key stays valid for the following plans
+	const auto remaining = root.previews.begin() + static_cast<ptrdiff_t>(depth);
+	const uint64_t key = field.getHash() ^ zobrist::queue(remaining, root.previews.end());
+	if(const std::optional<float> cached = table.find(key))
+	{
+		return *cached;
+	}
+	const Tetromino& tetromino = simulation->baseTetrominos[root.previews[depth]];
+	float best = LOSS;
+	for(const Placement& placement : context.searches[depth].search(field, tetromino))
+	{
+		Grid& placed = context.fields[depth + 1];
+		placed = field;
+		const uint32_t lines = place(placed, tetromino, placement);
+		best = std::max(best, weights.lineClears[std::min<size_t>(lines, 4)] + bestScore(context, root, depth + 1));
+	}
+	table.store(key, best);
+	return best;
+}
+
+InputSnapshot Bot::next(const Simulation& game)
+{
+	const Tetromino& piece = game.currentTetromino;
+	if(!isPlanned || game.lockedPieces != plannedPiece)
+	{
+		isPlanned = true;
+		plannedPiece = game.lockedPieces;
+		current = plan(game);
+		nextMove = 0;
+		isHolding = current.useHold;
+		acceptY = true;
+	}
+	if(isReleasing)
+	{
+		isReleasing = false;
+		return InputSnapshot{};
+	}
+	if(isHolding)
+	{
+		isHolding = false;
+		isReleasing = true;
+		acceptY = true;
+		return InputSnapshot::tap(InputSnapshot::Hold);
+	}
+
+	const bool isSoftDropping =
+	    nextMove < current.path.size() && current.path[nextMove] == PlacementMove::SoftDrop;
+	if(acceptY)
+	{
+		acceptY = false;
+		expectedY = piece.position.y;
+	}
+	else if(!isSoftDropping && piece.position.y != expectedY)
+	{
+		// gravity moved the piece off the path, the rest of it may not fit anymore
+		current = plan(game);
+		nextMove = 0;
+		expectedY = piece.position.y;
+		if(current.useHold)
+		{
+			isHolding = false;
+			isReleasing = true;
+			acceptY = true;
+			return InputSnapshot::tap(InputSnapshot::Hold);
+		}
+	}
+
+	// the hard drop at the end covers a final soft drop
+	const bool isLastDropped = !current.path.empty() && current.path.back() == PlacementMove::SoftDrop &&
+	                           game.settings.instantDrop != InstantDrop::None;
+	if(nextMove + (isLastDropped ? 1 : 0) < current.path.size())
+	{
+		const PlacementMove move = current.path[nextMove];
+		if(move == PlacementMove::SoftDrop)
+		{
+			if(game.playfield.dropDistance(piece.position, piece.collision()) > 0)
+			{
+				InputSnapshot input;
+				input.set(InputSnapshot::SoftDrop, true, false, false);
+				return input;
+			}
+			++nextMove;
+			expectedY = piece.position.y;
+			return InputSnapshot{};
+		}
+		++nextMove;
+		isReleasing = true;
+		switch(move)
+		{
+		case PlacementMove::MoveLeft:
+			return InputSnapshot::tap(InputSnapshot::MoveLeft);
+		case PlacementMove::MoveRight:
+			return InputSnapshot::tap(InputSnapshot::MoveRight);
+		case PlacementMove::RotateRight:
+			acceptY = true;
+			return InputSnapshot::tap(InputSnapshot::RotateRight);
+		case PlacementMove::RotateLeft:
+		default:
+			acceptY = true;
+			return InputSnapshot::tap(InputSnapshot::RotateLeft);
+		}
+	}
+
+	if(game.settings.instantDrop != InstantDrop::None)
+	{
+		isReleasing = true;
+		return InputSnapshot::tap(InputSnapshot::HardDrop);
+	}
+	InputSnapshot input;
+	input.set(InputSnapshot::SoftDrop, true, false, false);
+	return input;
+}
+} // namespace raymino
@@ -7,9 +7,10 @@
 #include "grid.hpp"
 #include "gui.hpp"
 #include "input.hpp"
+#include "replay.hpp"
 #include "scenes.hpp"
+#include "simulation.hpp"
 #include "textbuffer.hpp"
-#include "timer.hpp"
 #include "types.hpp"
 
 #include <raylib.h>
@@ -24,15 +25,16 @@ bool constexpr operator<(::Color lhs, ::Color rhs) noexcept
 }
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
-#include <deque>
 #include <functional>
-#include <limits>
 #include <memory>
 #include <random>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace raymino
@@ -45,10 +47,34 @@ std::unique_ptr<IScene> MakeScene<Scene::Game>(App& app)
 
 void Game::PreDestruct([[maybe_unused]] App& app)
 {
-	// nothing to do
+	storeReplay();
 }
 
-constexpr int HIDDEN_HEIGHT = 4;
+void Game::storeReplay()
+{
+	if(isReplayStored || replay.info().steps == 0)
+	{
+		return;
+	}
+	isReplayStored = true;
+#if !defined(PLATFORM_WEB)
+	if(!::DirectoryExists(App::REPLAY_DIRECTORY))
+	{
+		::MakeDirectory(App::REPLAY_DIRECTORY);
+	}
+#endif
+	const auto millis =
+	    std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
+	App::storeFile(replay.serialize(),
+	    ::TextFormat("%s/%lld.raymino", App::REPLAY_DIRECTORY, static_cast<long long>(millis.count())));
+}
+
+bool Game::isAllocationFree() const noexcept
+{
+	return view.state != GameView::State::GameOver && !isReplayGrowing;
+}
+
+constexpr int HIDDEN_HEIGHT = Simulation::HIDDEN_HEIGHT;
 constexpr int SIDEBAR_WIDTH = 150;
 constexpr int PREVIEW_ELEMENT_HEIGHT = 100;
 constexpr int PREVIEW_CELL_SIZE = 30;
@@ -57,38 +83,22 @@ constexpr XY OFFSCREEN_POSITION{-1337, -1337};
 constexpr int SCORE_FONT_SIZE = 30;
 constexpr int STATUS_FONT_SIZE = 50;
 constexpr ::Color STATUS_BACKGROUND{77, 77, 77, 222};
-constexpr int LOCKDOWN_MAX_RESET = 15;
-constexpr size_t NO_HOLD_PIECE = std::numeric_limits<size_t>::max();
 
 const ColorMap minoColors{
     {LIGHTGRAY, GRAY, DARKGRAY, YELLOW, GOLD, ORANGE, PINK, RED, MAROON, GREEN, LIME, DARKGREEN, SKYBLUE, BLUE,
         DARKBLUE, PURPLE, VIOLET, DARKPURPLE, BEIGE, BROWN, DARKBROWN, WHITE, BLACK, BLANK, MAGENTA, RAYWHITE}};
 
-void prepareTetromino(Tetromino& tetromino, Grid::Cell color, int fieldWidth) noexcept
-{
-	tetromino.collision.transformCells(
-	    [color](Grid::Cell current)
-	    {
-		    return static_cast<Grid::Cell>(current * color);
-	    });
-	tetromino.position = spawnPosition(tetromino, HIDDEN_HEIGHT - 2, fieldWidth);
-}
-
-std::vector<Tetromino> prepareTetrominos(std::vector<Tetromino> tetrominos, int fieldWidth) noexcept
+PieceColors makePieceColors()
 {
-	std::sort(tetrominos.begin(), tetrominos.end(),
-	    [](const Tetromino& lhs, const Tetromino& rhs)
-	    {
-		    return lhs.type < rhs.type;
-	    });
-	prepareTetromino(tetrominos[static_cast<size_t>(TetrominoType::I)], minoColors[SKYBLUE], fieldWidth);
-	prepareTetromino(tetrominos[static_cast<size_t>(TetrominoType::L)], minoColors[ORANGE], fieldWidth);
-	prepareTetromino(tetrominos[static_cast<size_t>(TetrominoType::J)], minoColors[BLUE], fieldWidth);
-	prepareTetromino(tetrominos[static_cast<size_t>(TetrominoType::O)], minoColors[YELLOW], fieldWidth);
-	prepareTetromino(tetrominos[static_cast<size_t>(TetrominoType::Z)], minoColors[RED], fieldWidth);
-	prepareTetromino(tetrominos[static_cast<size_t>(TetrominoType::T)], minoColors[PINK], fieldWidth);
-	prepareTetromino(tetrominos[static_cast<size_t>(TetrominoType::S)], minoColors[GREEN], fieldWidth);
-	return tetrominos;
+	PieceColors colors{};
+	colors[static_cast<size_t>(TetrominoType::I)] = minoColors[SKYBLUE];
+	colors[static_cast<size_t>(TetrominoType::L)] = minoColors[ORANGE];
+	colors[static_cast<size_t>(TetrominoType::J)] = minoColors[BLUE];
+	colors[static_cast<size_t>(TetrominoType::O)] = minoColors[YELLOW];
+	colors[static_cast<size_t>(TetrominoType::Z)] = minoColors[RED];
+	colors[static_cast<size_t>(TetrominoType::T)] = minoColors[PINK];
+	colors[static_cast<size_t>(TetrominoType::S)] = minoColors[GREEN];
+	return colors;
 }
 
 Rect calculatePlayfieldBounds(Size fieldSize) noexcept
@@ -106,7 +116,7 @@ Rect calculatePlayfieldBounds(Size fieldSize) noexcept
 	return {{xOffset, yOffset}, {actualWidth, actualHeight}};
 }
 
-XY calcCenterOffset(const Grid& grid, Size available, int cellSize) noexcept
+XY calcCenterOffset(const PieceGrid& grid, Size available, int cellSize) noexcept
 {
 	const Rect actual = findTrueSize(grid) * cellSize;
 	const int xOffset = ((available.width - actual.width) / 2) - actual.x;
@@ -120,7 +130,7 @@ std::vector<XY> calcCenterOffsets(const std::vector<Tetromino>& tetrominos, Size
 	offsets.reserve(tetrominos.size() + 1);
 	for(const Tetromino& tetromino : tetrominos)
 	{
-		offsets.push_back(calcCenterOffset(tetromino.collision, available, cellSize));
+		offsets.push_back(calcCenterOffset(tetromino.collision(), available, cellSize));
 	}
 	offsets.push_back(OFFSCREEN_POSITION);
 	return offsets;
@@ -136,20 +146,33 @@ std::vector<XY> calcCenterOffsetsExtended(const std::vector<Tetromino>& tetromin
 	return offsets;
 }
 
-bool isKeyPress(KeyAction::Return keyPress) noexcept
+InputSnapshot pollInput(const App::KeyBinds& keyBinds) noexcept
 {
-	return keyPress.value != 0 && keyPress.state != KeyAction::State::Released;
+	const std::array<std::pair<int16_t, InputSnapshot::Button>, 7> bindings{{
+	    {keyBinds.moveRight, InputSnapshot::MoveRight},
+	    {keyBinds.moveLeft, InputSnapshot::MoveLeft},
+	    {keyBinds.rotateRight, InputSnapshot::RotateRight},
+	    {keyBinds.rotateLeft, InputSnapshot::RotateLeft},
+	    {keyBinds.softDrop, InputSnapshot::SoftDrop},
+	    {keyBinds.hardDrop, InputSnapshot::HardDrop},
+	    {keyBinds.hold, InputSnapshot::Hold},
+	}};
+	InputSnapshot input;
+	for(const auto& [key, button] : bindings)
+	{
+		input.set(button, ::IsKeyDown(key), ::IsKeyPressed(key), ::IsKeyReleased(key));
+	}
+	return input;
 }
 
 void Game::Update(App& app)
 {
 	const App::KeyBinds& keyBinds = app.keyBinds();
-	const App::Settings& settings = app.settings();
 
 	if(::IsKeyPressed(keyBinds.menu))
 	{
 		app.QueueSceneSwitch(Scene::Menu);
-		state = State::GameOver;
+		view.state = GameView::State::GameOver;
 	}
 	if(::IsKeyPressed(keyBinds.restart))
 	{
@@ -157,182 +180,61 @@ void Game::Update(App& app)
 	}
 	if(::IsKeyPressed(keyBinds.pause))
 	{
-		switch(state)
+		switch(view.state)
 		{
-		case State::Running:
-			state = State::Paused;
+		case GameView::State::Running:
+			view.state = GameView::State::Paused;
 			break;
-		case State::Paused:
-			state = State::Running;
+		case GameView::State::Paused:
+			view.state = GameView::State::Running;
 			break;
-		case State::GameOver:
+		case GameView::State::GameOver:
 			app.QueueSceneSwitch(Scene::Game);
 			break;
 		}
 	}
-	if(state == State::Running && !::IsWindowFocused())
-	{
-		state = State::Paused;
-	}
-
-	if(state != State::Running)
+	if(view.state == GameView::State::Running && !::IsWindowFocused())
 	{
-		return;
+		view.state = GameView::State::Paused;
 	}
 
-	if(settings.holdPiece && !holdPieceLocked && ::IsKeyPressed(keyBinds.hold))
+	if(view.state == GameView::State::Running)
 	{
-		if(holdPieceIdx == NO_HOLD_PIECE)
-		{
-			holdPieceIdx = static_cast<size_t>(currentTetromino.type);
-			currentTetromino = getNextTetromino(settings.previewCount);
-		}
-		else
-		{
-			const auto nextHoldIdx = static_cast<size_t>(currentTetromino.type);
-			currentTetromino = baseTetrominos[holdPieceIdx];
-			holdPieceIdx = nextHoldIdx;
-		}
-		isLocking = false;
-		lockCounter = 0;
-		holdPieceLocked = true;
+		pendingInput.merge(pollInput(keyBinds));
 	}
+	// grow the replay while nothing has to be smooth, instead of in the middle of a game
+	isReplayGrowing = view.state == GameView::State::Paused && replay.reserveAhead();
+}
 
-	Offset prevTetrominoOffset = currentTetromino;
-
-	gravity.delay =
-	    DELAYS[std::min<size_t>((::IsKeyDown(keyBinds.softDrop) ? 2 : 0) + levelState.currentLevel, MAX_SPEED_LEVEL)];
-
-	if(const KeyAction::Return moveAction = moveRight.tick(::GetFrameTime()); isKeyPress(moveAction))
-	{
-		if(playfield.overlapAt(currentTetromino.position + XY{moveAction.value, 0}, currentTetromino.collision) == 0)
-		{
-			currentTetromino.position += XY{moveAction.value, 0};
-			if(isLocking && settings.lockDown <= LockDown::Extended)
-			{
-				if(settings.lockDown == LockDown::Infinit || lockCounter < LOCKDOWN_MAX_RESET)
-				{
-					lockCounter += 1;
-					lockDelay.reset(0);
-				}
-			}
-		}
-	}
-	if(const KeyAction::Return rotateAction = rotateRight.tick(::GetFrameTime()); isKeyPress(rotateAction))
-	{
-		Offset rotation = basicRotationFunc(currentTetromino, rotateAction.value);
-		currentTetromino += rotation;
-		if(playfield.overlapAt(currentTetromino.position, currentTetromino.collision) != 0)
-		{
-			currentTetromino -= rotation;
-			rotation = wallKickFunc(playfield, currentTetromino, rotation);
-			currentTetromino += rotation;
-		}
-		if(isLocking && settings.lockDown <= LockDown::Extended && rotation != Offset{})
-		{
-			if(settings.lockDown == LockDown::Infinit || lockCounter < LOCKDOWN_MAX_RESET)
-			{
-				lockCounter += 1;
-				lockDelay.reset(0);
-			}
-		}
-	}
-	if(gravity.step(::GetFrameTime()))
-	{
-		if(playfield.overlapAt(currentTetromino.position + XY{0, 1}, currentTetromino.collision) == 0)
-		{
-			currentTetromino.position += XY{0, 1};
-			if(::IsKeyDown(keyBinds.softDrop))
-			{
-				score += scoringSystem->process(ScoreEvent::SoftDrop, 1, levelState.currentLevel);
-			}
-			if(isLocking)
-			{
-				switch(settings.lockDown)
-				{
-				case LockDown::Infinit:
-					lockDelay.reset(0);
-					break;
-				case LockDown::Extended:
-					if(lockCounter < LOCKDOWN_MAX_RESET)
-					{
-						lockCounter += 1;
-						lockDelay.reset(0);
-					}
-					break;
-				case LockDown::Classic:
-					lockDelay.reset(0);
-					break;
-				case LockDown::Entry:
-				case LockDown::Instant:
-					break;
-				}
-			}
-		}
-		else if(::IsKeyDown(keyBinds.softDrop) && settings.softDrop == SoftDrop::Locking)
-		{
-			isLocking = true;
-			lockDelay.reset(lockDelay.delay);
-		}
-	}
-	if(settings.instantDrop != InstantDrop::None && ::IsKeyPressed(keyBinds.hardDrop))
+void Game::FixedUpdate(App& app)
+{
+	if(view.state != GameView::State::Running)
 	{
-		for(int yOffset = 1;; ++yOffset)
-		{
-			if(playfield.overlapAt(currentTetromino.position + XY{0, yOffset}, currentTetromino.collision) != 0)
-			{
-				currentTetromino.position += XY{0, yOffset - 1};
-				prevTetrominoOffset = currentTetromino;
-				score += scoringSystem->process(
-				    ScoreEvent::HardDrop, static_cast<uint32_t>(yOffset - 1), levelState.currentLevel);
-				if(settings.instantDrop == InstantDrop::Hard)
-				{
-					isLocking = true;
-					lockDelay.reset(lockDelay.delay);
-				}
-				break;
-			}
-		}
+		return;
 	}
 
-	const bool onGround = playfield.overlapAt(currentTetromino.position + XY{0, 1}, currentTetromino.collision) != 0;
-
-	if(!isLocking && onGround)
+	if(!replay.canRecord())
 	{
-		isLocking = true;
-		lockDelay.reset(0);
+		isReplayGrowing = replay.reserveAhead() || isReplayGrowing;
 	}
-	if(isLocking && !onGround && settings.lockDown == LockDown::Entry)
+	replay.record(pendingInput);
+	simulation.step(Settings::TICK_SECONDS, pendingInput);
+	pendingInput.consumeEdges();
+	view.score += simulation.score - view.score.value();
+	if(simulation.isGameOver)
 	{
-		lockDelay.tick(::GetFrameTime());
+		view.state = GameView::State::GameOver;
+		view.isHighScore = app.addHighScore(view.score.value());
+		storeReplay();
 	}
-	if(isLocking && onGround && lockDelay.tick(::GetFrameTime()))
-	{
-		const ScoreEvent scoreEvent = tSpinFunc(playfield, currentTetromino, currentTetromino - prevTetrominoOffset);
-
-		playfield.setAt(currentTetromino.position, currentTetromino.collision);
-
-		const uint32_t linesCleared = eraseFullLines(playfield);
-		score += scoringSystem->process(scoreEvent, linesCleared, levelState.currentLevel);
-		levelState = levelUpFunc(scoreEvent, linesCleared, levelState);
-		if(isEmpty(playfield))
-		{
-			score += scoringSystem->process(ScoreEvent::PerfectClear, linesCleared, levelState.currentLevel);
-		}
+}
 
-		isLocking = false;
-		holdPieceLocked = false;
-		lockCounter = 0;
-		currentTetromino = getNextTetromino(settings.previewCount);
-		if(playfield.overlapAt(currentTetromino.position, currentTetromino.collision) != 0)
-		{
-			state = State::GameOver;
-			isHighScore = app.addHighScore(score.value());
-		}
-	}
+void Game::Draw([[maybe_unused]] App& app)
+{
+	view.draw(simulation);
 }
 
-void Game::Draw(App& app)
+void GameView::draw(const Simulation& simulation) const
 {
 	::ClearBackground(LIGHTGRAY);
 
@@ -340,49 +242,49 @@ void Game::Draw(App& app)
 	    static_cast<float>(playfieldBounds.y - FIELD_BORDER_WIDTH),
 	    static_cast<float>(playfieldBounds.width + (FIELD_BORDER_WIDTH * 2) - 1),
 	    static_cast<float>(playfieldBounds.height + (FIELD_BORDER_WIDTH * 2) - 1));
+	const Grid& playfield = simulation.playfield;
+	const Tetromino& currentTetromino = simulation.currentTetromino;
+	const std::vector<Tetromino>& baseTetrominos = simulation.baseTetrominos;
+	const size_t holdPieceIdx = simulation.holdPieceIdx;
+	const IndexQueue& nextTetrominoIndices = simulation.nextTetrominoIndices;
 	const int cellSize = (playfieldBounds.width / playfield.getSize().width) - 1;
 	const XY hiddenOffset{0, (cellSize + 1) * HIDDEN_HEIGHT};
 	drawBackground(playfield, playfieldBounds - hiddenOffset, cellSize, 1, LIGHTGRAY, DARKGRAY);
 	drawCells(playfield, playfieldBounds - hiddenOffset, cellSize, 1, minoColors);
 
-	const App::Settings& settings = app.settings();
+	const App::Settings& settings = simulation.settings;
 
 	if(settings.ghostPiece)
 	{
-		int yOffset = 1;
-		while(playfield.overlapAt(currentTetromino.position + XY{0, yOffset}, currentTetromino.collision) == 0)
-		{
-			++yOffset;
-		}
-		--yOffset;
+		const int yOffset = playfield.dropDistance(currentTetromino.position, currentTetromino.collision());
 
-		drawCells(currentTetromino.collision,
+		drawCells(currentTetromino.collision(),
 		    ((currentTetromino.position - XY{0, HIDDEN_HEIGHT - yOffset}) * (cellSize + 1)) + playfieldBounds, cellSize,
 		    1, minoColors, 96);
 	}
 
-	drawCells(currentTetromino.collision,
+	drawCells(currentTetromino.collision(),
 	    ((currentTetromino.position - XY{0, HIDDEN_HEIGHT}) * (cellSize + 1)) + playfieldBounds, cellSize, 1,
 	    minoColors);
 
 	::DrawRectangle(playfieldBounds.x, 0, playfieldBounds.width, static_cast<int>(playfieldBorderBounds.y), LIGHTGRAY);
 	::DrawRectangleLinesEx(playfieldBorderBounds, FIELD_BORDER_WIDTH, DARKGRAY);
 
-	if(holdPieceIdx != NO_HOLD_PIECE)
+	if(holdPieceIdx != Simulation::NO_HOLD_PIECE)
 	{
-		drawCells(
-		    baseTetrominos[holdPieceIdx].collision, previewOffsetsMain[holdPieceIdx], PREVIEW_CELL_SIZE, 1, minoColors);
+		drawCells(baseTetrominos[holdPieceIdx].collision(), previewOffsetsMain[holdPieceIdx], PREVIEW_CELL_SIZE, 1,
+		    minoColors);
 	}
 
 	if(settings.previewCount > 0)
 	{
-		drawCells(baseTetrominos[nextTetrominoIndices[0]].collision,
+		drawCells(baseTetrominos[nextTetrominoIndices[0]].collision(),
 		    previewOffsetsMain[nextTetrominoIndices[0]] + XY{App::Settings::SCREEN_WIDTH - SIDEBAR_WIDTH, 0},
 		    PREVIEW_CELL_SIZE, 1, minoColors);
 
 		for(uint8_t i = 1; i < settings.previewCount; ++i)
 		{
-			drawCells(baseTetrominos[nextTetrominoIndices[i]].collision,
+			drawCells(baseTetrominos[nextTetrominoIndices[i]].collision(),
 			    previewOffsetsExtended[nextTetrominoIndices[i]] +
 			        XY{0, ((i - 1) * previewElementHeightExtended) + PREVIEW_ELEMENT_HEIGHT},
 			    cellSizeExtended(), 1, minoColors);
@@ -419,70 +321,34 @@ void Game::Draw(App& app)
 	}
 }
 
-size_t hashSeedString(const TextBuffer<20>& buffer)
+Game::Game(App& app) :
+    replay{hashSeedString(app.seed), app.settings()},
+    simulation{replay.info().settings, replay.info().seed, makePieceColors()},
+    view{simulation},
+    pendingInput{},
+    isReplayStored{false},
+    isReplayGrowing{false}
 {
-	if(!buffer.empty())
-	{
-		return std::hash<std::string_view>{}(buffer);
-	}
-	return std::hash<std::random_device::result_type>{}(std::random_device{}());
 }
 
-Game::Game(App& app) :
-    playfield{{app.settings().fieldWidth, app.settings().fieldHeight + HIDDEN_HEIGHT}, 0},
-    playfieldBounds{calculatePlayfieldBounds({app.settings().fieldWidth, app.settings().fieldHeight})},
-    baseTetrominos{prepareTetrominos(makeBaseMinos(app.settings().rotationSystem)(), playfield.getSize().width)},
-    previewOffsetsMain{calcCenterOffsets(baseTetrominos, {SIDEBAR_WIDTH, PREVIEW_ELEMENT_HEIGHT}, PREVIEW_CELL_SIZE)},
-    holdPieceIdx{NO_HOLD_PIECE},
-    rng{hashSeedString(app.seed)},
-    shuffledIndicesFunc{makeShuffledIndices(app.settings().shuffleType)(baseTetrominos)},
-    nextTetrominoIndices{fillIndices(app.settings().previewCount)},
+GameView::GameView(const Simulation& simulation) :
+    playfieldBounds{calculatePlayfieldBounds({simulation.settings.fieldWidth, simulation.settings.fieldHeight})},
+    previewOffsetsMain{
+        calcCenterOffsets(simulation.baseTetrominos, {SIDEBAR_WIDTH, PREVIEW_ELEMENT_HEIGHT}, PREVIEW_CELL_SIZE)},
     previewElementHeightExtended{
-        app.settings().previewCount < 2
+        simulation.settings.previewCount < 2
             ? 0
-            : (App::Settings::SCREEN_HEIGHT - PREVIEW_ELEMENT_HEIGHT) / (app.settings().previewCount - 1)},
-    previewOffsetsExtended{
-        calcCenterOffsetsExtended(baseTetrominos, {SIDEBAR_WIDTH, previewElementHeightExtended}, cellSizeExtended())},
-    currentTetromino{getNextTetromino(app.settings().previewCount)},
-    scoringSystem{makeScoringSystem(app.settings().scoringSystem)()},
+            : (App::Settings::SCREEN_HEIGHT - PREVIEW_ELEMENT_HEIGHT) / (simulation.settings.previewCount - 1)},
+    previewOffsetsExtended{calcCenterOffsetsExtended(
+        simulation.baseTetrominos, {SIDEBAR_WIDTH, previewElementHeightExtended}, cellSizeExtended())},
     score{0},
     state{State::Running},
-    levelUpFunc{levelUp(app.settings().levelGoal)},
-    levelState{LevelState::make(app.settings().levelGoal)},
-    lockDelay{app.settings().lockDown == LockDown::Instant ? 0 : App::Settings::LOCK_DELAY},
-    lockCounter{0},
-    isLocking{false},
-    holdPieceLocked{false},
-    isHighScore{false},
-    tSpinFunc{tSpinCheck(app.settings().tSpin)},
-    gravity{DELAYS.front()},
-    moveRight{App::Settings::DELAYED_AUTO_SHIFT, App::Settings::AUTO_REPEAT_RATE, app.keyBinds().moveRight,
-        app.keyBinds().moveLeft},
-    basicRotationFunc{basicRotation(app.settings().rotationSystem)},
-    wallKickFunc{wallKick(app.settings().wallKicks)},
-    rotateRight{App::Settings::DELAYED_AUTO_SHIFT, App::Settings::AUTO_REPEAT_RATE, app.keyBinds().rotateRight,
-        app.keyBinds().rotateLeft}
-{
-}
-
-std::deque<size_t> Game::fillIndices(size_t minIndices)
+    isHighScore{false}
 {
-	std::deque<size_t> indices;
-	shuffledIndicesFunc->fill(indices, minIndices, rng);
-	return indices;
 }
 
-int Game::cellSizeExtended() const noexcept
+int GameView::cellSizeExtended() const noexcept
 {
 	return std::min(previewElementHeightExtended / 5, PREVIEW_CELL_SIZE);
 }
-
-Tetromino Game::getNextTetromino(size_t minIndices)
-{
-	minIndices = minIndices == 0 ? 1 : minIndices;
-	const size_t nextIdx = nextTetrominoIndices.front();
-	nextTetrominoIndices.pop_front();
-	shuffledIndicesFunc->fill(nextTetrominoIndices, minIndices, rng);
-	return baseTetrominos[nextIdx];
-}
 } // namespace raymino
@@ -1,16 +1,14 @@
 #include "gameplay.hpp"
 
+#include "smallgrid.hpp"
 #include "types.hpp"
 
 #include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <iterator>
 #include <limits>
-#include <memory>
-#include <numeric>
 #include <random>
 #include <stdexcept>
 #include <vector>
@@ -22,6 +20,14 @@ uint32_t clampMax(uint32_t in, uint32_t max)
 	return in > max ? max : in;
 }
 
+/**
+ * @brief makes rotation state of mino its new rotation 0
+ */
+void rebaseRotation(Tetromino& mino, int rotation)
+{
+	mino = Tetromino{{mino.position, 0}, mino.type, mino.collision(rotation)};
+}
+
 template<>
 std::vector<Tetromino> makeBaseMinos<RotationSystem::Super>()
 {
@@ -37,18 +43,18 @@ template<>
 std::vector<Tetromino> makeBaseMinos<RotationSystem::Original>()
 {
 	std::vector<Tetromino> tetrominos = makeBaseMinos<RotationSystem::Super>();
-	find(tetrominos, TetrominoType::J)->collision.rotate(2);
-	find(tetrominos, TetrominoType::L)->collision.rotate(2);
-	find(tetrominos, TetrominoType::S)->collision.rotate(2);
-	find(tetrominos, TetrominoType::T)->collision.rotate(2);
-	find(tetrominos, TetrominoType::Z)->collision.rotate(2);
+	rebaseRotation(*find(tetrominos, TetrominoType::J), 2);
+	rebaseRotation(*find(tetrominos, TetrominoType::L), 2);
+	rebaseRotation(*find(tetrominos, TetrominoType::S), 2);
+	rebaseRotation(*find(tetrominos, TetrominoType::T), 2);
+	rebaseRotation(*find(tetrominos, TetrominoType::Z), 2);
 	return tetrominos;
 }
 template<>
 std::vector<Tetromino> makeBaseMinos<RotationSystem::NintendoLeft>()
 {
 	std::vector<Tetromino> tetrominos = makeBaseMinos<RotationSystem::Original>();
-	find(tetrominos, TetrominoType::I)->collision.rotate(2);
+	rebaseRotation(*find(tetrominos, TetrominoType::I), 2);
 	return tetrominos;
 }
 template<>
@@ -220,7 +226,8 @@ Offset (*basicRotation(RotationSystem tsys))(const Tetromino&, int)
 	throw std::runtime_error{"Invalid RotationSystem value"};
 }
 
-Rect findTrueSize(const Grid& grid) noexcept
+template<typename TGrid>
+Rect findTrueSizeImpl(const TGrid& grid) noexcept
 {
 	Rect trueSize{{grid.getSize().width, grid.getSize().height}, {0, 0}};
 
@@ -246,9 +253,19 @@ Rect findTrueSize(const Grid& grid) noexcept
 	return trueSize;
 }
 
+Rect findTrueSize(const Grid& grid) noexcept
+{
+	return findTrueSizeImpl(grid);
+}
+
+Rect findTrueSize(const PieceGrid& grid) noexcept
+{
+	return findTrueSizeImpl(grid);
+}
+
 XY spawnPosition(const Tetromino& tetromino, int highestUsedRow, int totalWidth) noexcept
 {
-	const Rect trueSize = findTrueSize(tetromino.collision);
+	const Rect trueSize = findTrueSize(tetromino.collision());
 	const int leftOffset = ((totalWidth - trueSize.width) / 2) - trueSize.x;
 	const int topOffset = highestUsedRow - trueSize.y;
 	return {leftOffset, topOffset};
@@ -257,7 +274,8 @@ XY spawnPosition(const Tetromino& tetromino, int highestUsedRow, int totalWidth)
 template<>
 Offset wallKick<WallKicks::Arika>(const Grid& field, const Tetromino& tetromino, Offset offset) noexcept
 {
-	const Tetromino desiredPosition{Tetromino{tetromino} += offset};
+	const Offset desiredPosition = tetromino + offset;
+	const PieceGrid& desiredCollision = tetromino.collision(desiredPosition.rotation);
 	const XY right{1, 0};
 	const XY left{-1, 0};
 	const XY up{0, -1};
@@ -267,7 +285,7 @@ Offset wallKick<WallKicks::Arika>(const Grid& field, const Tetromino& tetromino,
 	{
 	case TetrominoType::T:
 		if(desiredPosition.rotation % 4 == 2 &&
-		    field.overlapAt(desiredPosition.position + up, desiredPosition.collision) == 0)
+		    field.overlapAt(desiredPosition.position + up, desiredCollision) == 0)
 		{
 			return {{offset.position + up}, offset.rotation};
 		}
@@ -277,7 +295,7 @@ Offset wallKick<WallKicks::Arika>(const Grid& field, const Tetromino& tetromino,
 	case TetrominoType::J:
 		if(desiredPosition.rotation % 2 == 0)
 		{
-			const size_t overlapIdx = field.overlapAt(desiredPosition.position, desiredPosition.collision);
+			const size_t overlapIdx = field.overlapAt(desiredPosition.position, desiredCollision);
 			if(overlapIdx == 2 || overlapIdx == 5 || overlapIdx == 8)
 			{
 				return {};
@@ -287,43 +305,43 @@ Offset wallKick<WallKicks::Arika>(const Grid& field, const Tetromino& tetromino,
 	case TetrominoType::Z:
 		[[fallthrough]];
 	case TetrominoType::S:
-		if(field.overlapAt(desiredPosition.position + right, desiredPosition.collision) == 0)
+		if(field.overlapAt(desiredPosition.position + right, desiredCollision) == 0)
 		{
 			return {{offset.position + right}, offset.rotation};
 		}
-		if(field.overlapAt(desiredPosition.position + left, desiredPosition.collision) == 0)
+		if(field.overlapAt(desiredPosition.position + left, desiredCollision) == 0)
 		{
 			return {{offset.position + left}, offset.rotation};
 		}
 		break;
 	case TetrominoType::I:
-		if(field.overlapAt(tetromino.position + up, tetromino.collision) != 0 ||
-		    field.overlapAt(tetromino.position + down, tetromino.collision) != 0 ||
-		    field.overlapAt(tetromino.position + left, tetromino.collision) != 0 ||
-		    field.overlapAt(tetromino.position + right, tetromino.collision) != 0)
+		if(field.overlapAt(tetromino.position + up, tetromino.collision()) != 0 ||
+		    field.overlapAt(tetromino.position + down, tetromino.collision()) != 0 ||
+		    field.overlapAt(tetromino.position + left, tetromino.collision()) != 0 ||
+		    field.overlapAt(tetromino.position + right, tetromino.collision()) != 0)
 		{
 			if(desiredPosition.rotation % 2 == 0)
 			{
-				if(field.overlapAt(desiredPosition.position + right, desiredPosition.collision) == 0)
+				if(field.overlapAt(desiredPosition.position + right, desiredCollision) == 0)
 				{
 					return {{offset.position + right}, offset.rotation};
 				}
-				if(field.overlapAt(desiredPosition.position + right + right, desiredPosition.collision) == 0)
+				if(field.overlapAt(desiredPosition.position + right + right, desiredCollision) == 0)
 				{
 					return {{offset.position + right + right}, offset.rotation};
 				}
-				if(field.overlapAt(desiredPosition.position + left, desiredPosition.collision) == 0)
+				if(field.overlapAt(desiredPosition.position + left, desiredCollision) == 0)
 				{
 					return {{offset.position + left}, offset.rotation};
 				}
 			}
 			else
 			{
-				if(field.overlapAt(desiredPosition.position + up, desiredPosition.collision) == 0)
+				if(field.overlapAt(desiredPosition.position + up, desiredCollision) == 0)
 				{
 					return {{offset.position + up}, offset.rotation};
 				}
-				if(field.overlapAt(desiredPosition.position + up + up, desiredPosition.collision) == 0)
+				if(field.overlapAt(desiredPosition.position + up + up, desiredCollision) == 0)
 				{
 					return {{offset.position + up + up}, offset.rotation};
 				}
@@ -367,7 +385,8 @@ Offset wallKick<WallKicks::Super>(const Grid& field, const Tetromino& tetromino,
 		return {};
 	}
 
-	const Tetromino desiredPosition{Tetromino{tetromino} += offset};
+	const Offset desiredPosition = tetromino + offset;
+	const PieceGrid& desiredCollision = tetromino.collision(desiredPosition.rotation);
 	const KickTable& kickTable = tetromino.type == TetrominoType::I ? kicksI : kicksJLSTZ;
 	const size_t kickIdx = ((static_cast<size_t>(tetromino.rotation) & size_t{0b11}) * size_t{2}) +
 	                       static_cast<size_t>(offset.rotation > 0);
@@ -375,7 +394,7 @@ Offset wallKick<WallKicks::Super>(const Grid& field, const Tetromino& tetromino,
 
 	for(const XY kick : kickRow)
 	{
-		if(field.overlapAt(desiredPosition.position + kick, desiredPosition.collision) == 0)
+		if(field.overlapAt(desiredPosition.position + kick, desiredCollision) == 0)
 		{
 			return {kick, offset.rotation};
 		}
@@ -405,72 +424,44 @@ Offset (*wallKick(WallKicks tsys) noexcept)(const Grid& field, const Tetromino&
 
 uint32_t eraseFullLines(Grid& grid) noexcept
 {
-	const auto gridWidth = grid.getSize().width;
-	const auto isFullLine = [](auto begin, auto end)
-	{
-		return std::all_of(begin, end,
-		    [](auto cell)
-		    {
-			    return cell != 0;
-		    });
-	};
-
-	uint32_t erasedLines = 0;
-
-	if(grid.getSize().area() == 0)
-	{
-		return erasedLines;
-	}
-
-	const auto linesEnd = grid.rend();
-	auto linesReadBegin = grid.rbegin();
+	return grid.eraseFullRows();
+}
 
-	while(linesReadBegin != linesEnd && !isFullLine(linesReadBegin, std::next(linesReadBegin, gridWidth)))
-	{
-		std::advance(linesReadBegin, gridWidth);
-	}
+size_t countFullLines(const Grid& grid, const Tetromino& tetromino) noexcept
+{
+	size_t fullLines = 0;
+	const auto gridSize = grid.getSize();
 
-	auto linesWriteBegin = linesReadBegin;
-	if(linesReadBegin != linesEnd)
+	if(grid.hasRowBits() && tetromino.collision().hasRowBits())
 	{
-		std::advance(linesReadBegin, gridWidth);
-		++erasedLines;
+		const Grid::RowBits fullRow = grid.fullRowBits();
+		for(int yPos = 0; yPos < gridSize.height; ++yPos)
+		{
+			const Grid::RowBits row =
+			    grid.getRowBits(yPos) | grid.placedRowBits(tetromino.position, tetromino.collision(), yPos);
+			fullLines += static_cast<size_t>(row == fullRow);
+		}
+		return fullLines;
 	}
 
-	while(linesReadBegin != linesEnd)
+	const int pieceTop = tetromino.position.y;
+	const int pieceBottom = pieceTop + tetromino.collision().getSize().height;
+	for(int yPos = 0; yPos < gridSize.height; ++yPos)
 	{
-		if(!isFullLine(linesReadBegin, std::next(linesReadBegin, gridWidth)))
+		if(grid.isRowFull(yPos))
 		{
-			std::copy(linesReadBegin, std::next(linesReadBegin, gridWidth), linesWriteBegin);
-			std::advance(linesWriteBegin, gridWidth);
+			++fullLines;
+			continue;
 		}
-		else
+		if(yPos < pieceTop || yPos >= pieceBottom)
 		{
-			++erasedLines;
+			continue;
 		}
-		std::advance(linesReadBegin, gridWidth);
-	}
-
-	while(linesWriteBegin != linesEnd)
-	{
-		std::fill(linesWriteBegin, std::next(linesWriteBegin, gridWidth), Grid::Cell{0});
-		std::advance(linesWriteBegin, gridWidth);
-	}
-
-	return erasedLines;
-}
-
-size_t countFullLines(const Grid& grid, const Tetromino& tetromino) noexcept
-{
-	size_t fullLines = 0;
-	const auto gridSize = grid.getSize();
-
-	for(int yPos = 0; yPos < gridSize.height; ++yPos)
-	{
 		bool isFullLine = true;
 		for(int xPos = 0; xPos < gridSize.width; ++xPos)
 		{
-			if(grid.getAt({xPos, yPos}) == 0 && tetromino.collision.getAt(XY{xPos, yPos} - tetromino.position, 0) == 0)
+			if(grid.getAt({xPos, yPos}) == 0 &&
+			    tetromino.collision().getAt(XY{xPos, yPos} - tetromino.position, 0) == 0)
 			{
 				isFullLine = false;
 				break;
@@ -484,19 +475,15 @@ size_t countFullLines(const Grid& grid, const Tetromino& tetromino) noexcept
 
 bool isEmpty(const Grid& grid) noexcept
 {
-	return std::all_of(grid.begin(), grid.end(),
-	    [](Grid::Cell cell)
-	    {
-		    return cell == 0;
-	    });
+	return grid.isEmpty();
 }
 
 TSpinCornerCountResult tSpinCornerCount(const Grid& field, const Tetromino& tetromino) noexcept
 {
 	static constexpr std::array<XY, 4> checkOffsets{{{0, 0}, {2, 0}, {0, 2}, {2, 2}}};
-	const Rect trueSize = findTrueSize(tetromino.collision);
+	const Rect trueSize = findTrueSize(tetromino.collision());
 	const bool horizontal = trueSize.width == 3;
-	const bool topLeft = tetromino.collision.getAt({trueSize.x, trueSize.y}) == 0;
+	const bool topLeft = tetromino.collision().getAt({trueSize.x, trueSize.y}) == 0;
 	XY trueOffset = tetromino.position + static_cast<const XY&>(trueSize);
 	const auto getAt = [&](XY checkOffset)
 	{
@@ -526,7 +513,7 @@ bool isImmobile(const Grid& field, const Tetromino& tetromino) noexcept
 	return std::none_of(directions.begin(), directions.end(),
 	    [&](const XY dir)
 	    {
-		    return field.overlapAt(tetromino.position + dir, tetromino.collision) == 0;
+		    return field.overlapAt(tetromino.position + dir, tetromino.collision()) == 0;
 	    });
 }
 
@@ -602,225 +589,238 @@ ScoreEvent (*tSpinCheck(TSpin tspin) noexcept)(const Grid& field, const Tetromin
 	}
 }
 
-struct BPS : public IScoringSystem
+uint32_t attackLines(ScoreEvent event, uint32_t lines) noexcept
 {
-	int64_t process(ScoreEvent event, uint32_t lines, [[maybe_unused]] uint32_t level) noexcept override
+	switch(event)
 	{
-		switch(event)
-		{
-		case ScoreEvent::LineClear:
-		case ScoreEvent::MiniTSpin:
-		case ScoreEvent::TSpin:
-		{
-			lines = clampMax(lines, 4);
-			static constexpr std::array<int64_t, 5> scores{0, 40, 100, 300, 1200};
-			return scores[lines];
-		}
-		case ScoreEvent::PerfectClear:
-		case ScoreEvent::SoftDrop:
-		case ScoreEvent::HardDrop:
-		default:
-			return 0;
-		}
+	case ScoreEvent::LineClear:
+	{
+		static constexpr std::array<uint32_t, 5> attacks{0, 0, 1, 2, 4};
+		return attacks[clampMax(lines, 4)];
+	}
+	case ScoreEvent::MiniTSpin:
+		return clampMax(lines, 2) / 2;
+	case ScoreEvent::TSpin:
+		return clampMax(lines, 3) * 2;
+	case ScoreEvent::PerfectClear:
+		return 10;
+	case ScoreEvent::SoftDrop:
+	case ScoreEvent::HardDrop:
+	default:
+		return 0;
 	}
-};
-template<>
-std::unique_ptr<IScoringSystem> makeScoringSystem<ScoringSystem::BPS>()
-{
-	return std::make_unique<BPS>();
 }
 
-struct Sega : public IScoringSystem
+namespace scoring
+{
+int64_t BPS::process(ScoreEvent event, uint32_t lines, [[maybe_unused]] uint32_t level) const noexcept
 {
-	int64_t process(ScoreEvent event, uint32_t lines, uint32_t level) noexcept override
+	switch(event)
 	{
-		level = std::clamp<uint32_t>((level + 1) / 2, 1, 5);
-		switch(event)
-		{
-		case ScoreEvent::LineClear:
-		case ScoreEvent::MiniTSpin:
-		case ScoreEvent::TSpin:
-		{
-			lines = clampMax(lines, 4);
-			static constexpr std::array<int64_t, 5> scores{0, 100, 400, 900, 2000};
-			return scores[lines] * level;
-		}
-		case ScoreEvent::SoftDrop:
-		{
-			return static_cast<int64_t>(lines) * level;
-		}
-		case ScoreEvent::PerfectClear:
-		case ScoreEvent::HardDrop:
-		default:
-			return 0;
-		}
+	case ScoreEvent::LineClear:
+	case ScoreEvent::MiniTSpin:
+	case ScoreEvent::TSpin:
+	{
+		lines = clampMax(lines, 4);
+		static constexpr std::array<int64_t, 5> scores{0, 40, 100, 300, 1200};
+		return scores[lines];
+	}
+	case ScoreEvent::PerfectClear:
+	case ScoreEvent::SoftDrop:
+	case ScoreEvent::HardDrop:
+	default:
+		return 0;
 	}
-};
-template<>
-std::unique_ptr<IScoringSystem> makeScoringSystem<ScoringSystem::Sega>()
-{
-	return std::make_unique<Sega>();
 }
 
-struct Nintendo : public IScoringSystem
+int64_t Sega::process(ScoreEvent event, uint32_t lines, uint32_t level) const noexcept
 {
-	int64_t process(ScoreEvent event, uint32_t lines, uint32_t level) noexcept override
+	level = std::clamp<uint32_t>((level + 1) / 2, 1, 5);
+	switch(event)
 	{
-		switch(event)
-		{
-		case ScoreEvent::LineClear:
-		case ScoreEvent::MiniTSpin:
-		case ScoreEvent::TSpin:
-		{
-			lines = clampMax(lines, 4);
-			static constexpr std::array<int64_t, 5> scores{0, 40, 100, 300, 1200};
-			return scores[lines] * level;
-		}
-		case ScoreEvent::PerfectClear:
-		case ScoreEvent::SoftDrop:
-		case ScoreEvent::HardDrop:
-		default:
-			return 0;
-		}
+	case ScoreEvent::LineClear:
+	case ScoreEvent::MiniTSpin:
+	case ScoreEvent::TSpin:
+	{
+		lines = clampMax(lines, 4);
+		static constexpr std::array<int64_t, 5> scores{0, 100, 400, 900, 2000};
+		return scores[lines] * level;
+	}
+	case ScoreEvent::SoftDrop:
+	{
+		return static_cast<int64_t>(lines) * level;
+	}
+	case ScoreEvent::PerfectClear:
+	case ScoreEvent::HardDrop:
+	default:
+		return 0;
 	}
-};
-template<>
-std::unique_ptr<IScoringSystem> makeScoringSystem<ScoringSystem::Nintendo>()
-{
-	return std::make_unique<Nintendo>();
 }
 
-struct Guideline : public IScoringSystem
+int64_t Nintendo::process(ScoreEvent event, uint32_t lines, uint32_t level) const noexcept
 {
-	struct Action
+	switch(event)
 	{
-		enum : uint8_t
-		{
-			NoLines = 0,
-			Single,
-			Double,
-			Triple,
-			Tetris,
-			MiniNoLines,
-			MiniSingle,
-			MiniDouble,
-			SpinNoLines,
-			SpinSingle,
-			SpinDouble,
-			SpinTriple,
-			Combo,
-			Soft,
-			Hard,
-			PerfectNoLines,
-			PerfectSingle,
-			PerfectDouble,
-			PerfectTriple,
-			PerfectTetris,
-			PerfectTetrisChain,
+	case ScoreEvent::LineClear:
+	case ScoreEvent::MiniTSpin:
+	case ScoreEvent::TSpin:
+	{
+		lines = clampMax(lines, 4);
+		static constexpr std::array<int64_t, 5> scores{0, 40, 100, 300, 1200};
+		return scores[lines] * level;
+	}
+	case ScoreEvent::PerfectClear:
+	case ScoreEvent::SoftDrop:
+	case ScoreEvent::HardDrop:
+	default:
+		return 0;
+	}
+}
 
-			COUNT
-		};
-		int64_t points;
-		bool isDifficult;
+namespace
+{
+struct Action
+{
+	enum : uint8_t
+	{
+		NoLines = 0,
+		Single,
+		Double,
+		Triple,
+		Tetris,
+		MiniNoLines,
+		MiniSingle,
+		MiniDouble,
+		SpinNoLines,
+		SpinSingle,
+		SpinDouble,
+		SpinTriple,
+		Combo,
+		Soft,
+		Hard,
+		PerfectNoLines,
+		PerfectSingle,
+		PerfectDouble,
+		PerfectTriple,
+		PerfectTetris,
+		PerfectTetrisChain,
+		COUNT
 	};
-	static constexpr std::array<Action, Action::COUNT> actions{{//
-	    /*NoLines*/ {0, false},
-	    /*Single*/ {100, false},
-	    /*Double*/ {300, false},
-	    /*Triple*/ {500, false},
-	    /*Tetris*/ {800, true},
-	    /*MiniNoLines*/ {100, false},
-	    /*MiniSingle*/ {200, true},
-	    /*MiniDouble*/ {400, true},
-	    /*SpinNoLines*/ {400, false},
-	    /*SpinSingle*/ {800, true},
-	    /*SpinDouble*/ {1200, true},
-	    /*SpinTriple*/ {1600, true},
-	    /*Combo*/ {50, false},
-	    /*Soft*/ {1, false},
-	    /*Hard*/ {2, false},
-	    /*PerfectNoLines*/ {0, false},
-	    /*PerfectSingle*/ {800, false},
-	    /*PerfectDouble*/ {1200, false},
-	    /*PerfectTriple*/ {1800, false},
-	    /*PerfectTetris*/ {2000, false},
-	    /*PerfectTetrisChain*/ {3200, false}}};
-	bool wasLastEventDifficult = false;
-	uint32_t lastPerfectClearLines = 0;
-	int clearCounter = 0;
-	int combo = -1;
-	int64_t process(ScoreEvent event, uint32_t lines, uint32_t level) noexcept override
+	int64_t points;
+	bool isDifficult;
+};
+constexpr std::array<Action, Action::COUNT> actions{{//
+    /*NoLines*/ {0, false},
+    /*Single*/ {100, false},
+    /*Double*/ {300, false},
+    /*Triple*/ {500, false},
+    /*Tetris*/ {800, true},
+    /*MiniNoLines*/ {100, false},
+    /*MiniSingle*/ {200, true},
+    /*MiniDouble*/ {400, true},
+    /*SpinNoLines*/ {400, false},
+    /*SpinSingle*/ {800, true},
+    /*SpinDouble*/ {1200, true},
+    /*SpinTriple*/ {1600, true},
+    /*Combo*/ {50, false},
+    /*Soft*/ {1, false},
+    /*Hard*/ {2, false},
+    /*PerfectNoLines*/ {0, false},
+    /*PerfectSingle*/ {800, false},
+    /*PerfectDouble*/ {1200, false},
+    /*PerfectTriple*/ {1800, false},
+    /*PerfectTetris*/ {2000, false},
+    /*PerfectTetrisChain*/ {3200, false}}};
+} // namespace
+
+int64_t Guideline::process(ScoreEvent event, uint32_t lines, uint32_t level) noexcept
+{
+	int64_t score = 0;
+	bool isThisEventDifficult = false;
+	switch(event)
 	{
-		int64_t score = 0;
-		bool isThisEventDifficult = false;
-		switch(event)
-		{
-		case ScoreEvent::LineClear:
-		{
-			lines = clampMax(lines, 4);
-			score = actions[Action::NoLines + lines].points * level;
-			isThisEventDifficult = actions[Action::NoLines + lines].isDifficult;
-			break;
-		}
-		case ScoreEvent::MiniTSpin:
-		{
-			lines = clampMax(lines, 2);
-			score = actions[Action::MiniNoLines + lines].points * level;
-			isThisEventDifficult = actions[Action::MiniNoLines + lines].isDifficult;
-			break;
-		}
-		case ScoreEvent::TSpin:
-		{
-			lines = clampMax(lines, 3);
-			score = actions[Action::SpinNoLines + lines].points * level;
-			isThisEventDifficult = true;
-			break;
-		}
-		case ScoreEvent::PerfectClear:
-		{
-			lines = clampMax(lines, 4);
-			if(lines == 4 && lastPerfectClearLines == 4 && clearCounter < 2)
-			{
-				return actions[Action::PerfectTetrisChain].points * level;
-			}
-			clearCounter = 0;
-			lastPerfectClearLines = lines;
-			return actions[Action::PerfectNoLines + lines].points * level;
-		}
-		case ScoreEvent::SoftDrop:
-			return actions[Action::Soft].points * level;
-		case ScoreEvent::HardDrop:
-			return actions[Action::Hard].points * level * lines;
-		default:
-			return 0;
-		}
-		if(lines > 0)
-		{
-			clearCounter += 1;
-			combo += 1;
-			score += actions[Action::Combo].points * combo * level;
-		}
-		else
-		{
-			combo = -1;
-		}
-		if(wasLastEventDifficult && isThisEventDifficult)
-		{
-			score += score / 2; // * 1.5
-		}
-		else
+	case ScoreEvent::LineClear:
+	{
+		lines = clampMax(lines, 4);
+		score = actions[Action::NoLines + lines].points * level;
+		isThisEventDifficult = actions[Action::NoLines + lines].isDifficult;
+		break;
+	}
+	case ScoreEvent::MiniTSpin:
+	{
+		lines = clampMax(lines, 2);
+		score = actions[Action::MiniNoLines + lines].points * level;
+		isThisEventDifficult = actions[Action::MiniNoLines + lines].isDifficult;
+		break;
+	}
+	case ScoreEvent::TSpin:
+	{
+		lines = clampMax(lines, 3);
+		score = actions[Action::SpinNoLines + lines].points * level;
+		isThisEventDifficult = true;
+		break;
+	}
+	case ScoreEvent::PerfectClear:
+	{
+		lines = clampMax(lines, 4);
+		if(lines == 4 && lastPerfectClearLines == 4 && clearCounter < 2)
 		{
-			wasLastEventDifficult = isThisEventDifficult;
+			return actions[Action::PerfectTetrisChain].points * level;
 		}
-		return score;
+		clearCounter = 0;
+		lastPerfectClearLines = lines;
+		return actions[Action::PerfectNoLines + lines].points * level;
 	}
-};
+	case ScoreEvent::SoftDrop:
+		return actions[Action::Soft].points * level;
+	case ScoreEvent::HardDrop:
+		return actions[Action::Hard].points * level * lines;
+	default:
+		return 0;
+	}
+	if(lines > 0)
+	{
+		clearCounter += 1;
+		combo += 1;
+		score += actions[Action::Combo].points * combo * level;
+	}
+	else
+	{
+		combo = -1;
+	}
+	if(wasLastEventDifficult && isThisEventDifficult)
+	{
+		score += score / 2; // * 1.5
+	}
+	else
+	{
+		wasLastEventDifficult = isThisEventDifficult;
+	}
+	return score;
+}
+} // namespace scoring
+
+template<>
+AnyScoringSystem makeScoringSystem<ScoringSystem::BPS>()
+{
+	return AnyScoringSystem{scoring::BPS{}};
+}
+template<>
+AnyScoringSystem makeScoringSystem<ScoringSystem::Sega>()
+{
+	return AnyScoringSystem{scoring::Sega{}};
+}
+template<>
+AnyScoringSystem makeScoringSystem<ScoringSystem::Nintendo>()
+{
+	return AnyScoringSystem{scoring::Nintendo{}};
+}
 template<>
-std::unique_ptr<IScoringSystem> makeScoringSystem<ScoringSystem::Guideline>()
+AnyScoringSystem makeScoringSystem<ScoringSystem::Guideline>()
 {
-	return std::make_unique<Guideline>();
+	return AnyScoringSystem{scoring::Guideline{}};
 }
-std::unique_ptr<IScoringSystem> (*makeScoringSystem(ScoringSystem tsys))()
+AnyScoringSystem (*makeScoringSystem(ScoringSystem tsys))()
 {
 	switch(tsys)
 	{
@@ -836,195 +836,200 @@ std::unique_ptr<IScoringSystem> (*makeScoringSystem(ScoringSystem tsys))()
 	throw std::runtime_error{"Invalid ScoringSystem value"};
 }
 
-struct Random : IShuffledIndices
+namespace shuffling
 {
-	size_t indexCount;
-	explicit Random(size_t indexCount) : indexCount{indexCount}
+void Random::fill(IndexQueue& indices, size_t minIndices, std::mt19937_64& rng) const
+{
+	std::uniform_int_distribution<size_t> dist(0, indexCount - 1);
+	while(indices.size() < minIndices)
 	{
+		indices.push_back(dist(rng));
 	}
-	void fill(std::deque<size_t>& indices, size_t minIndices, std::mt19937_64& rng) override
+}
+
+void MultiBag::fill(IndexQueue& indices, size_t minIndices, std::mt19937_64& rng) const
+{
+	while(indices.size() < minIndices)
 	{
-		std::uniform_int_distribution<size_t> dist(0, indexCount - 1);
-		while(indices.size() < minIndices)
+		const auto prevSize = static_cast<ptrdiff_t>(indices.size());
+		for(size_t i = 0; i < bagSize; ++i)
 		{
-			indices.push_back(dist(rng));
+			for(size_t idx = 0; idx < indexCount; ++idx)
+			{
+				indices.push_back(idx);
+			}
 		}
+		const auto newBegin = std::next(indices.begin(), prevSize);
+		std::shuffle(newBegin, indices.end(), rng);
 	}
-};
-template<>
-std::unique_ptr<IShuffledIndices> makeShuffledIndices<ShuffleType::Random>(const std::vector<Tetromino>& baseMinos)
+}
+
+TGMH4::TGMH4(const std::vector<Tetromino>& baseTetrominos) : TGMH4(baseTetrominos, baseTetrominos.size() - 1)
 {
-	return std::make_unique<Random>(baseMinos.size());
 }
 
-void MultiBag_fill(std::deque<size_t>& indices, size_t bagSize, size_t indexCount, std::mt19937_64& rng)
+TGMH4::TGMH4(const std::vector<Tetromino>& baseTetrominos, size_t rollMax) : rollMax{rollMax}, historyIdx{0}
 {
-	const auto prevSize = static_cast<ptrdiff_t>(indices.size());
-	std::vector<size_t> baseIndices(indexCount);
-	std::iota(baseIndices.begin(), baseIndices.end(), 0);
-	for(size_t i = 0; i < bagSize; ++i)
+	for(size_t i = 0; i < baseTetrominos.size(); ++i)
 	{
-		indices.insert(indices.end(), baseIndices.begin(), baseIndices.end());
+		if(baseTetrominos[i].type == TetrominoType::O || baseTetrominos[i].type == TetrominoType::Z ||
+		    baseTetrominos[i].type == TetrominoType::S)
+		{
+			pushHistory(i);
+		}
 	}
-	const auto newBegin = std::next(indices.begin(), prevSize);
-	std::shuffle(newBegin, indices.end(), rng);
 }
-template<size_t TBagSize>
-struct MultiBag : IShuffledIndices
+
+void TGMH4::shuffleHistory(std::mt19937_64& rng)
 {
-	size_t indexCount;
-	explicit MultiBag(size_t indexCount) : indexCount{indexCount}
-	{
-	}
-	void fill(std::deque<size_t>& indices, size_t minIndices, std::mt19937_64& rng) override
+	if(!isHistoryShuffled)
 	{
-		while(indices.size() < minIndices)
-		{
-			MultiBag_fill(indices, TBagSize, indexCount, rng);
-		}
+		std::shuffle(history.begin(), history.end(), rng);
+		isHistoryShuffled = true;
 	}
-};
-template<>
-std::unique_ptr<IShuffledIndices> makeShuffledIndices<ShuffleType::SingleBag>(const std::vector<Tetromino>& baseMinos)
+}
+
+void TGMH4::pushHistory(size_t value) noexcept
 {
-	return std::make_unique<MultiBag<1>>(baseMinos.size());
+	history[historyIdx] = value;
+	++historyIdx;
 }
-template<>
-std::unique_ptr<IShuffledIndices> makeShuffledIndices<ShuffleType::DoubleBag>(const std::vector<Tetromino>& baseMinos)
+
+bool TGMH4::isInHistory(size_t idx) const noexcept
 {
-	return std::make_unique<MultiBag<2>>(baseMinos.size());
+	const auto foundIt = std::find(history.begin(), history.end(), idx);
+	return foundIt != history.end();
 }
-template<>
-std::unique_ptr<IShuffledIndices> makeShuffledIndices<ShuffleType::TripleBag>(const std::vector<Tetromino>& baseMinos)
+
+size_t TGMH4::roll(std::mt19937_64& rng) const
 {
-	return std::make_unique<MultiBag<3>>(baseMinos.size());
+	return std::uniform_int_distribution<size_t>{0, rollMax}(rng);
 }
 
-struct TGMH4 : IShuffledIndices
+void TGMH4::fill(IndexQueue& indices, size_t minIndices, std::mt19937_64& rng)
 {
-	static constexpr size_t FILL = std::numeric_limits<size_t>::max();
-	uint8_t historyIdx : 2;
-	std::uniform_int_distribution<size_t> dist;
-	std::array<size_t, 4> history{FILL, FILL, FILL, FILL};
-	explicit TGMH4(const std::vector<Tetromino>& baseTetrominos) : TGMH4(baseTetrominos, baseTetrominos.size() - 1)
-	{
-	}
-	explicit TGMH4(const std::vector<Tetromino>& baseTetrominos, size_t distMax) : historyIdx{0}, dist{0, distMax}
+	shuffleHistory(rng);
+	while(indices.size() < minIndices)
 	{
-		for(size_t i = 0; i < baseTetrominos.size(); ++i)
+		size_t nextIdx = roll(rng);
+		while(isInHistory(nextIdx))
 		{
-			if(baseTetrominos[i].type == TetrominoType::O || baseTetrominos[i].type == TetrominoType::Z ||
-			    baseTetrominos[i].type == TetrominoType::S)
-			{
-				pushHistory(i);
-			}
+			nextIdx = roll(rng);
 		}
-		std::mt19937_64 rng(std::random_device{}());
-		std::shuffle(history.begin(), history.end(), rng);
+		indices.push_back(nextIdx);
+		pushHistory(nextIdx);
 	}
-	void pushHistory(size_t value)
+}
+
+TGM35::TGM35(const std::vector<Tetromino>& baseTetrominos) :
+    TGMH4(baseTetrominos, (baseTetrominos.size() * BAG_COPIES) - 1), indexCount{baseTetrominos.size()}
+{
+	if(indexCount > MAX_INDICES)
 	{
-		history[historyIdx] = value;
-		++historyIdx;
+		throw std::length_error{"TGM35 supports at most MAX_INDICES base Tetrominos"};
 	}
-	bool isInHistory(size_t idx)
+	for(size_t bagIdx = 0; bagIdx < indexCount * BAG_COPIES; ++bagIdx)
 	{
-		const auto foundIt = std::find(history.begin(), history.end(), idx);
-		return foundIt != history.end();
+		bag[bagIdx] = static_cast<uint8_t>(bagIdx % indexCount);
 	}
-	void fill(std::deque<size_t>& indices, size_t minIndices, std::mt19937_64& rng) override
+}
+
+void TGM35::updateBag(size_t bagIdx) noexcept
+{
+	lru[bag[bagIdx]] += 1;
+	const auto lruEnd = std::next(lru.begin(), static_cast<ptrdiff_t>(indexCount));
+	const auto starved = std::min_element(lru.begin(), lruEnd);
+	bag[bagIdx] = static_cast<uint8_t>(std::distance(lru.begin(), starved));
+}
+
+size_t TGM35::starvedOutsideHistory() const noexcept
+{
+	size_t starved = FILL;
+	for(size_t idx = 0; idx < indexCount; ++idx)
 	{
-		while(indices.size() < minIndices)
+		if(!isInHistory(idx) && (starved == FILL || lru[idx] < lru[starved]))
 		{
-			size_t nextIdx = dist(rng);
-			while(isInHistory(nextIdx))
-			{
-				nextIdx = dist(rng);
-			}
-			indices.push_back(nextIdx);
-			pushHistory(nextIdx);
+			starved = idx;
 		}
 	}
-};
-template<>
-std::unique_ptr<IShuffledIndices> makeShuffledIndices<ShuffleType::TGMH4>(const std::vector<Tetromino>& baseMinos)
-{
-	return std::make_unique<TGMH4>(baseMinos);
+	return starved;
 }
 
-struct TGM35 : TGMH4
-{
-	std::vector<size_t> lru;
-	std::vector<size_t> bag;
-	explicit TGM35(const std::vector<Tetromino>& baseTetrominos) :
-	    TGMH4(baseTetrominos, (baseTetrominos.size() * 5) - 1),
-	    lru(baseTetrominos.size(), 0),
-	    bag(baseTetrominos.size() * 5, 0)
+void TGM35::fill(IndexQueue& indices, size_t minIndices, std::mt19937_64& rng)
+{
+	shuffleHistory(rng);
+	const auto bagEnd = std::next(bag.begin(), static_cast<ptrdiff_t>(indexCount * BAG_COPIES));
+	while(indices.size() < minIndices)
 	{
-		const auto baseSize = static_cast<ptrdiff_t>(baseTetrominos.size());
-		auto windowBegin = bag.begin();
-		auto windowEnd = windowBegin;
-		while(windowBegin != bag.end())
+		size_t nextBagIdx = roll(rng);
+		// the bag can drift to only hold pieces from the history, rolling would never end
+		if(std::all_of(bag.begin(), bagEnd, [this](size_t idx) { return isInHistory(idx); }))
 		{
-			std::advance(windowEnd, baseSize);
-			std::iota(windowBegin, windowEnd, 0);
-			std::advance(windowBegin, baseSize);
+			bag[nextBagIdx] = static_cast<uint8_t>(starvedOutsideHistory());
 		}
-	}
-	void updateBag(size_t bagIdx)
-	{
-		lru[bag[bagIdx]] += 1;
-		const auto starved = std::min_element(lru.begin(), lru.end());
-		bag[bagIdx] = static_cast<size_t>(std::distance(lru.begin(), starved));
-	}
-	void fill(std::deque<size_t>& indices, size_t minIndices, std::mt19937_64& rng) override
-	{
-		while(indices.size() < minIndices)
+		while(isInHistory(bag[nextBagIdx]))
 		{
-			size_t nextBagIdx = dist(rng);
-			while(isInHistory(bag[nextBagIdx]))
-			{
-				nextBagIdx = dist(rng);
-			}
-			indices.push_back(bag[nextBagIdx]);
-			pushHistory(bag[nextBagIdx]);
-			updateBag(nextBagIdx);
+			nextBagIdx = roll(rng);
 		}
+		indices.push_back(bag[nextBagIdx]);
+		pushHistory(bag[nextBagIdx]);
+		updateBag(nextBagIdx);
 	}
-};
-template<>
-std::unique_ptr<IShuffledIndices> makeShuffledIndices<ShuffleType::TGM35>(const std::vector<Tetromino>& baseMinos)
-{
-	return std::make_unique<TGM35>(baseMinos);
 }
-struct NES : IShuffledIndices
+
+void NES::fill(IndexQueue& indices, size_t minIndices, std::mt19937_64& rng)
 {
-	size_t previous = std::numeric_limits<size_t>::max();
-	std::uniform_int_distribution<size_t> firstDist;
-	std::uniform_int_distribution<size_t> secondDist;
-	explicit NES(size_t indexCount) : firstDist{0, indexCount}, secondDist{0, indexCount - 1}
-	{
-	}
-	void fill(std::deque<size_t>& indices, size_t minIndices, std::mt19937_64& rng) override
+	std::uniform_int_distribution<size_t> firstDist{0, indexCount};
+	std::uniform_int_distribution<size_t> secondDist{0, indexCount - 1};
+	while(indices.size() < minIndices)
 	{
-		while(indices.size() < minIndices)
+		size_t roll = firstDist(rng);
+		if(roll == previous || roll == firstDist.max())
 		{
-			size_t roll = firstDist(rng);
-			if(roll == previous || roll == firstDist.max())
-			{
-				roll = secondDist(rng);
-			}
-			previous = roll;
-			indices.push_back(roll);
+			roll = secondDist(rng);
 		}
+		previous = roll;
+		indices.push_back(roll);
 	}
-};
+}
+} // namespace shuffling
+
+template<>
+AnyShuffledIndices makeShuffledIndices<ShuffleType::Random>(const std::vector<Tetromino>& baseMinos)
+{
+	return AnyShuffledIndices{shuffling::Random{baseMinos.size()}};
+}
+template<>
+AnyShuffledIndices makeShuffledIndices<ShuffleType::SingleBag>(const std::vector<Tetromino>& baseMinos)
+{
+	return AnyShuffledIndices{shuffling::MultiBag{1, baseMinos.size()}};
+}
+template<>
+AnyShuffledIndices makeShuffledIndices<ShuffleType::DoubleBag>(const std::vector<Tetromino>& baseMinos)
+{
+	return AnyShuffledIndices{shuffling::MultiBag{2, baseMinos.size()}};
+}
+template<>
+AnyShuffledIndices makeShuffledIndices<ShuffleType::TripleBag>(const std::vector<Tetromino>& baseMinos)
+{
+	return AnyShuffledIndices{shuffling::MultiBag{3, baseMinos.size()}};
+}
+template<>
+AnyShuffledIndices makeShuffledIndices<ShuffleType::TGMH4>(const std::vector<Tetromino>& baseMinos)
+{
+	return AnyShuffledIndices{shuffling::TGMH4{baseMinos}};
+}
+template<>
+AnyShuffledIndices makeShuffledIndices<ShuffleType::TGM35>(const std::vector<Tetromino>& baseMinos)
+{
+	return AnyShuffledIndices{shuffling::TGM35{baseMinos}};
+}
 template<>
-std::unique_ptr<IShuffledIndices> makeShuffledIndices<ShuffleType::NES>(const std::vector<Tetromino>& baseMinos)
+AnyShuffledIndices makeShuffledIndices<ShuffleType::NES>(const std::vector<Tetromino>& baseMinos)
 {
-	return std::make_unique<NES>(baseMinos.size());
+	return AnyShuffledIndices{shuffling::NES{baseMinos.size()}};
 }
-std::unique_ptr<IShuffledIndices> (*makeShuffledIndices(ShuffleType ttype))(const std::vector<Tetromino>& baseMinos)
+AnyShuffledIndices (*makeShuffledIndices(ShuffleType ttype))(const std::vector<Tetromino>& baseMinos)
 {
 	switch(ttype)
 	{
@@ -1,6 +1,7 @@
 #include "graphics.hpp"
 
 #include "grid.hpp"
+#include "smallgrid.hpp"
 #include "types.hpp"
 
 #include <raylib.h>
@@ -33,8 +34,9 @@ Grid::Cell ColorMap::operator[](::Color color) const noexcept
 	return static_cast<Grid::Cell>(std::distance(begin(colors), idxIt));
 }
 
-void drawCells(
-    const Grid& grid, XY at, int cellSize, int borderSize, const ColorMap& minoColors, uint8_t alpha) noexcept
+template<typename TGrid>
+void drawCellsImpl(
+    const TGrid& grid, XY at, int cellSize, int borderSize, const ColorMap& minoColors, uint8_t alpha) noexcept
 {
 	const Size gridSize = grid.getSize();
 
@@ -63,6 +65,18 @@ void drawCells(
 	}
 }
 
+void drawCells(
+    const Grid& grid, XY at, int cellSize, int borderSize, const ColorMap& minoColors, uint8_t alpha) noexcept
+{
+	drawCellsImpl(grid, at, cellSize, borderSize, minoColors, alpha);
+}
+
+void drawCells(
+    const PieceGrid& grid, XY at, int cellSize, int borderSize, const ColorMap& minoColors, uint8_t alpha) noexcept
+{
+	drawCellsImpl(grid, at, cellSize, borderSize, minoColors, alpha);
+}
+
 void drawBackground(const Grid& grid, XY at, int cellSize, int borderSize, ::Color fill, ::Color lines) noexcept
 {
 	const Size gridSize = grid.getSize();
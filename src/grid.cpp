@@ -1,13 +1,17 @@
 #include "grid.hpp"
 
+#include "rowscan.hpp"
+#include "smallgrid.hpp"
 #include "types.hpp"
+#include "zobrist.hpp"
 
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
-#include <functional>
+#include <cstdint>
 #include <iterator>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -18,8 +22,146 @@ size_t index1D(int xPos, int yPos, int width) noexcept
 	return (static_cast<size_t>(yPos) * static_cast<size_t>(width)) + static_cast<size_t>(xPos);
 }
 
+/**
+ * @return RowBits with the lowest count bits set
+ */
+Grid::RowBits lowBits(int count) noexcept
+{
+	if(count <= 0)
+	{
+		return 0;
+	}
+	if(count >= Grid::rowBitsWidth)
+	{
+		return ~Grid::RowBits{0};
+	}
+	return (Grid::RowBits{1} << static_cast<unsigned>(count)) - 1;
+}
+
+/**
+ * @return RowBits moved by xOffset (positive towards higher bits), bits shifted out are lost
+ */
+Grid::RowBits shiftBits(Grid::RowBits bits, int xOffset) noexcept
+{
+	if(xOffset >= Grid::rowBitsWidth || xOffset <= -Grid::rowBitsWidth)
+	{
+		return 0;
+	}
+	return xOffset >= 0 ? bits << static_cast<unsigned>(xOffset) : bits >> static_cast<unsigned>(-xOffset);
+}
+
+int countTrailingZeros(Grid::RowBits bits) noexcept
+{
+	int count = 0;
+	for(; (bits & 1) == 0; bits >>= 1)
+	{
+		++count;
+	}
+	return count;
+}
+
+/**
+ * @brief side length of the square tiles used by transpose & rotate, 16x16 cells stay well within L1
+ */
+constexpr size_t TILE_SIZE = 16;
+
+/**
+ * @brief copies every source cell (x, y) to target[targetIndex(x, y)], walking source tile by tile so reads & writes
+ * both stay within a few cache lines
+ * @param source row major cells of width x height
+ * @param target distinct buffer of the same area
+ */
+template<typename TIndexFunc>
+void remapTiled(
+    const Grid::Cell* source, Grid::Cell* target, size_t width, size_t height, TIndexFunc targetIndex) noexcept
+{
+	for(size_t tileY = 0; tileY < height; tileY += TILE_SIZE)
+	{
+		const size_t endY = std::min(tileY + TILE_SIZE, height);
+		for(size_t tileX = 0; tileX < width; tileX += TILE_SIZE)
+		{
+			const size_t endX = std::min(tileX + TILE_SIZE, width);
+			for(size_t yPos = tileY; yPos < endY; ++yPos)
+			{
+				for(size_t xPos = tileX; xPos < endX; ++xPos)
+				{
+					target[targetIndex(xPos, yPos)] = source[(yPos * width) + xPos];
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief in place transpose of a square grid, swaps tile pairs across the diagonal
+ */
+void transposeSquareTiled(Grid::Cell* cells, size_t side) noexcept
+{
+	for(size_t tileY = 0; tileY < side; tileY += TILE_SIZE)
+	{
+		const size_t endY = std::min(tileY + TILE_SIZE, side);
+		for(size_t tileX = tileY; tileX < side; tileX += TILE_SIZE)
+		{
+			const size_t endX = std::min(tileX + TILE_SIZE, side);
+			for(size_t yPos = tileY; yPos < endY; ++yPos)
+			{
+				for(size_t xPos = tileX == tileY ? yPos + 1 : tileX; xPos < endX; ++xPos)
+				{
+					std::swap(cells[(yPos * side) + xPos], cells[(xPos * side) + yPos]);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief runtime dimensions, used for custom field sizes
+ */
+struct DynamicDims
+{
+	static int width(Size size) noexcept
+	{
+		return size.width;
+	}
+	static int height(Size size) noexcept
+	{
+		return size.height;
+	}
+	static bool rowBits(Size size) noexcept
+	{
+		return size.width <= Grid::rowBitsWidth;
+	}
+};
+
+/**
+ * @brief compile-time dimensions, lets the compiler unroll & vectorize the row loops
+ */
+template<int TWidth, int THeight>
+struct FixedDims
+{
+	static_assert(TWidth <= Grid::rowBitsWidth);
+	static constexpr int width([[maybe_unused]] Size size) noexcept
+	{
+		return TWidth;
+	}
+	static constexpr int height([[maybe_unused]] Size size) noexcept
+	{
+		return THeight;
+	}
+	static constexpr bool rowBits([[maybe_unused]] Size size) noexcept
+	{
+		return true;
+	}
+};
+
+/**
+ * @brief standard 10x20 playfield with 4 hidden rows on top
+ */
+using StandardDims = FixedDims<10, 24>;
+
 Grid::Grid(Size size, Grid::Cell fill) : cells(size.area(), fill), size{std::abs(size.width), std::abs(size.height)}
 {
+	updateCaches();
 }
 
 Grid::Grid(Size size, const std::vector<Grid::Cell>& grid) : size{std::abs(size.width), std::abs(size.height)}
@@ -29,32 +171,189 @@ Grid::Grid(Size size, const std::vector<Grid::Cell>& grid) : size{std::abs(size.
 		throw std::logic_error("size mismatch");
 	}
 	cells = grid;
+	updateCaches();
 }
 
-Grid::Grid(const Grid& other, std::function<TTransformFunc> func) :
-    size{std::abs(other.size.width), std::abs(other.size.height)}
+template<typename TDims>
+const Grid::Kernels* Grid::kernelsFor() noexcept
 {
-	cells.reserve(other.cells.size());
-	std::transform(other.cells.begin(), other.cells.end(), std::back_insert_iterator(cells), std::move(func));
+	static constexpr Kernels tdimsKernels{&Grid::overlapAtImpl<TDims, PieceGrid>, &Grid::eraseFullRowsImpl<TDims>,
+	    &Grid::isEmptyImpl<TDims>, !std::is_same_v<TDims, DynamicDims>};
+	return &tdimsKernels;
 }
 
-size_t Grid::overlapAt(XY topLeft, const Grid& other) const noexcept
+const Grid::Kernels* Grid::selectKernels(Size gridSize) noexcept
+{
+	if(gridSize == Size{StandardDims::width({}), StandardDims::height({})})
+	{
+		return kernelsFor<StandardDims>();
+	}
+	return kernelsFor<DynamicDims>();
+}
+
+void Grid::updateCaches() noexcept
+{
+	kernels = selectKernels(size);
+	updateRowBits();
+	columnTops.resize(static_cast<size_t>(size.width));
+	updateColumnTops(0);
+}
+
+void Grid::updateColumnTops(int fromRow) noexcept
 {
-	for(int yPos = 0; yPos < other.size.height; ++yPos)
+	std::fill(columnTops.begin(), columnTops.end(), size.height);
+	int missing = size.width;
+	for(int yPos = std::max(fromRow, 0); yPos < size.height && missing > 0; ++yPos)
 	{
-		for(int xPos = 0; xPos < other.size.width; ++xPos)
+		for(int xPos = 0; xPos < size.width; ++xPos)
+		{
+			int& top = columnTops[static_cast<size_t>(xPos)];
+			if(top == size.height && cells[index1D(xPos, yPos, size.width)] != 0)
+			{
+				top = yPos;
+				--missing;
+			}
+		}
+	}
+}
+
+void Grid::updateRowBits() noexcept
+{
+	hash = 0;
+	if(!hasRowBits())
+	{
+		rowBits.clear();
+		return;
+	}
+	rowBits.resize(static_cast<size_t>(size.height));
+	for(int yPos = 0; yPos < size.height; ++yPos)
+	{
+		rowBits[static_cast<size_t>(yPos)] = rowOccupancyBits(&cells[index1D(0, yPos, size.width)], size.width);
+	}
+	hash = rowsHash(0, size.height);
+}
+
+uint64_t Grid::rowsHash(int first, int last) const noexcept
+{
+	uint64_t rowsKey = 0;
+	for(int yPos = first; yPos < last; ++yPos)
+	{
+		rowsKey ^= zobrist::row(yPos, rowBits[static_cast<size_t>(yPos)]);
+	}
+	return rowsKey;
+}
+
+Grid::RowBits Grid::fullRowBits() const noexcept
+{
+	return lowBits(size.width);
+}
+
+Grid::RowBits Grid::placedRowBits(XY topLeft, const Grid& other, int yPos) const noexcept
+{
+	return shiftBits(other.getRowBits(yPos - topLeft.y), topLeft.x) & fullRowBits();
+}
+
+Grid::RowBits Grid::placedRowBits(XY topLeft, const PieceGrid& other, int yPos) const noexcept
+{
+	return shiftBits(other.getRowBits(yPos - topLeft.y), topLeft.x) & fullRowBits();
+}
+
+template<typename TDims, typename TOther>
+size_t Grid::overlapAtImpl(XY topLeft, const TOther& other) const noexcept
+{
+	const int width = TDims::width(size);
+	const int height = TDims::height(size);
+	const Size otherSize = other.getSize();
+	if(TDims::rowBits(size) && other.hasRowBits())
+	{
+		// cells of other (in its own x coordinates) that are outside this
+		const RowBits outside = ~(shiftBits(lowBits(width), -topLeft.x) & lowBits(width - topLeft.x));
+		for(int yPos = 0; yPos < otherSize.height; ++yPos)
+		{
+			const RowBits otherRow = other.getRowBits(yPos);
+			const int thisY = yPos + topLeft.y;
+			const RowBits blocked = thisY < 0 || thisY >= height
+			                            ? ~RowBits{0}
+			                            : shiftBits(rowBits[static_cast<size_t>(thisY)], -topLeft.x) | outside;
+			if(const RowBits hit = otherRow & blocked; hit != 0)
+			{
+				return index1D(countTrailingZeros(hit), yPos, otherSize.width) + 1;
+			}
+		}
+		return 0;
+	}
+	for(int yPos = 0; yPos < otherSize.height; ++yPos)
+	{
+		for(int xPos = 0; xPos < otherSize.width; ++xPos)
 		{
 			const auto otherCell = other.getAt({xPos, yPos});
 			const auto thisCell = getAt({xPos + topLeft.x, yPos + topLeft.y});
 			if(thisCell != 0 && otherCell != 0)
 			{
-				return index1D(xPos, yPos, other.size.width) + 1;
+				return index1D(xPos, yPos, otherSize.width) + 1;
 			}
 		}
 	}
 	return 0;
 }
 
+size_t Grid::overlapAt(XY topLeft, const Grid& other) const noexcept
+{
+	return overlapAtImpl<DynamicDims>(topLeft, other);
+}
+
+size_t Grid::overlapAt(XY topLeft, const PieceGrid& other) const noexcept
+{
+	return (this->*kernels->overlapAtPiece)(topLeft, other);
+}
+
+template<typename TOther>
+int Grid::dropDistanceImpl(XY topLeft, const TOther& other) const noexcept
+{
+	const Size otherSize = other.getSize();
+	int distance = size.height;
+	for(int xPos = 0; xPos < otherSize.width; ++xPos)
+	{
+		const int thisX = xPos + topLeft.x;
+		for(int yPos = otherSize.height - 1; yPos >= 0; --yPos)
+		{
+			if(other.getAt({xPos, yPos}) == 0)
+			{
+				continue;
+			}
+			const int thisY = yPos + topLeft.y;
+			if(thisX < 0 || thisX >= size.width || thisY < 0)
+			{
+				return 0;
+			}
+			if(thisY < getColumnTop(thisX))
+			{
+				// lowest cell of this column is above the surface, cells above it land later
+				distance = std::min(distance, getColumnTop(thisX) - thisY - 1);
+				break;
+			}
+			// below an overhang, search the next occupied cell underneath
+			int landingY = thisY + 1;
+			while(landingY < size.height && cells[index1D(thisX, landingY, size.width)] == 0)
+			{
+				++landingY;
+			}
+			distance = std::min(distance, landingY - thisY - 1);
+		}
+	}
+	return std::max(distance, 0);
+}
+
+int Grid::dropDistance(XY topLeft, const Grid& other) const noexcept
+{
+	return dropDistanceImpl(topLeft, other);
+}
+
+int Grid::dropDistance(XY topLeft, const PieceGrid& other) const noexcept
+{
+	return dropDistanceImpl(topLeft, other);
+}
+
 Grid::Cell Grid::getAt(XY topLeft, Grid::Cell oobValue) const noexcept
 {
 	if(topLeft.x < 0 || topLeft.x >= size.width || topLeft.y >= size.height || topLeft.y < 0)
@@ -64,80 +363,282 @@ Grid::Cell Grid::getAt(XY topLeft, Grid::Cell oobValue) const noexcept
 	return cells[index1D(topLeft.x, topLeft.y, size.width)];
 }
 
-void Grid::setAt(XY topLeft, const Grid& other) noexcept
+template<typename TOther>
+void Grid::setAtImpl(XY topLeft, const TOther& other) noexcept
 {
-	for(int yPos = 0; yPos < other.size.height; ++yPos)
+	const Size otherSize = other.getSize();
+	const bool updateBits = hasRowBits() && other.hasRowBits();
+	for(int yPos = 0; yPos < otherSize.height; ++yPos)
 	{
-		if(topLeft.y + yPos < 0)
+		if(topLeft.y + yPos < 0 || topLeft.y + yPos >= size.height)
 		{
 			continue;
 		}
-		for(int xPos = 0; xPos < other.size.width; ++xPos)
+		if(updateBits)
+		{
+			RowBits& bits = rowBits[static_cast<size_t>(topLeft.y + yPos)];
+			const RowBits placed = bits | placedRowBits(topLeft, other, topLeft.y + yPos);
+			hash ^= zobrist::row(topLeft.y + yPos, bits) ^ zobrist::row(topLeft.y + yPos, placed);
+			bits = placed;
+		}
+		for(int xPos = 0; xPos < otherSize.width; ++xPos)
 		{
 			if(topLeft.x + xPos >= size.width)
 			{
 				continue;
 			}
-			if(topLeft.x + xPos >= 0 && topLeft.y + yPos < size.height)
+			if(topLeft.x + xPos >= 0)
 			{
 				const auto thisIndex = index1D(xPos + topLeft.x, yPos + topLeft.y, size.width);
-				const auto otherIndex = index1D(xPos, yPos, other.size.width);
-				cells[thisIndex] |= other.cells[otherIndex];
+				const Cell otherCell = other.getAt({xPos, yPos});
+				cells[thisIndex] |= otherCell;
+				int& top = columnTops[static_cast<size_t>(xPos + topLeft.x)];
+				top = otherCell != 0 ? std::min(top, yPos + topLeft.y) : top;
 			}
 		}
 	}
+	if(!updateBits && hasRowBits())
+	{
+		updateRowBits();
+	}
 }
 
-void Grid::rotate(int steps) noexcept
+void Grid::setAt(XY topLeft, const Grid& other) noexcept
+{
+	setAtImpl(topLeft, other);
+}
+
+void Grid::setAt(XY topLeft, const PieceGrid& other) noexcept
+{
+	setAtImpl(topLeft, other);
+}
+
+template<typename TDims>
+uint32_t Grid::eraseFullRowsImpl() noexcept
 {
-	steps %= 4;
-	while(steps != 0)
+	const int width = TDims::width(size);
+	const int height = TDims::height(size);
+	const bool useRowBits = TDims::rowBits(size);
+	const RowBits fullRow = lowBits(width);
+	const auto isFullRow = [&](int row)
+	{
+		if(useRowBits)
+		{
+			return rowBits[static_cast<size_t>(row)] == fullRow;
+		}
+		return allCellsSet(&cells[index1D(0, row, width)], static_cast<size_t>(width));
+	};
+	const auto rowIt = [&](int row)
+	{
+		return std::next(cells.begin(), static_cast<ptrdiff_t>(index1D(0, row, width)));
+	};
+
+	if(width == 0 || height == 0)
+	{
+		return 0;
+	}
+
+	// only rows from the highest column top down to the lowest full row move, the ones below keep their keys
+	const int highestTop = *std::min_element(columnTops.begin(), columnTops.end());
+	int lowestFull = -1;
+
+	// move each run of surviving rows down in one go, bottom to top
+	int writeEnd = height;
+	int readEnd = height;
+	while(readEnd > 0)
 	{
-		if(steps < 0)
+		if(isFullRow(readEnd - 1))
 		{
-			reverseRows();
-			transpose();
-			++steps;
+			if(useRowBits && lowestFull < 0)
+			{
+				// nothing has moved yet
+				lowestFull = readEnd - 1;
+				hash ^= rowsHash(highestTop, readEnd);
+			}
+			--readEnd;
+			continue;
 		}
-		else
+		int readBegin = readEnd - 1;
+		while(readBegin > 0 && !isFullRow(readBegin - 1))
 		{
-			transpose();
-			reverseRows();
-			--steps;
+			--readBegin;
 		}
+		if(writeEnd != readEnd)
+		{
+			std::copy_backward(rowIt(readBegin), rowIt(readEnd), rowIt(writeEnd));
+			if(useRowBits)
+			{
+				std::copy_backward(std::next(rowBits.begin(), readBegin), std::next(rowBits.begin(), readEnd),
+				    std::next(rowBits.begin(), writeEnd));
+			}
+		}
+		writeEnd -= readEnd - readBegin;
+		readEnd = readBegin;
+	}
+
+	const auto erasedRows = static_cast<uint32_t>(writeEnd);
+	std::fill(cells.begin(), rowIt(writeEnd), Cell{0});
+	if(useRowBits)
+	{
+		std::fill(rowBits.begin(), std::next(rowBits.begin(), writeEnd), RowBits{0});
 	}
+	if(erasedRows != 0)
+	{
+		// rows above the highest column top were empty & are now moved down by erasedRows
+		updateColumnTops(highestTop + static_cast<int>(erasedRows));
+		if(useRowBits)
+		{
+			hash ^= rowsHash(highestTop + static_cast<int>(erasedRows), lowestFull + 1);
+		}
+	}
+	return erasedRows;
 }
 
-void Grid::transpose() noexcept
+uint32_t Grid::eraseFullRows() noexcept
+{
+	return (this->*kernels->eraseFullRows)();
+}
+
+template<typename TDims>
+bool Grid::isEmptyImpl() const noexcept
+{
+	if(TDims::rowBits(size))
+	{
+		RowBits occupied = 0;
+		for(size_t row = 0; row < static_cast<size_t>(TDims::height(size)); ++row)
+		{
+			occupied |= rowBits[row];
+		}
+		return occupied == 0;
+	}
+	return allCellsClear(cells.data(), cells.size());
+}
+
+bool Grid::isEmpty() const noexcept
 {
-	if(!isSquare())
+	return (this->*kernels->isEmpty)();
+}
+
+bool Grid::isRowFull(int yPos) const noexcept
+{
+	if(yPos < 0 || yPos >= size.height)
+	{
+		return false;
+	}
+	if(hasRowBits())
 	{
-		std::swap(size.width, size.height);
+		return rowBits[static_cast<size_t>(yPos)] == fullRowBits();
 	}
-	const size_t area = size.area();
+	return allCellsSet(&cells[index1D(0, yPos, size.width)], static_cast<size_t>(size.width));
+}
+
+bool Grid::hasFixedKernels() const noexcept
+{
+	return kernels->isFixed;
+}
+
+template<typename TIndexFunc>
+void Grid::remapCells(TIndexFunc targetIndex) noexcept
+{
+	std::vector<Cell> remapped(cells.size());
+	remapTiled(cells.data(), remapped.data(), static_cast<size_t>(size.width), static_cast<size_t>(size.height),
+	    targetIndex);
+	cells.swap(remapped);
+	std::swap(size.width, size.height);
+	updateCaches();
+}
+
+void Grid::rotate(int steps) noexcept
+{
 	const auto width = static_cast<size_t>(size.width);
 	const auto height = static_cast<size_t>(size.height);
-	for(size_t i = 0; i < area; ++i)
+	switch(((steps % 4) + 4) % 4)
 	{
-		auto dest = (height * (i % width)) + (i / width);
-		while(dest < i)
-		{
-			dest = (height * (dest % width)) + (dest / width);
-		}
-		std::swap(cells[i], cells[dest]);
+	case 1:
+		// (x, y) -> (height - 1 - y, x)
+		remapCells(
+		    [width, height](size_t xPos, size_t yPos)
+		    {
+			    return (xPos * height) + (height - 1 - yPos);
+		    });
+		break;
+	case 2:
+		std::reverse(cells.begin(), cells.end());
+		updateCaches();
+		break;
+	case 3:
+		// (x, y) -> (y, width - 1 - x)
+		remapCells(
+		    [width, height](size_t xPos, size_t yPos)
+		    {
+			    return ((width - 1 - xPos) * height) + yPos;
+		    });
+		break;
+	default:
+		break;
 	}
 }
 
+void Grid::transpose() noexcept
+{
+	if(isSquare())
+	{
+		transposeSquareTiled(cells.data(), static_cast<size_t>(size.width));
+		updateCaches();
+		return;
+	}
+	const auto height = static_cast<size_t>(size.height);
+	remapCells(
+	    [height](size_t xPos, size_t yPos)
+	    {
+		    return (xPos * height) + yPos;
+	    });
+}
+
 void Grid::reverseRows() noexcept
 {
 	for(ptrdiff_t row = 0; row < size.height; ++row)
 	{
 		std::reverse(next(cells.begin(), row * size.width), next(cells.begin(), (row + 1) * size.width));
 	}
+	updateCaches();
 }
 
-void Grid::transformCells(std::function<TTransformFunc> func) noexcept
+bool Grid::pushUp(int rows, Cell fill, int gapColumn) noexcept
 {
-	std::transform(cells.begin(), cells.end(), cells.begin(), std::move(func));
+	const auto width = static_cast<size_t>(size.width);
+	const size_t shifted = width * static_cast<size_t>(std::clamp(rows, 0, size.height));
+	const auto shiftedEnd = std::next(cells.begin(), static_cast<ptrdiff_t>(shifted));
+	const bool isOverflowing = std::any_of(cells.begin(), shiftedEnd,
+	    [](Cell cell)
+	    {
+		    return cell != 0;
+	    });
+	std::copy(shiftedEnd, cells.end(), cells.begin());
+	for(size_t idx = cells.size() - shifted; idx < cells.size(); ++idx)
+	{
+		cells[idx] = static_cast<int>(idx % width) == gapColumn ? Cell{0} : fill;
+	}
+	updateCaches();
+	return isOverflowing;
+}
+
+void Grid::fill(Cell value) noexcept
+{
+	std::fill(cells.begin(), cells.end(), value);
+	updateCaches();
+}
+
+void Grid::recolor(Cell color) noexcept
+{
+	Cell* cellPtr = cells.data();
+	for(size_t idx = 0; idx < cells.size(); ++idx)
+	{
+		cellPtr[idx] = cellPtr[idx] != 0 ? color : Cell{0};
+	}
+	if(color == 0)
+	{
+		updateCaches();
+	}
 }
 } // namespace raymino
@@ -1,25 +1,31 @@
 #include "input.hpp"
 
-#include <raylib.h>
-
 #include <cstdint>
 
 namespace raymino
 {
-KeyAction::Return KeyAction::tick(float delta) noexcept
+/**
+ * @return -1 if only lbutton is set, 1 if only rbutton is set, 0 otherwise
+ */
+int direction(uint8_t buttons, InputSnapshot::Button rbutton, InputSnapshot::Button lbutton) noexcept
+{
+	return ((buttons & lbutton) != 0 ? -1 : 0) + ((buttons & rbutton) != 0 ? 1 : 0);
+}
+
+KeyAction::Return KeyAction::tick(float delta, const InputSnapshot& input) noexcept
 {
-	if(const int val = (::IsKeyPressed(lkey) ? -1 : 0) + (::IsKeyPressed(rkey) ? 1 : 0); val != 0)
+	if(const int val = direction(input.pressed, rbutton, lbutton); val != 0)
 	{
 		delayTimer.elapsed = -repeatDelay;
 		return {State::Pressed, static_cast<int8_t>(val)};
 	}
 
-	if(const int val = (::IsKeyDown(lkey) ? -1 : 0) + (::IsKeyDown(rkey) ? 1 : 0); val != 0 && delayTimer.step(delta))
+	if(const int val = direction(input.down, rbutton, lbutton); val != 0 && delayTimer.step(delta) != 0)
 	{
 		return {State::Repeated, static_cast<int8_t>(val)};
 	}
 
-	if(const int val = (::IsKeyReleased(lkey) ? -1 : 0) + (::IsKeyReleased(rkey) ? 1 : 0); val != 0)
+	if(const int val = direction(input.released, rbutton, lbutton); val != 0)
 	{
 		return {State::Released, static_cast<int8_t>(val)};
 	}
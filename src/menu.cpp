@@ -1,6 +1,7 @@
 #include "menu.hpp"
 
 #include "app.hpp"
+#include "attract.hpp"
 #include "dependency_info.hpp"
 #include "gui.hpp"
 #include "scenes.hpp"
@@ -127,9 +128,74 @@ void Menu::writeSettings(App::Settings& settings) const noexcept
 	settings.fieldHeight = static_cast<uint8_t>(SpinnerFieldHeightValue);
 }
 
-void Menu::Update([[maybe_unused]] App& app)
+#if !defined(PLATFORM_WEB)
+/**
+ * @return path of the most recently written replay, empty if there is none
+ */
+std::string findLatestReplay()
 {
-	// handled in draw due to immediate mode
+	if(!::DirectoryExists(App::REPLAY_DIRECTORY))
+	{
+		return {};
+	}
+	const ::FilePathList files = ::LoadDirectoryFilesEx(App::REPLAY_DIRECTORY, ".raymino", false);
+	std::string latest;
+	long latestTime = 0;
+	for(unsigned int idx = 0; idx < files.count; ++idx)
+	{
+		const long modTime = ::GetFileModTime(files.paths[idx]);
+		if(latest.empty() || modTime > latestTime)
+		{
+			latest = files.paths[idx];
+			latestTime = modTime;
+		}
+	}
+	::UnloadDirectoryFiles(files);
+	return latest;
+}
+#endif
+
+/**
+ * @return true if any key or mouse button is held or the mouse moved, keys are not taken from the input queue
+ */
+bool isAnyInputActive() noexcept
+{
+	const ::Vector2 mouseDelta = ::GetMouseDelta();
+	if(mouseDelta.x != 0 || mouseDelta.y != 0 || ::IsMouseButtonDown(MOUSE_BUTTON_LEFT) ||
+	    ::IsMouseButtonDown(MOUSE_BUTTON_RIGHT))
+	{
+		return true;
+	}
+	for(int key = KEY_SPACE; key <= KEY_KB_MENU; ++key)
+	{
+		if(::IsKeyDown(key))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void Menu::Update(App& app)
+{
+	idleSeconds = isAnyInputActive() ? 0 : idleSeconds + ::GetFrameTime();
+	if(idleSeconds > Attract::IDLE_SECONDS)
+	{
+		idleSeconds = 0;
+		app.QueueSceneSwitch(Scene::Attract);
+	}
+
+	// gui is handled in draw due to immediate mode
+	if(::IsFileDropped())
+	{
+		const ::FilePathList dropped = ::LoadDroppedFiles();
+		if(dropped.count > 0)
+		{
+			app.replayPath = dropped.paths[0];
+			app.QueueSceneSwitch(Scene::Replay);
+		}
+		::UnloadDroppedFiles(dropped);
+	}
 }
 
 void Menu::Draw(App& app)
@@ -176,6 +242,17 @@ void Menu::Draw(App& app)
 	{
 		AboutDialogShowing = true;
 	}
+	if(::GuiButton({GroupBoxGameRect.x + GroupBoxGameRect.width - 68, GroupBoxGameRect.y - 7, 24, 16}, "VS"))
+	{
+		app.QueueSceneSwitch(Scene::Versus);
+	}
+#if !defined(PLATFORM_WEB)
+	if(::GuiButton({GroupBoxGameRect.x + GroupBoxGameRect.width - 42, GroupBoxGameRect.y - 7, 16, 16}, "#131#"))
+	{
+		app.replayPath = findLatestReplay();
+		app.QueueSceneSwitch(Scene::Replay);
+	}
+#endif
 	if(AboutDialogShowing)
 	{
 		UpdateDrawAbout(app);
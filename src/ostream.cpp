@@ -28,7 +28,8 @@ std::ostream& operator<<(std::ostream& ostream, const Offset& value)
 	ostream << '{' << value.position << ", " << value.rotation << '}';
 	return ostream;
 }
-std::ostream& operator<<(std::ostream& ostream, const Grid& value)
+template<typename TGrid>
+std::ostream& printCells(std::ostream& ostream, const TGrid& value)
 {
 	ostream << '{';
 
@@ -48,6 +49,14 @@ std::ostream& operator<<(std::ostream& ostream, const Grid& value)
 	ostream << '}';
 	return ostream;
 }
+std::ostream& operator<<(std::ostream& ostream, const Grid& value)
+{
+	return printCells(ostream, value);
+}
+std::ostream& operator<<(std::ostream& ostream, const PieceGrid& value)
+{
+	return printCells(ostream, value);
+}
 std::ostream& operator<<(std::ostream& ostream, const TSpinCornerCountResult& value)
 {
 	ostream << '{' << value.front << ", " << value.back << '}';
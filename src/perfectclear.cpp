@@ -0,0 +1,343 @@
+#include "perfectclear.hpp"
+
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "placement.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "threadpool.hpp"
+#include "types.hpp"
+#include "zobrist.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace raymino
+{
+constexpr size_t NOT_SOLVED = std::numeric_limits<size_t>::max();
+
+/**
+ * @brief bits of the even columns, x = 0, 2, 4, ...
+ */
+constexpr Grid::RowBits EVEN_COLUMNS = 0x5555555555555555ULL;
+
+int countBits(Grid::RowBits bits) noexcept
+{
+	return static_cast<int>(std::bitset<Grid::rowBitsWidth>{bits}.count());
+}
+
+PerfectClearSolver::PerfectClearSolver(const Settings& settings, ThreadPool* workers) :
+    pool{workers},
+    rules{settings},
+    simulation{nullptr},
+    maxDepth{0},
+    rootSearches{PlacementSearch{settings}, PlacementSearch{settings}},
+    nextChild{0},
+    firstSolved{NOT_SOLVED},
+    deadEnds{TABLE_CAPACITY}
+{
+	contexts.resize(pool == nullptr ? 1 : pool->size());
+}
+
+std::vector<PerfectClearStep> PerfectClearSolver::solve(const Simulation& game, size_t maxPieces)
+{
+	simulation = &game;
+	const IndexQueue& nextIndices = game.nextTetrominoIndices;
+	sequence.assign(1, static_cast<size_t>(game.currentTetromino.type));
+	sequence.insert(sequence.end(), nextIndices.begin(),
+	    nextIndices.begin() + static_cast<ptrdiff_t>(std::min<size_t>(rules.previewCount, nextIndices.size())));
+	// dead ends store the pieces left in a byte
+	maxDepth = std::min({maxPieces, sequence.size(), size_t{std::numeric_limits<uint8_t>::max()}});
+	for(Context& context : contexts)
+	{
+		if(context.searches.size() < maxDepth * 2)
+		{
+			context.searches.resize(maxDepth * 2, PlacementSearch{rules});
+		}
+		context.fields.assign(maxDepth + 1, game.playfield);
+		context.children.resize(std::max(context.children.size(), maxDepth));
+	}
+
+	const Grid& field = game.playfield;
+	const Size size = field.getSize();
+	int cells = 0;
+	int stackHeight = 0;
+	for(int yPos = 0; yPos < size.height; ++yPos)
+	{
+		const int rowCells = countBits(field.getRowBits(yPos));
+		cells += rowCells;
+		stackHeight = rowCells != 0 ? std::max(stackHeight, size.height - yPos) : stackHeight;
+	}
+	const size_t holdIdx = rules.holdPiece ? game.holdPieceIdx : Simulation::NO_HOLD_PIECE;
+	for(int lines = std::max(stackHeight, 1); lines <= size.height; ++lines)
+	{
+		const int empty = (size.width * lines) - cells;
+		if(empty > static_cast<int>(maxDepth) * 4)
+		{
+			break;
+		}
+		const Node root{0, holdIdx, lines};
+		if(empty <= 0 || !isFeasible(field, root, maxDepth))
+		{
+			continue;
+		}
+
+		listChildren(rootSearches[0], rootSearches[1], field, root, game.holdPieceLocked, game.currentTetromino,
+		    rootChildren);
+		solutions.assign(rootChildren.size(), {});
+		nextChild = 0;
+		firstSolved = NOT_SOLVED;
+		const auto searchChildren = [this, &field](size_t contextIdx)
+		{
+			Context& context = contexts[contextIdx];
+			for(size_t childIdx = nextChild++; childIdx < rootChildren.size() && childIdx < firstSolved;
+			    childIdx = nextChild++)
+			{
+				Child child = rootChildren[childIdx];
+				context.fields[1] = field;
+				if(!applyChild(context.fields[1], child, maxDepth - 1))
+				{
+					continue;
+				}
+				context.chosen.assign(1, child);
+				if(search(context, 1, child.node, childIdx))
+				{
+					solutions[childIdx] = steps(context);
+					size_t solved = firstSolved;
+					while(childIdx < solved && !firstSolved.compare_exchange_weak(solved, childIdx))
+					{
+					}
+					return;
+				}
+			}
+		};
+		if(pool == nullptr)
+		{
+			searchChildren(0);
+		}
+		else
+		{
+			pool->parallelFor(contexts.size(), 1, searchChildren);
+		}
+		if(firstSolved != NOT_SOLVED)
+		{
+			return solutions[firstSolved];
+		}
+	}
+	return {};
+}
+
+bool PerfectClearSolver::isFeasible(const Grid& field, const Node& node, size_t piecesLeft) const noexcept
+{
+	const Size size = field.getSize();
+	const Grid::RowBits fullRow = field.fullRowBits();
+	Grid::RowBits walls = fullRow;
+	int empty = 0;
+	int evenEmpty = 0;
+	for(int yPos = size.height - node.linesLeft; yPos < size.height; ++yPos)
+	{
+		const Grid::RowBits row = field.getRowBits(yPos);
+		walls &= row;
+		empty += countBits(~row & fullRow);
+		evenEmpty += countBits(~row & fullRow & EVEN_COLUMNS);
+	}
+	const int piecesNeeded = empty / 4;
+	if(empty % 4 != 0 || piecesNeeded > static_cast<int>(piecesLeft))
+	{
+		return false;
+	}
+
+	// columns filled in every row stay filled when rows are cleared, no piece fits across them
+	for(int xPos = 0; xPos < size.width && walls != 0;)
+	{
+		int segmentEnd = xPos;
+		while(segmentEnd < size.width && (walls & (Grid::RowBits{1} << static_cast<unsigned>(segmentEnd))) == 0)
+		{
+			++segmentEnd;
+		}
+		const Grid::RowBits segment = (fullRow >> static_cast<unsigned>(size.width - segmentEnd + xPos))
+		                              << static_cast<unsigned>(xPos);
+		int segmentEmpty = 0;
+		for(int yPos = size.height - node.linesLeft; yPos < size.height; ++yPos)
+		{
+			segmentEmpty += countBits(~field.getRowBits(yPos) & segment);
+		}
+		if(segmentEmpty % 4 != 0)
+		{
+			return false;
+		}
+		xPos = segmentEnd + 1;
+	}
+
+	// O, S, Z & flat I or T cover 2 cells of each column parity, L, J & upright T change the difference by 2, an
+	// upright I by 4, the next piecesNeeded pieces are among the held one & one more than that of the sequence
+	int maxChange = 0;
+	const auto addChange = [this, &maxChange](size_t pieceIdx)
+	{
+		switch(simulation->baseTetrominos[pieceIdx].type)
+		{
+		case TetrominoType::I:
+			maxChange += 4;
+			break;
+		case TetrominoType::L:
+		case TetrominoType::J:
+		case TetrominoType::T:
+			maxChange += 2;
+			break;
+		default:
+			break;
+		}
+	};
+	const size_t last = std::min(sequence.size(), node.position + static_cast<size_t>(piecesNeeded) + 1);
+	for(size_t position = node.position; position < last; ++position)
+	{
+		addChange(sequence[position]);
+	}
+	if(node.holdIdx != Simulation::NO_HOLD_PIECE)
+	{
+		addChange(node.holdIdx);
+	}
+	return std::abs((2 * evenEmpty) - empty) <= maxChange;
+}
+
+bool PerfectClearSolver::applyChild(Grid& field, Child& child, size_t piecesLeft) const noexcept
+{
+	const Offset& offset = child.placement.offset;
+	field.setAt(offset.position, simulation->baseTetrominos[child.pieceIdx].collision(offset.rotation));
+	child.node.linesLeft -= static_cast<int>(field.eraseFullRows());
+	return isFeasible(field, child.node, piecesLeft);
+}
+
+/**
+ * @brief move piece down to just above the rows to clear, every row above them is empty
+ * @remarks the search then skips the empty rows, its moves have the same effect at any height up there as long as
+ * kicks can not reach the stack
+ */
+Tetromino lowered(const Tetromino& piece, int top) noexcept
+{
+	constexpr int KICK_ROOM = 2;
+	Tetromino start = piece;
+	const Rect cells = findTrueSize(piece.collision());
+	start.position.y = std::max(piece.position.y, top - KICK_ROOM - cells.y - cells.height);
+	return start;
+}
+
+void PerfectClearSolver::listChildren(PlacementSearch& next, PlacementSearch& held, const Grid& field,
+    const Node& node, bool isHoldLocked, const Tetromino& start, std::vector<Child>& children) const
+{
+	children.clear();
+	const int top = field.getSize().height - node.linesLeft;
+	const auto addChildren = [this, &field, &children, top](PlacementSearch& search, const Tetromino& piece,
+	                             bool useHold, size_t pieceIdx, const Node& child)
+	{
+		for(const Placement& placement : search.search(field, lowered(piece, top)))
+		{
+			// pieces have to fit into the rows to clear
+			if(placement.offset.position.y + findTrueSize(piece.collision(placement.offset.rotation)).y >= top)
+			{
+				children.push_back({useHold, pieceIdx, placement, child});
+			}
+		}
+	};
+
+	const size_t pieceIdx = sequence[node.position];
+	addChildren(next, start, false, pieceIdx, {node.position + 1, node.holdIdx, node.linesLeft});
+	if(!rules.holdPiece || isHoldLocked)
+	{
+		return;
+	}
+	Node swapped{node.position + 1, pieceIdx, node.linesLeft};
+	size_t heldIdx = node.holdIdx;
+	if(heldIdx == Simulation::NO_HOLD_PIECE)
+	{
+		if(node.position + 1 >= sequence.size())
+		{
+			return;
+		}
+		heldIdx = sequence[node.position + 1];
+		swapped.position = node.position + 2;
+	}
+	else if(heldIdx == pieceIdx)
+	{
+		// swapping equal pieces leads to the same nodes
+		return;
+	}
+	addChildren(held, simulation->baseTetrominos[heldIdx], true, heldIdx, swapped);
+}
+
+bool PerfectClearSolver::search(Context& context, size_t depth, const Node& node, size_t childIdx)
+{
+	const Grid& field = context.fields[depth];
+	if(node.linesLeft == 0)
+	{
+		return true;
+	}
+	const size_t piecesLeft = maxDepth - depth;
+	if(piecesLeft == 0 || node.position >= sequence.size())
+	{
+		return false;
+	}
+	const uint64_t key = deadKey(field, node);
+	if(const std::optional<uint8_t> searched = deadEnds.find(key); searched && *searched >= piecesLeft)
+	{
+		return false;
+	}
+
+	std::vector<Child>& children = context.children[depth];
+	listChildren(context.searches[depth * 2], context.searches[(depth * 2) + 1], field, node, false,
+	    simulation->baseTetrominos[sequence[node.position]], children);
+	for(Child& child : children)
+	{
+		if(firstSolved < childIdx)
+		{
+			return false;
+		}
+		Grid& placed = context.fields[depth + 1];
+		placed = field;
+		if(!applyChild(placed, child, piecesLeft - 1))
+		{
+			continue;
+		}
+		context.chosen.push_back(child);
+		if(search(context, depth + 1, child.node, childIdx))
+		{
+			return true;
+		}
+		context.chosen.pop_back();
+	}
+	// a search cut short by an earlier solution proves nothing
+	if(!(firstSolved < childIdx))
+	{
+		deadEnds.store(key, static_cast<uint8_t>(piecesLeft));
+	}
+	return false;
+}
+
+std::vector<PerfectClearStep> PerfectClearSolver::steps(const Context& context) const
+{
+	std::vector<PerfectClearStep> result;
+	for(size_t depth = 0; depth < context.chosen.size(); ++depth)
+	{
+		const Child& child = context.chosen[depth];
+		const size_t searchIdx = child.useHold ? 1 : 0;
+		const PlacementPath path = depth == 0 ? rootSearches[searchIdx].path(child.placement)
+		                                      : context.searches[(depth * 2) + searchIdx].path(child.placement);
+		result.push_back({child.useHold, child.pieceIdx, child.placement.offset, {path.begin(), path.end()}});
+	}
+	return result;
+}
+
+uint64_t PerfectClearSolver::deadKey(const Grid& field, const Node& node) const noexcept
+{
+	return field.getHash() ^
+	       zobrist::queue(sequence.begin() + static_cast<ptrdiff_t>(node.position), sequence.end()) ^
+	       zobrist::hold(node.holdIdx, false) ^ zobrist::linesLeft(node.linesLeft);
+}
+} // namespace raymino
@@ -0,0 +1,226 @@
+#include "placement.hpp"
+
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "smallgrid.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace raymino
+{
+template<RotationSystem TRotation>
+PlacementSearch::SearchFunc selectSearch(WallKicks wallKicks) noexcept
+{
+	switch(wallKicks)
+	{
+	case WallKicks::None:
+		return &PlacementSearch::searchWith<RulePolicy<TRotation, WallKicks::None>>;
+	case WallKicks::Arika:
+		return &PlacementSearch::searchWith<RulePolicy<TRotation, WallKicks::Arika>>;
+	default:
+	case WallKicks::Super:
+		return &PlacementSearch::searchWith<RulePolicy<TRotation, WallKicks::Super>>;
+	}
+}
+
+/**
+ * @return PlacementSearch::searchWith instantiated for the RulePolicy of the rules
+ */
+PlacementSearch::SearchFunc selectSearch(RotationSystem rotationSystem, WallKicks wallKicks)
+{
+	switch(rotationSystem)
+	{
+	case RotationSystem::Original:
+		return selectSearch<RotationSystem::Original>(wallKicks);
+	case RotationSystem::Arika:
+		return selectSearch<RotationSystem::Arika>(wallKicks);
+	case RotationSystem::Sega:
+		return selectSearch<RotationSystem::Sega>(wallKicks);
+	case RotationSystem::NintendoLeft:
+		return selectSearch<RotationSystem::NintendoLeft>(wallKicks);
+	case RotationSystem::NintendoRight:
+		return selectSearch<RotationSystem::NintendoRight>(wallKicks);
+	case RotationSystem::Super:
+		return selectSearch<RotationSystem::Super>(wallKicks);
+	}
+	throw std::runtime_error{"Invalid RotationSystem value"};
+}
+
+/**
+ * @return true if both shapes cover the same cells relative to their true size
+ */
+bool isSameShape(const PieceGrid& lhs, Rect lhsSize, const PieceGrid& rhs, Rect rhsSize) noexcept
+{
+	if(!(static_cast<Size>(lhsSize) == static_cast<Size>(rhsSize)))
+	{
+		return false;
+	}
+	for(int yPos = 0; yPos < lhsSize.height; ++yPos)
+	{
+		for(int xPos = 0; xPos < lhsSize.width; ++xPos)
+		{
+			if((lhs.getAt({lhsSize.x + xPos, lhsSize.y + yPos}) != 0) !=
+			    (rhs.getAt({rhsSize.x + xPos, rhsSize.y + yPos}) != 0))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+PlacementSearch::PlacementSearch(const Settings& settings) :
+    searchFunc{selectSearch(settings.rotationSystem, settings.wallKicks)},
+    fieldSize{0, 0},
+    visited{},
+    landed{},
+    steps{},
+    queue{}
+{
+}
+
+const std::vector<Placement>& PlacementSearch::search(const Grid& field, const Tetromino& tetromino)
+{
+	placements.clear();
+	moves.clear();
+	visited.reset();
+	landed.reset();
+	fieldSize = field.getSize();
+	(this->*searchFunc)(field, tetromino);
+	return placements;
+}
+
+template<typename TRules>
+void PlacementSearch::searchWith(const Grid& field, const Tetromino& tetromino)
+{
+	// the only copy, every state is explored by moving its offset
+	Tetromino mino = tetromino;
+	mino.rotation &= 0b11;
+	if(field.overlapAt(mino.position, mino.collision()) != 0)
+	{
+		return;
+	}
+
+	std::array<Rect, 4> trueSizes{};
+	std::array<int, 4> sameCells{};
+	for(int rotation = 0; rotation < 4; ++rotation)
+	{
+		const auto idx = static_cast<size_t>(rotation);
+		trueSizes[idx] = findTrueSize(mino.collision(rotation));
+		sameCells[idx] = rotation;
+		for(int other = 0; other < rotation; ++other)
+		{
+			if(isSameShape(mino.collision(rotation), trueSizes[idx], mino.collision(other),
+			       trueSizes[static_cast<size_t>(other)]))
+			{
+				sameCells[idx] = other;
+				break;
+			}
+		}
+	}
+
+	const StateIdx start = stateAt(mino);
+	visited.set(start);
+	steps[start] = {start, PlacementMove::SoftDrop};
+	queue[0] = start;
+	size_t head = 0;
+	size_t tail = 1;
+	while(head < tail)
+	{
+		const StateIdx state = queue[head++];
+		const Offset current = offsetAt(state);
+		const auto visit = [&](Offset next, PlacementMove move)
+		{
+			const StateIdx nextState = stateAt(next);
+			if(!visited.test(nextState))
+			{
+				visited.set(nextState);
+				steps[nextState] = {state, move};
+				queue[tail++] = nextState;
+			}
+		};
+
+		static_cast<Offset&>(mino) = current;
+		const PieceGrid& collision = mino.collision();
+		if(field.overlapAt(current.position + XY{-1, 0}, collision) == 0)
+		{
+			visit(current + Offset{{-1, 0}, 0}, PlacementMove::MoveLeft);
+		}
+		if(field.overlapAt(current.position + XY{1, 0}, collision) == 0)
+		{
+			visit(current + Offset{{1, 0}, 0}, PlacementMove::MoveRight);
+		}
+		if(const int dropDistance = field.dropDistance(current.position, collision); dropDistance > 0)
+		{
+			visit(current + Offset{{0, dropDistance}, 0}, PlacementMove::SoftDrop);
+		}
+		else
+		{
+			const auto rotationIdx = static_cast<size_t>(current.rotation);
+			const XY shift = static_cast<XY>(trueSizes[rotationIdx]) -
+			                 static_cast<XY>(trueSizes[static_cast<size_t>(sameCells[rotationIdx])]);
+			addPlacement(state, stateAt({current.position + shift, sameCells[rotationIdx]}), current);
+		}
+		for(const auto& [direction, move] : {std::pair{1, PlacementMove::RotateRight},
+		        std::pair{-1, PlacementMove::RotateLeft}})
+		{
+			// same order as Simulation::stepWith, basic rotation first & kicks only if that collides
+			Offset rotation = TRules::rotate(mino, direction);
+			mino += rotation;
+			if(field.overlapAt(mino.position, mino.collision()) != 0)
+			{
+				mino -= rotation;
+				rotation = TRules::kick(field, mino, rotation);
+				mino += rotation;
+			}
+			visit({mino.position, mino.rotation & 0b11}, move);
+			static_cast<Offset&>(mino) = current;
+		}
+	}
+}
+
+PlacementPath PlacementSearch::path(const Placement& placement) const noexcept
+{
+	const PlacementMove* first = moves.data() + placement.pathBegin;
+	return {first, first + placement.pathLength};
+}
+
+PlacementSearch::StateIdx PlacementSearch::stateAt(Offset offset) const noexcept
+{
+	const int cell = ((offset.position.y + MARGIN) * (fieldSize.width + MARGIN)) + offset.position.x + MARGIN;
+	return static_cast<StateIdx>((cell * 4) + offset.rotation);
+}
+
+Offset PlacementSearch::offsetAt(StateIdx state) const noexcept
+{
+	const int cell = state / 4;
+	const int stride = fieldSize.width + MARGIN;
+	return {{(cell % stride) - MARGIN, (cell / stride) - MARGIN}, state % 4};
+}
+
+void PlacementSearch::addPlacement(StateIdx state, StateIdx sameCells, Offset offset)
+{
+	if(landed.test(sameCells))
+	{
+		return;
+	}
+	landed.set(sameCells);
+	const auto pathBegin = static_cast<uint32_t>(moves.size());
+	for(StateIdx current = state; steps[current].parent != current; current = steps[current].parent)
+	{
+		moves.push_back(steps[current].move);
+	}
+	std::reverse(moves.begin() + pathBegin, moves.end());
+	placements.push_back({offset, pathBegin, static_cast<uint32_t>(moves.size()) - pathBegin});
+}
+} // namespace raymino
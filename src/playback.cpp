@@ -0,0 +1,112 @@
+#include "playback.hpp"
+
+#include "input.hpp"
+#include "replay.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace raymino
+{
+Playback::Playback(Replay replay, const PieceColors& colors) :
+    recording{std::move(replay)},
+    current{recording.info().settings, recording.info().seed, colors},
+    reader{recording.reader()},
+    keyframes{{current.save(), reader}}
+{
+}
+
+bool Playback::step()
+{
+	InputSnapshot input;
+	if(!reader.next(input))
+	{
+		return false;
+	}
+	current.step(Settings::TICK_SECONDS, input);
+	if(reader.position() % KEYFRAME_INTERVAL == 0 && reader.position() / KEYFRAME_INTERVAL == keyframes.size())
+	{
+		keyframes.push_back({current.save(), reader});
+	}
+	return true;
+}
+
+uint32_t Playback::advanceTime(double seconds)
+{
+	timeBudget += seconds;
+	uint32_t steps = 0;
+	while(timeBudget > 0 && step())
+	{
+		timeBudget -= static_cast<double>(Settings::TICK_SECONDS);
+		++steps;
+	}
+	if(isFinished())
+	{
+		timeBudget = 0;
+	}
+	return steps;
+}
+
+uint32_t Playback::advance(uint32_t steps)
+{
+	uint32_t taken = 0;
+	while(taken < steps && step())
+	{
+		++taken;
+	}
+	return taken;
+}
+
+void Playback::seek(uint32_t target)
+{
+	target = std::min(target, length());
+	const size_t keyframeIdx = std::min<size_t>(target / KEYFRAME_INTERVAL, keyframes.size() - 1);
+	const Keyframe& keyframe = keyframes[keyframeIdx];
+	if(target < position() || keyframe.reader.position() > position())
+	{
+		current.restore(keyframe.snapshot);
+		reader = keyframe.reader;
+	}
+	advance(target - position());
+	timeBudget = 0;
+}
+
+uint32_t Playback::position() const noexcept
+{
+	return reader.position();
+}
+
+uint32_t Playback::length() const noexcept
+{
+	return recording.info().steps;
+}
+
+bool Playback::isFinished() const noexcept
+{
+	return position() >= length();
+}
+
+double Playback::elapsed() const noexcept
+{
+	return static_cast<double>(position()) / Settings::TICK_RATE;
+}
+
+double Playback::duration() const noexcept
+{
+	return static_cast<double>(length()) / Settings::TICK_RATE;
+}
+
+const Simulation& Playback::simulation() const noexcept
+{
+	return current;
+}
+
+const Replay& Playback::replay() const noexcept
+{
+	return recording;
+}
+} // namespace raymino
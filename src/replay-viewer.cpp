@@ -0,0 +1,163 @@
+#include "replay-viewer.hpp"
+
+#include "app.hpp"
+#include "game.hpp"
+#include "replay.hpp"
+#include "scenes.hpp"
+#include "simulation.hpp"
+
+#include <FileData.hpp>
+#include <raygui.h>
+#include <raylib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace raymino
+{
+template<>
+std::unique_ptr<IScene> MakeScene<Scene::Replay>(App& app)
+{
+	try
+	{
+		return std::make_unique<ReplayViewer>(app, ReplayViewer::load(app.replayPath.c_str()));
+	}
+	catch(const std::exception& exception)
+	{
+		::TraceLog(LOG_WARNING, "REPLAY: [%s] %s", app.replayPath.c_str(), exception.what());
+		return MakeScene<Scene::Menu>(app);
+	}
+}
+
+Replay ReplayViewer::load(const char* path)
+{
+	const raylib::FileData fileData(path);
+	return Replay::deserialize(
+	    App::decompressFile(fileData.GetData(), static_cast<uint32_t>(fileData.GetBytesRead())));
+}
+
+ReplayViewer::ReplayViewer([[maybe_unused]] App& app, Replay recording) :
+    playback{std::move(recording), makePieceColors()},
+    view{playback.simulation()},
+    ToggleGroupSpeedActive{0},
+    SliderBarPositionValue{0},
+    isPlaying{true}
+{
+}
+
+void ReplayViewer::PreDestruct([[maybe_unused]] App& app)
+{
+	// played back sessions are not recorded again
+}
+
+bool ReplayViewer::isAllocationFree() const noexcept
+{
+	return false;
+}
+
+void ReplayViewer::advanceUnlimited()
+{
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point deadline = Clock::now() + UNLIMITED_FRAME_BUDGET;
+	while(!playback.isFinished() && Clock::now() < deadline)
+	{
+		playback.advance(UNLIMITED_STEPS_PER_CHECK);
+	}
+}
+
+void ReplayViewer::Update(App& app)
+{
+	const App::KeyBinds& keyBinds = app.keyBinds();
+
+	if(::IsKeyPressed(keyBinds.menu))
+	{
+		app.QueueSceneSwitch(Scene::Menu);
+	}
+	if(::IsKeyPressed(keyBinds.restart))
+	{
+		playback.seek(0);
+		isPlaying = true;
+	}
+	if(::IsKeyPressed(keyBinds.pause))
+	{
+		if(playback.isFinished())
+		{
+			playback.seek(0);
+			isPlaying = false;
+		}
+		isPlaying = !isPlaying;
+	}
+	for(int speed = 0; speed <= SPEED_UNLIMITED; ++speed)
+	{
+		if(::IsKeyPressed(KEY_ONE + speed))
+		{
+			ToggleGroupSpeedActive = speed;
+		}
+	}
+	if(::IsKeyPressed(KEY_LEFT))
+	{
+		playback.seek(playback.position() - std::min(playback.position(), SKIP_STEPS));
+	}
+	if(::IsKeyPressed(KEY_RIGHT))
+	{
+		playback.seek(playback.position() + SKIP_STEPS);
+	}
+
+	if(isPlaying)
+	{
+		if(ToggleGroupSpeedActive == SPEED_UNLIMITED)
+		{
+			advanceUnlimited();
+		}
+		else
+		{
+			playback.advanceTime(
+			    static_cast<double>(::GetFrameTime() * SPEEDS[static_cast<size_t>(ToggleGroupSpeedActive)]));
+		}
+	}
+	isPlaying = isPlaying && !playback.isFinished();
+
+	view.score += playback.simulation().score - view.score.value();
+	view.state = playback.isFinished() ? GameView::State::GameOver
+	             : isPlaying           ? GameView::State::Running
+	                                   : GameView::State::Paused;
+	SliderBarPositionValue = static_cast<float>(playback.position());
+}
+
+void ReplayViewer::FixedUpdate([[maybe_unused]] App& app)
+{
+	// playback is paced by the frame time & selected speed
+}
+
+void ReplayViewer::Draw([[maybe_unused]] App& app)
+{
+	view.draw(playback.simulation());
+
+	constexpr float PADDING = 10;
+	constexpr float SIDEBAR_WIDTH = 150;
+	constexpr float CONTROL_HEIGHT = 24;
+	constexpr float CONTROLS_Y = App::Settings::SCREEN_HEIGHT - PADDING - (CONTROL_HEIGHT * 3);
+
+	const auto elapsed = static_cast<int>(playback.elapsed());
+	const auto duration = static_cast<int>(playback.duration());
+	::GuiLabel({PADDING, CONTROLS_Y, SIDEBAR_WIDTH - (PADDING * 2), CONTROL_HEIGHT},
+	    ::TextFormat("%d:%02d / %d:%02d", elapsed / 60, elapsed % 60, duration / 60, duration % 60));
+
+	constexpr float SPEED_WIDTH = (SIDEBAR_WIDTH - (PADDING * 2)) / static_cast<float>(SPEED_UNLIMITED + 1);
+	::GuiToggleGroup({PADDING, CONTROLS_Y + CONTROL_HEIGHT, SPEED_WIDTH, CONTROL_HEIGHT}, ToggleGroupSpeedText,
+	    &ToggleGroupSpeedActive);
+
+	const float previousPosition = SliderBarPositionValue;
+	::GuiSliderBar({PADDING, CONTROLS_Y + (CONTROL_HEIGHT * 2), SIDEBAR_WIDTH - (PADDING * 2), CONTROL_HEIGHT}, nullptr,
+	    nullptr, &SliderBarPositionValue, 0, static_cast<float>(playback.length()));
+	if(SliderBarPositionValue != previousPosition)
+	{
+		// seeking is applied in Draw due to immediate mode, the new position is shown next frame
+		playback.seek(static_cast<uint32_t>(SliderBarPositionValue));
+	}
+}
+} // namespace raymino
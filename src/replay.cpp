@@ -0,0 +1,225 @@
+#include "replay.hpp"
+
+#include "input.hpp"
+#include "savefile.hpp"
+#include "settings.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace raymino
+{
+namespace
+{
+constexpr size_t RESERVED_INPUT_BYTES = 16 * 1024;
+/**
+ * @brief most bytes a step appends, a varint of up to 64 bits & an explicit edges event
+ */
+constexpr size_t MAX_STEP_INPUT_BYTES = 10 + 3;
+constexpr uint8_t EXPLICIT_EDGES = 1U << 7U;
+static_assert(InputSnapshot::Hold < EXPLICIT_EDGES, "buttons need to fit next to the EXPLICIT_EDGES flag");
+
+void appendVarint(std::vector<uint8_t>& bytes, uint64_t value)
+{
+	while(value >= 0x80U)
+	{
+		bytes.push_back(static_cast<uint8_t>(value | 0x80U));
+		value >>= 7U;
+	}
+	bytes.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t readVarint(const std::vector<uint8_t>& bytes, size_t& pos)
+{
+	uint64_t value = 0;
+	for(unsigned shift = 0; shift < 64; shift += 7)
+	{
+		if(pos >= bytes.size())
+		{
+			break;
+		}
+		const uint8_t byte = bytes[pos++];
+		value |= static_cast<uint64_t>(byte & 0x7FU) << shift;
+		if((byte & 0x80U) == 0)
+		{
+			return value;
+		}
+	}
+	throw std::range_error("replay data truncated");
+}
+
+uint8_t readByte(const std::vector<uint8_t>& bytes, size_t& pos)
+{
+	if(pos >= bytes.size())
+	{
+		throw std::range_error("replay data truncated");
+	}
+	return bytes[pos++];
+}
+
+/**
+ * @return true if pressed & released follow from the change of down bits
+ */
+constexpr bool hasDerivedEdges(const InputSnapshot& input, uint8_t prevDown) noexcept
+{
+	return input.pressed == (input.down & ~prevDown) && input.released == (prevDown & ~input.down);
+}
+} // namespace
+
+Replay::Reader::Reader(const Replay& replay) : replay{&replay}
+{
+	unchangedSteps = replay.inputs.empty() ? UINT64_MAX : readVarint(replay.inputs, inputPos);
+}
+
+bool Replay::Reader::next(InputSnapshot& input)
+{
+	if(step >= replay->header.steps)
+	{
+		return false;
+	}
+	++step;
+
+	input = InputSnapshot{down, 0, 0};
+	if(unchangedSteps > 0)
+	{
+		--unchangedSteps;
+		return true;
+	}
+	const uint8_t event = readByte(replay->inputs, inputPos);
+	input.down = static_cast<uint8_t>(event & ~EXPLICIT_EDGES);
+	if((event & EXPLICIT_EDGES) != 0)
+	{
+		input.pressed = readByte(replay->inputs, inputPos);
+		input.released = readByte(replay->inputs, inputPos);
+	}
+	else
+	{
+		input.pressed = static_cast<uint8_t>(input.down & ~down);
+		input.released = static_cast<uint8_t>(down & ~input.down);
+	}
+	down = input.down;
+	unchangedSteps = inputPos < replay->inputs.size() ? readVarint(replay->inputs, inputPos) : UINT64_MAX;
+	return true;
+}
+
+uint32_t Replay::Reader::position() const noexcept
+{
+	return step;
+}
+
+Replay::Replay(uint64_t seed, const Settings& settings) : header{seed, settings, 0, Settings::TICK_RATE}
+{
+	inputs.reserve(RESERVED_INPUT_BYTES);
+}
+
+void Replay::record(const InputSnapshot& input)
+{
+	if(input.down == prevDown && input.pressed == 0 && input.released == 0)
+	{
+		++unchangedSteps;
+	}
+	else
+	{
+		appendVarint(inputs, unchangedSteps);
+		unchangedSteps = 0;
+		if(hasDerivedEdges(input, prevDown))
+		{
+			inputs.push_back(input.down);
+		}
+		else
+		{
+			inputs.push_back(static_cast<uint8_t>(input.down | EXPLICIT_EDGES));
+			inputs.push_back(input.pressed);
+			inputs.push_back(input.released);
+		}
+		prevDown = input.down;
+	}
+	++header.steps;
+}
+
+bool Replay::canRecord() const noexcept
+{
+	return inputs.capacity() - inputs.size() >= MAX_STEP_INPUT_BYTES;
+}
+
+bool Replay::reserveAhead()
+{
+	if(inputs.capacity() - inputs.size() >= RESERVED_INPUT_BYTES / 2)
+	{
+		return false;
+	}
+	inputs.reserve(inputs.size() + RESERVED_INPUT_BYTES);
+	return true;
+}
+
+const Replay::Info& Replay::info() const noexcept
+{
+	return header;
+}
+
+Replay::Reader Replay::reader() const
+{
+	return Reader{*this};
+}
+
+size_t Replay::encodedBytes() const noexcept
+{
+	return inputs.size();
+}
+
+SaveFile Replay::serialize() const
+{
+	SaveFile save(3, static_cast<uint32_t>(sizeof(Info) + encodedBytes()));
+	save.appendChunkValue(header, ChunkType::Info);
+	save.appendChunkRange(inputs, ChunkType::Inputs);
+	save.header().userProp3 = static_cast<uint32_t>(save.size() - sizeof(SaveFile::Header));
+	return save;
+}
+
+Replay Replay::deserialize(const SaveFile& save)
+{
+	const Info* info = nullptr;
+	Replay encoded{0, {}};
+	for(const SaveFile::Chunk::Header& chunkHeader : save)
+	{
+		switch(chunkHeader.type)
+		{
+		case ChunkType::Info:
+		{
+			const SaveFile::Chunk::DataRange<const Info> range(chunkHeader);
+			info = range.begin() != range.end() ? range.begin() : info;
+		}
+		break;
+		case ChunkType::Inputs:
+		{
+			const SaveFile::Chunk::DataRange<const uint8_t> range(chunkHeader);
+			encoded.inputs.assign(range.begin(), range.end());
+		}
+		break;
+		default:
+			break;
+		}
+	}
+	if(info == nullptr)
+	{
+		throw std::runtime_error("replay info missing");
+	}
+	if(info->tickRate != Settings::TICK_RATE)
+	{
+		throw std::runtime_error("replay tick rate not supported");
+	}
+	encoded.header = *info;
+
+	// record the decoded steps again, validates the data & restores the recording state
+	Replay replay{info->seed, info->settings};
+	Reader reader{encoded};
+	InputSnapshot input;
+	while(reader.next(input))
+	{
+		replay.record(input);
+	}
+	return replay;
+}
+} // namespace raymino
@@ -0,0 +1,120 @@
+#include "rowscan.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RAYMINO_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define RAYMINO_AVX2
+#include <immintrin.h>
+#endif
+
+namespace raymino
+{
+#if defined(RAYMINO_SSE2)
+/**
+ * @return uint32_t bit i set if chunk[i] == 0
+ */
+inline uint32_t zeroMask16(const uint8_t* chunk) noexcept
+{
+	__m128i bytes{};
+	std::memcpy(&bytes, chunk, sizeof(bytes));
+	return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_setzero_si128())));
+}
+#endif
+#if defined(RAYMINO_AVX2)
+/**
+ * @return uint32_t bit i set if chunk[i] == 0
+ */
+inline uint32_t zeroMask32(const uint8_t* chunk) noexcept
+{
+	__m256i bytes{};
+	std::memcpy(&bytes, chunk, sizeof(bytes));
+	return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_setzero_si256())));
+}
+#endif
+
+uint64_t rowOccupancyBits(const uint8_t* row, int width) noexcept
+{
+	uint64_t bits = 0;
+	int xPos = 0;
+#if defined(RAYMINO_AVX2)
+	for(; xPos + 32 <= width; xPos += 32)
+	{
+		bits |= static_cast<uint64_t>(~zeroMask32(row + xPos)) << static_cast<unsigned>(xPos);
+	}
+#endif
+#if defined(RAYMINO_SSE2)
+	for(; xPos + 16 <= width; xPos += 16)
+	{
+		bits |= static_cast<uint64_t>(~zeroMask16(row + xPos) & 0xFFFFU) << static_cast<unsigned>(xPos);
+	}
+#endif
+	for(; xPos < width; ++xPos)
+	{
+		bits |= static_cast<uint64_t>(row[xPos] != 0) << static_cast<unsigned>(xPos);
+	}
+	return bits;
+}
+
+bool allCellsSet(const uint8_t* cells, size_t count) noexcept
+{
+	size_t idx = 0;
+#if defined(RAYMINO_AVX2)
+	for(; idx + 32 <= count; idx += 32)
+	{
+		if(zeroMask32(cells + idx) != 0)
+		{
+			return false;
+		}
+	}
+#endif
+#if defined(RAYMINO_SSE2)
+	for(; idx + 16 <= count; idx += 16)
+	{
+		if(zeroMask16(cells + idx) != 0)
+		{
+			return false;
+		}
+	}
+#endif
+	return std::all_of(cells + idx, cells + count,
+	    [](uint8_t cell)
+	    {
+		    return cell != 0;
+	    });
+}
+
+bool allCellsClear(const uint8_t* cells, size_t count) noexcept
+{
+	size_t idx = 0;
+#if defined(RAYMINO_AVX2)
+	for(; idx + 32 <= count; idx += 32)
+	{
+		if(zeroMask32(cells + idx) != 0xFFFFFFFFU)
+		{
+			return false;
+		}
+	}
+#endif
+#if defined(RAYMINO_SSE2)
+	for(; idx + 16 <= count; idx += 16)
+	{
+		if(zeroMask16(cells + idx) != 0xFFFFU)
+		{
+			return false;
+		}
+	}
+#endif
+	return std::all_of(cells + idx, cells + count,
+	    [](uint8_t cell)
+	    {
+		    return cell == 0;
+	    });
+}
+} // namespace raymino
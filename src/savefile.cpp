@@ -39,7 +39,9 @@ SaveFile::Chunk::Iterator SaveFile::end() noexcept
 
 SaveFile::Chunk::Header& SaveFile::appendChunkEmpty(uint32_t bytes, uint16_t type, uint16_t flags)
 {
-	auto headerPos = dataBuffer.insert(dataBuffer.end(), sizeof(Chunk::Header) + bytes, 0);
+	// pad to the next header, Chunk::Iterator skips the padding
+	const size_t paddingBytes = (alignof(Chunk::Header) - (bytes % alignof(Chunk::Header))) % alignof(Chunk::Header);
+	auto headerPos = dataBuffer.insert(dataBuffer.end(), sizeof(Chunk::Header) + bytes + paddingBytes, 0);
 	Chunk::Header& header = *new(&*headerPos) Chunk::Header{type, flags, bytes};
 	return header;
 }
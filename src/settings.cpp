@@ -0,0 +1,81 @@
+#include "settings.hpp"
+
+#include <array>
+#include <cstring>
+
+namespace raymino
+{
+bool Settings::operator==(const Settings& rhs) const noexcept
+{
+	return compare(rhs) == 0;
+}
+bool Settings::operator!=(const Settings& rhs) const noexcept
+{
+	return compare(rhs) != 0;
+}
+bool Settings::operator>(const Settings& rhs) const noexcept
+{
+	return compare(rhs) > 0;
+}
+bool Settings::operator<(const Settings& rhs) const noexcept
+{
+	return compare(rhs) < 0;
+}
+int Settings::compare(const Settings& rhs) const noexcept
+{
+	return std::memcmp(this, &rhs, sizeof(Settings));
+}
+
+namespace presets
+{
+NamedSettings SettingsNES() noexcept
+{
+	Settings settings{};
+	settings.rotationSystem = RotationSystem::NintendoRight;
+	settings.wallKicks = WallKicks::None;
+	settings.lockDown = LockDown::Instant;
+	settings.softDrop = SoftDrop::Locking;
+	settings.instantDrop = InstantDrop::None;
+	settings.tSpin = TSpin::None;
+	settings.shuffleType = ShuffleType::NES;
+	settings.scoringSystem = ScoringSystem::Nintendo;
+	settings.levelGoal = LevelGoal::Fixed;
+	settings.holdPiece = false;
+	settings.ghostPiece = false;
+	settings.fieldWidth = 10;
+	settings.fieldHeight = 20;
+	settings.previewCount = 1;
+	return {"Nintendo NES", settings};
+}
+
+NamedSettings SettingsTGMLike() noexcept
+{
+	Settings settings{};
+	settings.rotationSystem = RotationSystem::Arika;
+	settings.wallKicks = WallKicks::Arika;
+	settings.lockDown = LockDown::Classic;
+	settings.softDrop = SoftDrop::Locking;
+	settings.instantDrop = InstantDrop::Sonic;
+	settings.tSpin = TSpin::Lenient;
+	settings.shuffleType = ShuffleType::TGM35;
+	settings.scoringSystem = ScoringSystem::Guideline;
+	settings.levelGoal = LevelGoal::Fixed;
+	settings.holdPiece = false;
+	settings.ghostPiece = true;
+	settings.fieldWidth = 10;
+	settings.fieldHeight = 20;
+	settings.previewCount = 1;
+	return {"TGM Like", settings};
+}
+
+NamedSettings SettingsGuideline() noexcept
+{
+	return {"Guideline", {}};
+}
+
+std::array<NamedSettings, 3> builtinSettings() noexcept
+{
+	return {SettingsGuideline(), SettingsNES(), SettingsTGMLike()};
+}
+} // namespace presets
+} // namespace raymino
@@ -0,0 +1,454 @@
+#include "bot.hpp"
+#include "grid.hpp"
+#include "input.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "threadpool.hpp"
+#include "types.hpp"
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace raymino; // NOLINT(google-build-using-namespace)
+
+namespace
+{
+/**
+ * @brief a minute of Settings::TICK_SECONDS ticks, the game steps at the same fixed rate
+ */
+constexpr uint64_t MAX_TICKS_PER_PIECE = uint64_t{Settings::TICK_RATE} * 60;
+const PieceColors PIECE_COLORS{1, 2, 3, 4, 5, 6, 7};
+/**
+ * @brief games are CPU bound, more threads than this only cost memory
+ */
+constexpr size_t MAX_THREADS_PER_CORE = 4;
+
+enum class Policy
+{
+	Scripted,
+	Random,
+	Bot,
+};
+
+struct Options
+{
+	size_t games = 1000;
+	size_t threads = std::thread::hardware_concurrency();
+	std::string seed = "raymino";
+	std::string preset = "Guideline";
+	Policy policy = Policy::Scripted;
+	uint32_t maxPieces = 1000;
+	size_t rollouts = 0;
+	std::optional<ShuffleType> shuffleType;
+	std::optional<ScoringSystem> scoringSystem;
+	std::optional<LevelGoal> levelGoal;
+};
+
+struct Config
+{
+	std::string_view name;
+	Settings settings;
+};
+
+struct GameResult
+{
+	int64_t score = 0;
+	uint32_t pieces = 0;
+	uint64_t ticks = 0;
+	std::array<uint32_t, 5> lineClears{};
+	bool isGameOver = false;
+};
+
+/**
+ * @brief rotates each piece a number of times picked from the piece count, moves it to the column where it lands
+ * lowest & drops it
+ * @remarks presses every other tick so each press registers as a new one
+ */
+class ScriptedInput
+{
+public:
+	InputSnapshot next(const Simulation& simulation) noexcept
+	{
+		if(simulation.lockedPieces != piece || simulation.currentTetromino.type != type)
+		{
+			piece = simulation.lockedPieces;
+			type = simulation.currentTetromino.type;
+			rotations = static_cast<int>((piece + static_cast<uint32_t>(type)) % 4);
+			targetColumn = NO_TARGET;
+			lastColumn = simulation.currentTetromino.position.x;
+			stalled = 0;
+		}
+		isReleasing = !isReleasing;
+		if(isReleasing)
+		{
+			return InputSnapshot{};
+		}
+		if(rotations > 0)
+		{
+			--rotations;
+			return InputSnapshot::tap(InputSnapshot::RotateRight);
+		}
+		if(targetColumn == NO_TARGET)
+		{
+			targetColumn = lowestLanding(simulation);
+		}
+		const int column = simulation.currentTetromino.position.x;
+		stalled = column == lastColumn ? stalled + 1 : 0;
+		lastColumn = column;
+		if(column != targetColumn && stalled < 2)
+		{
+			return InputSnapshot::tap(column < targetColumn ? InputSnapshot::MoveRight : InputSnapshot::MoveLeft);
+		}
+		if(simulation.settings.instantDrop != InstantDrop::None)
+		{
+			return InputSnapshot::tap(InputSnapshot::HardDrop);
+		}
+		InputSnapshot input;
+		input.set(InputSnapshot::SoftDrop, true, false, false);
+		return input;
+	}
+
+private:
+	static constexpr int NO_TARGET = std::numeric_limits<int>::min();
+
+	static int lowestLanding(const Simulation& simulation) noexcept
+	{
+		const Grid& playfield = simulation.playfield;
+		const PieceGrid& collision = simulation.currentTetromino.collision();
+		XY best{simulation.currentTetromino.position.x, std::numeric_limits<int>::min()};
+		for(int xPos = -collision.getSize().width; xPos < playfield.getSize().width; ++xPos)
+		{
+			const XY position{xPos, simulation.currentTetromino.position.y};
+			if(playfield.overlapAt(position, collision) == 0)
+			{
+				const int landing = position.y + playfield.dropDistance(position, collision);
+				best = landing > best.y ? XY{xPos, landing} : best;
+			}
+		}
+		return best.x;
+	}
+
+	uint32_t piece = UINT32_MAX;
+	TetrominoType type = TetrominoType::I;
+	int rotations = 0;
+	int targetColumn = NO_TARGET;
+	int lastColumn = 0;
+	int stalled = 0;
+	bool isReleasing = false;
+};
+
+/**
+ * @brief presses a random button on some ticks & holds soft drop on others
+ */
+InputSnapshot randomInput(std::mt19937_64& rng) noexcept
+{
+	constexpr std::array<InputSnapshot::Button, 7> buttons{InputSnapshot::MoveLeft, InputSnapshot::MoveRight,
+	    InputSnapshot::RotateRight, InputSnapshot::RotateLeft, InputSnapshot::Hold, InputSnapshot::HardDrop,
+	    InputSnapshot::SoftDrop};
+	std::uniform_int_distribution<size_t> roll{0, buttons.size() * 4};
+	const size_t pick = roll(rng);
+	if(pick >= buttons.size())
+	{
+		return InputSnapshot{};
+	}
+	return InputSnapshot::tap(buttons[pick]);
+}
+
+GameResult playGame(const Settings& settings, size_t seed, Policy policy, uint32_t maxPieces, size_t rollouts)
+{
+	Simulation simulation{settings, seed, PIECE_COLORS};
+	std::mt19937_64 inputRng{seed};
+	ScriptedInput scripted;
+	// games already run in parallel, the bot searches on the thread of its game
+	std::optional<Bot> bot;
+	if(policy == Policy::Bot)
+	{
+		BotRollouts botRollouts;
+		botRollouts.samples = rollouts;
+		bot.emplace(settings, BotWeights{}, 1, nullptr, botRollouts);
+	}
+	GameResult result;
+	const uint64_t maxTicks = MAX_TICKS_PER_PIECE * std::max<uint64_t>(maxPieces, 1);
+	while(!simulation.isGameOver && simulation.lockedPieces < maxPieces && result.ticks < maxTicks)
+	{
+		switch(policy)
+		{
+		case Policy::Scripted:
+			simulation.step(Settings::TICK_SECONDS, scripted.next(simulation));
+			break;
+		case Policy::Random:
+			simulation.step(Settings::TICK_SECONDS, randomInput(inputRng));
+			break;
+		case Policy::Bot:
+			simulation.step(Settings::TICK_SECONDS, bot->next(simulation));
+			break;
+		}
+		++result.ticks;
+	}
+	result.score = simulation.score;
+	result.pieces = simulation.lockedPieces;
+	result.lineClears = simulation.lineClears;
+	result.isGameOver = simulation.isGameOver;
+	return result;
+}
+
+void printUsage()
+{
+	std::cout << "usage: raymino-sim [options]\n"
+	             "  --games N          games to play (1000)\n"
+	             "  --threads N        worker threads (all cores)\n"
+	             "  --seed TEXT        base seed, game i uses TEXT#i (raymino)\n"
+	             "  --preset NAME      preset name, index or all (Guideline)\n"
+	             "  --policy NAME      Scripted, Random or Bot input (Scripted)\n"
+	             "  --max-pieces N     end games after N pieces (1000)\n"
+	             "  --rollouts N       sampled sequences per Bot candidate past the previews (0)\n"
+	             "  --shuffle NAME     override ShuffleType\n"
+	             "  --scoring NAME     override ScoringSystem\n"
+	             "  --level-goal NAME  override LevelGoal\n";
+}
+
+template<typename TEnum>
+bool parseEnum(std::string_view text, std::optional<TEnum>& target)
+{
+	target = magic_enum::enum_cast<TEnum>(text);
+	if(!target)
+	{
+		std::cerr << "unknown value " << text << ", expected one of:";
+		for(const std::string_view name : magic_enum::enum_names<TEnum>())
+		{
+			std::cerr << ' ' << name;
+		}
+		std::cerr << '\n';
+	}
+	return target.has_value();
+}
+
+bool parseCount(std::string_view text, size_t& target)
+{
+	// unsigned from_chars takes no sign, so negative counts are rejected instead of wrapping around
+	size_t count = 0;
+	const char* const end = text.data() + text.size();
+	const auto [last, error] = std::from_chars(text.data(), end, count);
+	if(error != std::errc{} || last != end || count == 0)
+	{
+		return false;
+	}
+	target = count;
+	return true;
+}
+
+std::optional<Options> parseOptions(int argc, const char* const argv[])
+{
+	Options options;
+	for(int idx = 1; idx < argc; ++idx)
+	{
+		const std::string_view key{argv[idx]};
+		if(key == "--help" || key == "-h" || idx + 1 >= argc)
+		{
+			return std::nullopt;
+		}
+		const std::string_view value{argv[++idx]};
+		size_t count = 0;
+		bool isValid = true;
+		if(key == "--games")
+		{
+			isValid = parseCount(value, options.games);
+		}
+		else if(key == "--threads")
+		{
+			isValid = parseCount(value, options.threads);
+			const size_t cores = std::max(std::thread::hardware_concurrency(), 1U);
+			options.threads = std::min(options.threads, cores * MAX_THREADS_PER_CORE);
+		}
+		else if(key == "--seed")
+		{
+			options.seed = value;
+		}
+		else if(key == "--preset")
+		{
+			options.preset = value;
+		}
+		else if(key == "--policy")
+		{
+			std::optional<Policy> policy;
+			isValid = parseEnum(value, policy);
+			options.policy = policy.value_or(options.policy);
+		}
+		else if(key == "--max-pieces")
+		{
+			isValid = parseCount(value, count);
+			options.maxPieces = static_cast<uint32_t>(std::min<size_t>(count, UINT32_MAX));
+		}
+		else if(key == "--rollouts")
+		{
+			isValid = parseCount(value, options.rollouts);
+		}
+		else if(key == "--shuffle")
+		{
+			isValid = parseEnum(value, options.shuffleType);
+		}
+		else if(key == "--scoring")
+		{
+			isValid = parseEnum(value, options.scoringSystem);
+		}
+		else if(key == "--level-goal")
+		{
+			isValid = parseEnum(value, options.levelGoal);
+		}
+		else
+		{
+			std::cerr << "unknown option " << key << '\n';
+			return std::nullopt;
+		}
+		if(!isValid)
+		{
+			std::cerr << "invalid value for " << key << '\n';
+			return std::nullopt;
+		}
+	}
+	return options;
+}
+
+/**
+ * @return presets matching options.preset with overrides applied, empty if none match
+ */
+std::vector<Config> selectConfigs(const Options& options)
+{
+	std::vector<Config> configs;
+	const auto builtin = presets::builtinSettings();
+	for(size_t idx = 0; idx < builtin.size(); ++idx)
+	{
+		const presets::NamedSettings& named = builtin[idx];
+		if(options.preset == "all" || options.preset == named.name || options.preset == std::to_string(idx))
+		{
+			configs.push_back({named.name, named.settings});
+		}
+	}
+	for(Config& config : configs)
+	{
+		config.settings.shuffleType = options.shuffleType.value_or(config.settings.shuffleType);
+		config.settings.scoringSystem = options.scoringSystem.value_or(config.settings.scoringSystem);
+		config.settings.levelGoal = options.levelGoal.value_or(config.settings.levelGoal);
+	}
+	return configs;
+}
+
+int64_t percentile(const std::vector<int64_t>& sorted, size_t percent)
+{
+	return sorted[std::min(sorted.size() - 1, (sorted.size() * percent) / 100)];
+}
+
+void printReport(const Config& config, const std::vector<GameResult>& results)
+{
+	std::vector<int64_t> scores;
+	scores.reserve(results.size());
+	std::array<uint64_t, 5> lineClears{};
+	uint64_t pieces = 0;
+	size_t gameOvers = 0;
+	for(const GameResult& result : results)
+	{
+		scores.push_back(result.score);
+		pieces += result.pieces;
+		gameOvers += static_cast<size_t>(result.isGameOver);
+		for(size_t lines = 0; lines < lineClears.size(); ++lines)
+		{
+			lineClears[lines] += result.lineClears[lines];
+		}
+	}
+	std::sort(scores.begin(), scores.end());
+	const double count = static_cast<double>(scores.size());
+	const double mean = static_cast<double>(std::accumulate(scores.begin(), scores.end(), int64_t{0})) / count;
+	double variance = 0;
+	for(const int64_t score : scores)
+	{
+		variance += (static_cast<double>(score) - mean) * (static_cast<double>(score) - mean);
+	}
+	const double deviation = std::sqrt(variance / count);
+
+	std::cout << config.name << ": " << results.size() << " games, " << gameOvers << " game over, "
+	          << results.size() - gameOvers << " hit a limit, " << pieces << " pieces\n";
+	std::cout << "  score mean " << std::fixed << std::setprecision(1) << mean << " stddev " << deviation << '\n';
+	std::cout << "  score min " << scores.front() << " p10 " << percentile(scores, 10) << " p25 "
+	          << percentile(scores, 25) << " p50 " << percentile(scores, 50) << " p75 " << percentile(scores, 75)
+	          << " p90 " << percentile(scores, 90) << " max " << scores.back() << '\n';
+	std::cout << "  locks by lines cleared";
+	for(size_t lines = 0; lines < lineClears.size(); ++lines)
+	{
+		const double share =
+		    pieces == 0 ? 0 : 100.0 * static_cast<double>(lineClears[lines]) / static_cast<double>(pieces);
+		std::cout << ' ' << lines << ':' << lineClears[lines] << " (" << share << "%)";
+	}
+	std::cout << '\n';
+}
+} // namespace
+
+int main(int argc, const char* const argv[])
+{
+	const std::optional<Options> options = parseOptions(argc, argv);
+	if(!options)
+	{
+		printUsage();
+		return 1;
+	}
+	const std::vector<Config> configs = selectConfigs(*options);
+	if(configs.empty())
+	{
+		std::cerr << "unknown preset " << options->preset << ", expected one of:";
+		for(const presets::NamedSettings& named : presets::builtinSettings())
+		{
+			std::cerr << " \"" << named.name << '"';
+		}
+		std::cerr << " all\n";
+		return 1;
+	}
+
+	ThreadPool pool{options->threads};
+	std::vector<GameResult> results(options->games * configs.size());
+	const auto start = std::chrono::steady_clock::now();
+	pool.parallelFor(results.size(), 0,
+	    [&](size_t index)
+	    {
+		    const size_t game = index % options->games;
+		    const Config& config = configs[index / options->games];
+		    const size_t seed = hashSeedString(options->seed + '#' + std::to_string(game));
+		    results[index] = playGame(config.settings, seed, options->policy, options->maxPieces, options->rollouts);
+	    });
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	uint64_t pieces = 0;
+	uint64_t ticks = 0;
+	for(const GameResult& result : results)
+	{
+		pieces += result.pieces;
+		ticks += result.ticks;
+	}
+	const double seconds = std::max(elapsed.count(), 1e-9);
+	std::cout << results.size() << " games on " << pool.size() << " threads in " << std::fixed << std::setprecision(3)
+	          << seconds << "s, " << static_cast<double>(results.size()) / seconds << " games/s, "
+	          << static_cast<double>(pieces) / seconds << " pieces/s, "
+	          << static_cast<double>(ticks) / Settings::TICK_RATE / seconds << "x realtime\n";
+
+	for(size_t configIdx = 0; configIdx < configs.size(); ++configIdx)
+	{
+		const auto first = results.begin() + static_cast<ptrdiff_t>(configIdx * options->games);
+		printReport(configs[configIdx], std::vector<GameResult>(first, first + static_cast<ptrdiff_t>(options->games)));
+	}
+	return 0;
+}
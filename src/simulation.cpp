@@ -0,0 +1,385 @@
+#include "simulation.hpp"
+
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "input.hpp"
+#include "settings.hpp"
+#include "timer.hpp"
+#include "types.hpp"
+#include "zobrist.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace raymino
+{
+void prepareTetromino(Tetromino& tetromino, Grid::Cell color, int fieldWidth) noexcept
+{
+	for(PieceGrid& shape : tetromino.shapes)
+	{
+		shape.recolor(color);
+	}
+	tetromino.position = spawnPosition(tetromino, Simulation::HIDDEN_HEIGHT - 2, fieldWidth);
+}
+
+std::vector<Tetromino> prepareTetrominos(
+    std::vector<Tetromino> tetrominos, const PieceColors& colors, int fieldWidth) noexcept
+{
+	std::sort(tetrominos.begin(), tetrominos.end(),
+	    [](const Tetromino& lhs, const Tetromino& rhs)
+	    {
+		    return lhs.type < rhs.type;
+	    });
+	for(Tetromino& tetromino : tetrominos)
+	{
+		prepareTetromino(tetromino, colors[static_cast<size_t>(tetromino.type)], fieldWidth);
+	}
+	return tetrominos;
+}
+
+size_t hashSeedString(std::string_view seedText)
+{
+	if(!seedText.empty())
+	{
+		return std::hash<std::string_view>{}(seedText);
+	}
+	return std::hash<std::random_device::result_type>{}(std::random_device{}());
+}
+
+/**
+ * @return playfield size including the hidden rows
+ * @throws std::length_error if it does not fit into a Simulation::Snapshot
+ */
+Size playfieldSize(const Settings& settings)
+{
+	if(settings.fieldWidth > Settings::MAX_FIELD_WIDTH || settings.fieldHeight > Settings::MAX_FIELD_HEIGHT)
+	{
+		throw std::length_error{"playfield exceeds Settings::MAX_FIELD_WIDTH x MAX_FIELD_HEIGHT"};
+	}
+	return {settings.fieldWidth, settings.fieldHeight + Simulation::HIDDEN_HEIGHT};
+}
+
+bool isKeyPress(KeyAction::Return keyPress) noexcept
+{
+	return keyPress.value != 0 && keyPress.state != KeyAction::State::Released;
+}
+
+template<RotationSystem TRotation>
+Simulation::StepFunc selectStep(WallKicks wallKicks) noexcept
+{
+	switch(wallKicks)
+	{
+	case WallKicks::None:
+		return &Simulation::stepWith<RulePolicy<TRotation, WallKicks::None>>;
+	case WallKicks::Arika:
+		return &Simulation::stepWith<RulePolicy<TRotation, WallKicks::Arika>>;
+	default:
+	case WallKicks::Super:
+		return &Simulation::stepWith<RulePolicy<TRotation, WallKicks::Super>>;
+	}
+}
+
+/**
+ * @return Simulation::stepWith instantiated for the RulePolicy of the rules
+ */
+Simulation::StepFunc selectStep(RotationSystem rotationSystem, WallKicks wallKicks)
+{
+	switch(rotationSystem)
+	{
+	case RotationSystem::Original:
+		return selectStep<RotationSystem::Original>(wallKicks);
+	case RotationSystem::Arika:
+		return selectStep<RotationSystem::Arika>(wallKicks);
+	case RotationSystem::Sega:
+		return selectStep<RotationSystem::Sega>(wallKicks);
+	case RotationSystem::NintendoLeft:
+		return selectStep<RotationSystem::NintendoLeft>(wallKicks);
+	case RotationSystem::NintendoRight:
+		return selectStep<RotationSystem::NintendoRight>(wallKicks);
+	case RotationSystem::Super:
+		return selectStep<RotationSystem::Super>(wallKicks);
+	}
+	throw std::runtime_error{"Invalid RotationSystem value"};
+}
+
+Simulation::Simulation(
+    const Settings& gameSettings, uint64_t seed, const PieceColors& colors, Grid::Cell garbageCell) :
+    settings{gameSettings},
+    playfield{playfieldSize(settings), 0},
+    baseTetrominos{prepareTetrominos(makeBaseMinos(settings.rotationSystem)(), colors, playfield.getSize().width)},
+    holdPieceIdx{NO_HOLD_PIECE},
+    rng{seed},
+    shuffledIndices{makeShuffledIndices(settings.shuffleType)(baseTetrominos)},
+    nextTetrominoIndices{fillIndices(settings.previewCount)},
+    currentTetromino{getNextTetromino(settings.previewCount)},
+    scoringSystem{makeScoringSystem(settings.scoringSystem)()},
+    score{0},
+    levelUpFunc{levelUp(settings.levelGoal)},
+    levelState{LevelState::make(settings.levelGoal)},
+    lockDelay{settings.lockDown == LockDown::Instant ? 0 : Settings::LOCK_DELAY},
+    lockCounter{0},
+    isLocking{false},
+    holdPieceLocked{false},
+    isGameOver{false},
+    lockedPieces{0},
+    lineClears{},
+    tSpinFunc{tSpinCheck(settings.tSpin)},
+    gravity{DELAYS.front()},
+    moveRight{Settings::DELAYED_AUTO_SHIFT, Settings::AUTO_REPEAT_RATE, InputSnapshot::MoveRight,
+        InputSnapshot::MoveLeft},
+    rotateRight{Settings::DELAYED_AUTO_SHIFT, Settings::AUTO_REPEAT_RATE, InputSnapshot::RotateRight,
+        InputSnapshot::RotateLeft},
+    garbageRng{static_cast<uint32_t>(seed)},
+    pendingGarbage{0},
+    linesSent{0},
+    garbageColor{garbageCell},
+    stepFunc{selectStep(settings.rotationSystem, settings.wallKicks)}
+{
+}
+
+Simulation::Snapshot Simulation::save() const noexcept
+{
+	Snapshot snapshot{{}, holdPieceIdx, rng, shuffledIndices, nextTetrominoIndices, currentTetromino, scoringSystem,
+	    score, levelState, lockDelay, lockCounter, isLocking, holdPieceLocked, isGameOver, lockedPieces, lineClears,
+	    gravity, moveRight, rotateRight, garbageRng, pendingGarbage, linesSent};
+	playfield.save(snapshot.playfield);
+	return snapshot;
+}
+
+void Simulation::restore(const Snapshot& snapshot) noexcept
+{
+	playfield.restore(snapshot.playfield);
+	holdPieceIdx = snapshot.holdPieceIdx;
+	rng = snapshot.rng;
+	shuffledIndices = snapshot.shuffledIndices;
+	nextTetrominoIndices = snapshot.nextTetrominoIndices;
+	currentTetromino = snapshot.currentTetromino;
+	scoringSystem = snapshot.scoringSystem;
+	score = snapshot.score;
+	levelState = snapshot.levelState;
+	lockDelay = snapshot.lockDelay;
+	lockCounter = snapshot.lockCounter;
+	isLocking = snapshot.isLocking;
+	holdPieceLocked = snapshot.holdPieceLocked;
+	isGameOver = snapshot.isGameOver;
+	lockedPieces = snapshot.lockedPieces;
+	lineClears = snapshot.lineClears;
+	gravity = snapshot.gravity;
+	moveRight = snapshot.moveRight;
+	rotateRight = snapshot.rotateRight;
+	garbageRng = snapshot.garbageRng;
+	pendingGarbage = snapshot.pendingGarbage;
+	linesSent = snapshot.linesSent;
+}
+
+void Simulation::queueGarbage(uint32_t lines) noexcept
+{
+	pendingGarbage += lines;
+}
+
+uint64_t Simulation::positionHash() const noexcept
+{
+	const size_t previews = std::min<size_t>(settings.previewCount, nextTetrominoIndices.size());
+	return playfield.getHash() ^
+	       zobrist::piece(static_cast<size_t>(currentTetromino.type), currentTetromino.position.x,
+	           currentTetromino.position.y, currentTetromino.rotation) ^
+	       zobrist::hold(holdPieceIdx, holdPieceLocked) ^
+	       zobrist::queue(nextTetrominoIndices.begin(), nextTetrominoIndices.begin() + previews);
+}
+
+void Simulation::step(float delta, const InputSnapshot& input)
+{
+	(this->*stepFunc)(delta, input);
+}
+
+template<typename TRules>
+void Simulation::stepWith(float delta, const InputSnapshot& input)
+{
+	if(isGameOver)
+	{
+		return;
+	}
+
+	if(settings.holdPiece && !holdPieceLocked && input.isPressed(InputSnapshot::Hold))
+	{
+		if(holdPieceIdx == NO_HOLD_PIECE)
+		{
+			holdPieceIdx = static_cast<size_t>(currentTetromino.type);
+			currentTetromino = getNextTetromino(settings.previewCount);
+		}
+		else
+		{
+			const auto nextHoldIdx = static_cast<size_t>(currentTetromino.type);
+			currentTetromino = baseTetrominos[holdPieceIdx];
+			holdPieceIdx = nextHoldIdx;
+		}
+		isLocking = false;
+		lockCounter = 0;
+		holdPieceLocked = true;
+	}
+
+	Offset prevTetrominoOffset = currentTetromino;
+	const bool isSoftDropping = input.isDown(InputSnapshot::SoftDrop);
+
+	gravity.delay = DELAYS[std::min<size_t>((isSoftDropping ? 2 : 0) + levelState.currentLevel, MAX_SPEED_LEVEL)];
+
+	if(const KeyAction::Return moveAction = moveRight.tick(delta, input); isKeyPress(moveAction))
+	{
+		if(playfield.overlapAt(currentTetromino.position + XY{moveAction.value, 0}, currentTetromino.collision()) == 0)
+		{
+			currentTetromino.position += XY{moveAction.value, 0};
+			if(isLocking && settings.lockDown <= LockDown::Extended)
+			{
+				if(settings.lockDown == LockDown::Infinit || lockCounter < LOCKDOWN_MAX_RESET)
+				{
+					lockCounter += 1;
+					lockDelay.reset(0);
+				}
+			}
+		}
+	}
+	if(const KeyAction::Return rotateAction = rotateRight.tick(delta, input); isKeyPress(rotateAction))
+	{
+		Offset rotation = TRules::rotate(currentTetromino, rotateAction.value);
+		currentTetromino += rotation;
+		if(playfield.overlapAt(currentTetromino.position, currentTetromino.collision()) != 0)
+		{
+			currentTetromino -= rotation;
+			rotation = TRules::kick(playfield, currentTetromino, rotation);
+			currentTetromino += rotation;
+		}
+		if(isLocking && settings.lockDown <= LockDown::Extended && rotation != Offset{})
+		{
+			if(settings.lockDown == LockDown::Infinit || lockCounter < LOCKDOWN_MAX_RESET)
+			{
+				lockCounter += 1;
+				lockDelay.reset(0);
+			}
+		}
+	}
+	const bool isTwentyG = gravity.delay <= TWENTY_G_DELAY;
+	if(const uint32_t gravitySteps = gravity.step(delta); gravitySteps != 0 || isTwentyG)
+	{
+		const auto fallDistance =
+		    static_cast<uint32_t>(playfield.dropDistance(currentTetromino.position, currentTetromino.collision()));
+		const uint32_t rows = isTwentyG ? fallDistance : std::min(gravitySteps, fallDistance);
+		if(rows > 0)
+		{
+			currentTetromino.position += XY{0, static_cast<int>(rows)};
+			if(isSoftDropping)
+			{
+				score += scoringSystem.process(ScoreEvent::SoftDrop, 1, levelState.currentLevel) * rows;
+			}
+			if(isLocking)
+			{
+				switch(settings.lockDown)
+				{
+				case LockDown::Infinit:
+					lockDelay.reset(0);
+					break;
+				case LockDown::Extended:
+					if(lockCounter < LOCKDOWN_MAX_RESET)
+					{
+						lockCounter += 1;
+						lockDelay.reset(0);
+					}
+					break;
+				case LockDown::Classic:
+					lockDelay.reset(0);
+					break;
+				case LockDown::Entry:
+				case LockDown::Instant:
+					break;
+				}
+			}
+		}
+		else if(isSoftDropping && settings.softDrop == SoftDrop::Locking)
+		{
+			isLocking = true;
+			lockDelay.reset(lockDelay.delay);
+		}
+	}
+	if(settings.instantDrop != InstantDrop::None && input.isPressed(InputSnapshot::HardDrop))
+	{
+		const int dropDistance = playfield.dropDistance(currentTetromino.position, currentTetromino.collision());
+		currentTetromino.position += XY{0, dropDistance};
+		prevTetrominoOffset = currentTetromino;
+		score +=
+		    scoringSystem.process(ScoreEvent::HardDrop, static_cast<uint32_t>(dropDistance), levelState.currentLevel);
+		if(settings.instantDrop == InstantDrop::Hard)
+		{
+			isLocking = true;
+			lockDelay.reset(lockDelay.delay);
+		}
+	}
+
+	const bool onGround = playfield.overlapAt(currentTetromino.position + XY{0, 1}, currentTetromino.collision()) != 0;
+
+	if(!isLocking && onGround)
+	{
+		isLocking = true;
+		lockDelay.reset(0);
+	}
+	if(isLocking && !onGround && settings.lockDown == LockDown::Entry)
+	{
+		lockDelay.tick(delta);
+	}
+	if(isLocking && onGround && lockDelay.tick(delta))
+	{
+		const ScoreEvent scoreEvent = tSpinFunc(playfield, currentTetromino, currentTetromino - prevTetrominoOffset);
+
+		playfield.setAt(currentTetromino.position, currentTetromino.collision());
+
+		const uint32_t linesCleared = eraseFullLines(playfield);
+		lockedPieces += 1;
+		lineClears[std::min<size_t>(linesCleared, lineClears.size() - 1)] += 1;
+		score += scoringSystem.process(scoreEvent, linesCleared, levelState.currentLevel);
+		levelState = levelUpFunc(scoreEvent, linesCleared, levelState);
+		uint32_t attack = attackLines(scoreEvent, linesCleared);
+		if(isEmpty(playfield))
+		{
+			score += scoringSystem.process(ScoreEvent::PerfectClear, linesCleared, levelState.currentLevel);
+			attack += attackLines(ScoreEvent::PerfectClear, linesCleared);
+		}
+		const uint32_t cancelled = std::min(attack, pendingGarbage);
+		pendingGarbage -= cancelled;
+		linesSent += attack - cancelled;
+		bool isToppedOut = false;
+		if(linesCleared == 0 && pendingGarbage > 0)
+		{
+			const int gapColumn = std::uniform_int_distribution<int>{0, playfield.getSize().width - 1}(garbageRng);
+			isToppedOut = playfield.pushUp(static_cast<int>(pendingGarbage), garbageColor, gapColumn);
+			pendingGarbage = 0;
+		}
+
+		isLocking = false;
+		holdPieceLocked = false;
+		lockCounter = 0;
+		currentTetromino = getNextTetromino(settings.previewCount);
+		isGameOver =
+		    isToppedOut || playfield.overlapAt(currentTetromino.position, currentTetromino.collision()) != 0;
+	}
+}
+
+IndexQueue Simulation::fillIndices(size_t minIndices)
+{
+	IndexQueue indices;
+	shuffledIndices.fill(indices, minIndices, rng);
+	return indices;
+}
+
+Tetromino Simulation::getNextTetromino(size_t minIndices)
+{
+	minIndices = minIndices == 0 ? 1 : minIndices;
+	const size_t nextIdx = nextTetrominoIndices.front();
+	nextTetrominoIndices.pop_front();
+	shuffledIndices.fill(nextTetrominoIndices, minIndices, rng);
+	return baseTetrominos[nextIdx];
+}
+} // namespace raymino
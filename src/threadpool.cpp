@@ -0,0 +1,152 @@
+#include "threadpool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace raymino
+{
+ThreadPool::ThreadPool(size_t threadCount)
+{
+	threadCount = std::max<size_t>(threadCount, 1);
+	queues.reserve(threadCount);
+	for(size_t idx = 0; idx < threadCount; ++idx)
+	{
+		queues.push_back(std::make_unique<Queue>());
+	}
+	workers.reserve(threadCount);
+	for(size_t idx = 0; idx < threadCount; ++idx)
+	{
+		workers.emplace_back(&ThreadPool::work, this, idx);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		const std::lock_guard lock(stateMutex);
+		isStopping = true;
+	}
+	wakeWorkers.notify_all();
+	for(std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+void ThreadPool::submit(Task task)
+{
+	Queue& queue = *queues[nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size()];
+	{
+		// same lock order as tryTake, the task can't be taken before it is counted
+		const std::lock_guard lock(queue.mutex);
+		queue.tasks.push_back(std::move(task));
+		const std::lock_guard stateLock(stateMutex);
+		++queued;
+		++pending;
+	}
+	wakeWorkers.notify_one();
+}
+
+void ThreadPool::wait()
+{
+	Task task;
+	while(tryTake(0, task))
+	{
+		run(task);
+	}
+	std::unique_lock lock(stateMutex);
+	allDone.wait(lock,
+	    [this]
+	    {
+		    return pending == 0;
+	    });
+	if(firstException)
+	{
+		std::rethrow_exception(std::exchange(firstException, nullptr));
+	}
+}
+
+void ThreadPool::work(size_t queueIdx)
+{
+	Task task;
+	while(true)
+	{
+		if(tryTake(queueIdx, task))
+		{
+			run(task);
+			continue;
+		}
+		std::unique_lock lock(stateMutex);
+		wakeWorkers.wait(lock,
+		    [this]
+		    {
+			    return queued != 0 || isStopping;
+		    });
+		if(queued == 0 && isStopping)
+		{
+			return;
+		}
+	}
+}
+
+bool ThreadPool::tryTake(size_t queueIdx, Task& task)
+{
+	for(size_t offset = 0; offset < queues.size(); ++offset)
+	{
+		const bool isOwn = offset == 0;
+		Queue& queue = *queues[(queueIdx + offset) % queues.size()];
+		const std::lock_guard lock(queue.mutex);
+		if(queue.tasks.empty())
+		{
+			continue;
+		}
+		if(isOwn)
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+		}
+		else
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+		}
+		const std::lock_guard stateLock(stateMutex);
+		--queued;
+		return true;
+	}
+	return false;
+}
+
+void ThreadPool::run(Task& task) noexcept
+{
+	std::exception_ptr exception;
+	try
+	{
+		task();
+	}
+	catch(...)
+	{
+		exception = std::current_exception();
+	}
+	task = nullptr;
+	bool isLast = false;
+	{
+		const std::lock_guard lock(stateMutex);
+		if(exception && !firstException)
+		{
+			firstException = exception;
+		}
+		--pending;
+		isLast = pending == 0;
+	}
+	if(isLast)
+	{
+		allDone.notify_all();
+	}
+}
+} // namespace raymino
@@ -0,0 +1,232 @@
+#include "versus-game.hpp"
+
+#include "app.hpp"
+#include "game.hpp"
+#include "graphics.hpp"
+#include "grid.hpp"
+#include "input.hpp"
+#include "scenes.hpp"
+#include "simulation.hpp"
+#include "types.hpp"
+#include "versus.hpp"
+
+#include <raylib.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace raymino
+{
+template<>
+std::unique_ptr<IScene> MakeScene<Scene::Versus>(App& app)
+{
+	return std::make_unique<VersusGame>(app);
+}
+
+constexpr int HIDDEN_HEIGHT = Simulation::HIDDEN_HEIGHT;
+constexpr int HEADER_HEIGHT = 40;
+constexpr int FOOTER_HEIGHT = 24;
+constexpr int GARBAGE_BAR_WIDTH = 8;
+constexpr int FIELD_BORDER_WIDTH = 2;
+constexpr int SCORE_FONT_SIZE = 20;
+constexpr int STATS_FONT_SIZE = 10;
+constexpr int STATUS_FONT_SIZE = 40;
+constexpr ::Color STATUS_BACKGROUND{77, 77, 77, 222};
+
+/**
+ * @return bounds of the visible playfield of a player, every player gets an equal column of the screen
+ */
+Rect calculateVersusBounds(Size fieldSize, size_t playerIdx) noexcept
+{
+	constexpr int columnWidth = App::Settings::SCREEN_WIDTH / static_cast<int>(VersusGame::PLAYER_COUNT);
+	constexpr int availableWidth = columnWidth - ((GARBAGE_BAR_WIDTH + FIELD_BORDER_WIDTH) * 2);
+	constexpr int availableHeight =
+	    App::Settings::SCREEN_HEIGHT - HEADER_HEIGHT - FOOTER_HEIGHT - (FIELD_BORDER_WIDTH * 2);
+	const int cellSize = std::min(availableWidth / fieldSize.width, availableHeight / fieldSize.height);
+	const int actualWidth = cellSize * fieldSize.width;
+	const int actualHeight = cellSize * fieldSize.height;
+	const int xOffset = (columnWidth * static_cast<int>(playerIdx)) + GARBAGE_BAR_WIDTH + FIELD_BORDER_WIDTH +
+	                    ((availableWidth - actualWidth) / 2);
+	const int yOffset = HEADER_HEIGHT + FIELD_BORDER_WIDTH + ((availableHeight - actualHeight) / 2);
+
+	return {{xOffset, yOffset}, {actualWidth, actualHeight}};
+}
+
+VersusGame::VersusGame(App& app) :
+    session{app.settings(), hashSeedString(app.seed), PLAYER_COUNT, makePieceColors(), minoColors[GRAY]},
+    transport{LATENCY_TICKS},
+    secondKeyBinds{secondPlayerKeyBinds()},
+    playfieldBounds{},
+    pendingInputs{},
+    lastResimulated{0},
+    maxResimulated{0},
+    state{State::Running}
+{
+	for(size_t idx = 0; idx < PLAYER_COUNT; ++idx)
+	{
+		playfieldBounds[idx] = calculateVersusBounds({app.settings().fieldWidth, app.settings().fieldHeight}, idx);
+	}
+}
+
+App::KeyBinds VersusGame::secondPlayerKeyBinds() noexcept
+{
+	App::KeyBinds keyBinds;
+	keyBinds.moveRight = KEY_D;
+	keyBinds.moveLeft = KEY_A;
+	keyBinds.rotateRight = KEY_E;
+	keyBinds.rotateLeft = KEY_Q;
+	keyBinds.softDrop = KEY_S;
+	keyBinds.hardDrop = KEY_W;
+	keyBinds.hold = KEY_TAB;
+	return keyBinds;
+}
+
+void VersusGame::PreDestruct([[maybe_unused]] App& app)
+{
+	// versus sessions are neither recorded nor scored
+}
+
+bool VersusGame::isAllocationFree() const noexcept
+{
+	return state != State::GameOver;
+}
+
+void VersusGame::Update(App& app)
+{
+	const App::KeyBinds& keyBinds = app.keyBinds();
+
+	if(::IsKeyPressed(keyBinds.menu))
+	{
+		app.QueueSceneSwitch(Scene::Menu);
+		state = State::GameOver;
+	}
+	if(::IsKeyPressed(keyBinds.restart))
+	{
+		app.QueueSceneSwitch(Scene::Versus);
+	}
+	if(::IsKeyPressed(keyBinds.pause))
+	{
+		switch(state)
+		{
+		case State::Running:
+			state = State::Paused;
+			break;
+		case State::Paused:
+			state = State::Running;
+			break;
+		case State::GameOver:
+			app.QueueSceneSwitch(Scene::Versus);
+			break;
+		}
+	}
+	if(state == State::Running && !::IsWindowFocused())
+	{
+		state = State::Paused;
+	}
+
+	if(state == State::Running)
+	{
+		pendingInputs[0].merge(pollInput(keyBinds));
+		pendingInputs[1].merge(pollInput(secondKeyBinds));
+	}
+}
+
+void VersusGame::FixedUpdate([[maybe_unused]] App& app)
+{
+	if(state != State::Running)
+	{
+		return;
+	}
+
+	LoopbackTransport::Packet packet{};
+	while(transport.receive(session.tick(), packet))
+	{
+		session.addInput(packet.player, packet.tick, packet.input);
+	}
+	if(session.isStalled())
+	{
+		return;
+	}
+	const uint32_t tick = session.tick();
+	session.addInput(0, tick, pendingInputs[0]);
+	transport.send({1, tick, pendingInputs[1]});
+	for(InputSnapshot& input : pendingInputs)
+	{
+		input.consumeEdges();
+	}
+	session.advance();
+	if(session.resimulatedTicks() > 0)
+	{
+		lastResimulated = session.resimulatedTicks();
+		maxResimulated = std::max(maxResimulated, lastResimulated);
+	}
+	if(session.isFinished())
+	{
+		state = State::GameOver;
+	}
+}
+
+void VersusGame::Draw([[maybe_unused]] App& app)
+{
+	::ClearBackground(LIGHTGRAY);
+
+	for(size_t idx = 0; idx < PLAYER_COUNT; ++idx)
+	{
+		const Simulation& shown = session.player(idx);
+		const Rect& bounds = playfieldBounds[idx];
+		const Grid& playfield = shown.playfield;
+		const Tetromino& currentTetromino = shown.currentTetromino;
+		const int cellSize = (bounds.width / playfield.getSize().width) - 1;
+		const XY hiddenOffset{0, (cellSize + 1) * HIDDEN_HEIGHT};
+		drawBackground(playfield, bounds - hiddenOffset, cellSize, 1, LIGHTGRAY, DARKGRAY);
+		drawCells(playfield, bounds - hiddenOffset, cellSize, 1, minoColors);
+		if(shown.settings.ghostPiece)
+		{
+			const int yOffset = playfield.dropDistance(currentTetromino.position, currentTetromino.collision());
+			drawCells(currentTetromino.collision(),
+			    ((currentTetromino.position - XY{0, HIDDEN_HEIGHT - yOffset}) * (cellSize + 1)) + bounds, cellSize, 1,
+			    minoColors, 96);
+		}
+		drawCells(currentTetromino.collision(),
+		    ((currentTetromino.position - XY{0, HIDDEN_HEIGHT}) * (cellSize + 1)) + bounds, cellSize, 1, minoColors);
+		::DrawRectangle(bounds.x, 0, bounds.width, bounds.y - FIELD_BORDER_WIDTH, LIGHTGRAY);
+		::DrawRectangleLinesEx({static_cast<float>(bounds.x - FIELD_BORDER_WIDTH),
+		                           static_cast<float>(bounds.y - FIELD_BORDER_WIDTH),
+		                           static_cast<float>(bounds.width + (FIELD_BORDER_WIDTH * 2) - 1),
+		                           static_cast<float>(bounds.height + (FIELD_BORDER_WIDTH * 2) - 1)},
+		    FIELD_BORDER_WIDTH, DARKGRAY);
+
+		const int garbageHeight = std::min(static_cast<int>(shown.pendingGarbage) * (cellSize + 1), bounds.height);
+		::DrawRectangle(bounds.x - FIELD_BORDER_WIDTH - GARBAGE_BAR_WIDTH, bounds.y + bounds.height - garbageHeight,
+		    GARBAGE_BAR_WIDTH, garbageHeight, RED);
+
+		const char* scoreText = ::TextFormat("P%u  %lld  sent %u", static_cast<unsigned>(idx + 1),
+		    static_cast<long long>(shown.score), shown.linesSent);
+		::DrawText(scoreText, bounds.x + ((bounds.width - ::MeasureText(scoreText, SCORE_FONT_SIZE)) / 2),
+		    (HEADER_HEIGHT - SCORE_FONT_SIZE) / 2, SCORE_FONT_SIZE, shown.isGameOver ? RED : DARKGRAY);
+	}
+
+	const char* statsText = ::TextFormat("tick %u  rollback last %u max %u ticks  latency %u ticks", session.tick(),
+	    lastResimulated, maxResimulated, transport.latency);
+	::DrawText(statsText, (App::Settings::SCREEN_WIDTH - ::MeasureText(statsText, STATS_FONT_SIZE)) / 2,
+	    App::Settings::SCREEN_HEIGHT - ((FOOTER_HEIGHT + STATS_FONT_SIZE) / 2), STATS_FONT_SIZE, DARKGRAY);
+
+	if(state != State::Running)
+	{
+		const size_t winner = session.winner();
+		const char* statusText = state == State::Paused            ? "Paused"
+		                         : winner == VersusSession::NO_WINNER ? "Draw"
+		                                                              : ::TextFormat("P%u wins",
+		                                                                    static_cast<unsigned>(winner + 1));
+		const int statusTextWidth = ::MeasureText(statusText, STATUS_FONT_SIZE);
+		const int padding = STATUS_FONT_SIZE / 4;
+		::DrawRectangle(((App::Settings::SCREEN_WIDTH - statusTextWidth) / 2) - padding,
+		    ((App::Settings::SCREEN_HEIGHT - STATUS_FONT_SIZE) / 2) - padding, statusTextWidth + (padding * 2),
+		    STATUS_FONT_SIZE + (padding * 2), STATUS_BACKGROUND);
+		::DrawText(statusText, (App::Settings::SCREEN_WIDTH - statusTextWidth) / 2,
+		    (App::Settings::SCREEN_HEIGHT - STATUS_FONT_SIZE) / 2, STATUS_FONT_SIZE, RED);
+	}
+}
+} // namespace raymino
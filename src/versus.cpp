@@ -0,0 +1,209 @@
+#include "versus.hpp"
+
+#include "grid.hpp"
+#include "input.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace raymino
+{
+VersusSession::VersusSession(
+    const Settings& settings, uint64_t seed, size_t playerCount, const PieceColors& colors, Grid::Cell garbageCell) :
+    players(playerCount, Simulation{settings, seed, colors, garbageCell}),
+    snapshots(static_cast<size_t>(ROLLBACK_TICKS) * playerCount, players.front().save()),
+    inputs(static_cast<size_t>(INPUT_TICKS) * playerCount),
+    confirmedTicks(playerCount, 0),
+    sentBefore(playerCount, 0)
+{
+}
+
+bool VersusSession::addInput(size_t playerIdx, uint32_t inputTick, const InputSnapshot& input) noexcept
+{
+	if(playerIdx >= players.size() || inputTick != confirmedTicks[playerIdx] ||
+	    inputTick >= currentTick + ROLLBACK_TICKS)
+	{
+		return false;
+	}
+	InputSnapshot& stored = inputAt(playerIdx, inputTick);
+	if(inputTick < currentTick && stored != input)
+	{
+		rollbackTick = std::min(rollbackTick, inputTick);
+	}
+	stored = input;
+	confirmedTicks[playerIdx] = inputTick + 1;
+	return true;
+}
+
+bool VersusSession::isStalled() const noexcept
+{
+	return std::any_of(confirmedTicks.begin(), confirmedTicks.end(),
+	    [this](uint32_t confirmed)
+	    {
+		    return confirmed + ROLLBACK_TICKS <= currentTick;
+	    });
+}
+
+bool VersusSession::advance() noexcept
+{
+	resimulated = 0;
+	if(isStalled())
+	{
+		return false;
+	}
+	if(rollbackTick < currentTick)
+	{
+		if(decidedTick > rollbackTick)
+		{
+			// the result was predicted, the resimulation decides it again
+			decidedTick = UNDECIDED;
+			decidedWinner = NO_WINNER;
+		}
+		for(size_t idx = 0; idx < players.size(); ++idx)
+		{
+			players[idx].restore(snapshotAt(idx, rollbackTick));
+		}
+		for(uint32_t resimulatedTick = rollbackTick; resimulatedTick < currentTick; ++resimulatedTick)
+		{
+			simulate(resimulatedTick);
+			++resimulated;
+		}
+	}
+	rollbackTick = NO_ROLLBACK;
+	simulate(currentTick);
+	++currentTick;
+	return true;
+}
+
+void VersusSession::simulate(uint32_t simulatedTick) noexcept
+{
+	for(size_t idx = 0; idx < players.size(); ++idx)
+	{
+		snapshotAt(idx, simulatedTick) = players[idx].save();
+		InputSnapshot& input = inputAt(idx, simulatedTick);
+		if(simulatedTick >= confirmedTicks[idx])
+		{
+			// predict that the buttons stay as they were last known
+			input = confirmedTicks[idx] == 0 ? InputSnapshot{} : inputAt(idx, confirmedTicks[idx] - 1);
+			input.consumeEdges();
+		}
+		sentBefore[idx] = players[idx].linesSent;
+		players[idx].step(Settings::TICK_SECONDS, input);
+	}
+	// garbage goes to the next player still in the game, exchanged after everyone stepped so order does not matter
+	for(size_t idx = 0; idx < players.size(); ++idx)
+	{
+		const uint32_t sent = players[idx].linesSent - sentBefore[idx];
+		for(size_t offset = 1; sent > 0 && offset < players.size(); ++offset)
+		{
+			Simulation& target = players[(idx + offset) % players.size()];
+			if(!target.isGameOver)
+			{
+				target.queueGarbage(sent);
+				break;
+			}
+		}
+	}
+	decide(simulatedTick);
+}
+
+void VersusSession::decide(uint32_t simulatedTick) noexcept
+{
+	if(decidedTick != UNDECIDED)
+	{
+		return;
+	}
+	const auto alive = static_cast<size_t>(std::count_if(players.begin(), players.end(),
+	    [](const Simulation& simulation)
+	    {
+		    return !simulation.isGameOver;
+	    }));
+	if(alive == 0 || (players.size() > 1 && alive == 1))
+	{
+		decidedTick = simulatedTick + 1;
+		const auto winnerIt = std::find_if(players.begin(), players.end(),
+		    [](const Simulation& simulation)
+		    {
+			    return !simulation.isGameOver;
+		    });
+		decidedWinner =
+		    winnerIt == players.end() ? NO_WINNER : static_cast<size_t>(std::distance(players.begin(), winnerIt));
+	}
+}
+
+InputSnapshot& VersusSession::inputAt(size_t playerIdx, uint32_t inputTick) noexcept
+{
+	return inputs[((inputTick % INPUT_TICKS) * players.size()) + playerIdx];
+}
+
+Simulation::Snapshot& VersusSession::snapshotAt(size_t playerIdx, uint32_t snapshotTick) noexcept
+{
+	return snapshots[((snapshotTick % ROLLBACK_TICKS) * players.size()) + playerIdx];
+}
+
+uint32_t VersusSession::tick() const noexcept
+{
+	return currentTick;
+}
+
+uint32_t VersusSession::confirmedTick(size_t playerIdx) const noexcept
+{
+	return confirmedTicks[playerIdx];
+}
+
+uint32_t VersusSession::resimulatedTicks() const noexcept
+{
+	return resimulated;
+}
+
+bool VersusSession::isFinished() const noexcept
+{
+	const bool isConfirmed = std::all_of(confirmedTicks.begin(), confirmedTicks.end(),
+	    [this](uint32_t confirmed)
+	    {
+		    return confirmed >= decidedTick;
+	    });
+	// a mismatching input before decidedTick was confirmed but not rolled back yet
+	return decidedTick != UNDECIDED && isConfirmed && rollbackTick >= decidedTick;
+}
+
+size_t VersusSession::winner() const noexcept
+{
+	return isFinished() ? decidedWinner : NO_WINNER;
+}
+
+size_t VersusSession::playerCount() const noexcept
+{
+	return players.size();
+}
+
+const Simulation& VersusSession::player(size_t playerIdx) const noexcept
+{
+	return players[playerIdx];
+}
+
+LoopbackTransport::LoopbackTransport(uint32_t latencyTicks) noexcept : latency{latencyTicks}
+{
+}
+
+void LoopbackTransport::send(const Packet& packet)
+{
+	inFlight.push_back(packet);
+}
+
+bool LoopbackTransport::receive(uint32_t now, Packet& packet) noexcept
+{
+	if(inFlight.empty() || inFlight.front().tick + latency > now)
+	{
+		return false;
+	}
+	packet = inFlight.front();
+	inFlight.pop_front();
+	return true;
+}
+} // namespace raymino
@@ -0,0 +1,113 @@
+#include "bot.hpp"
+
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "helpers.hpp"
+#include "placement.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "threadpool.hpp"
+#include "types.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <numeric>
+
+using namespace raymino;
+using namespace raymino::testing;
+
+namespace
+{
+/**
+ * @brief play until maxPieces are locked or the game is lost
+ */
+void play(Simulation& simulation, Bot& bot, uint32_t maxPieces)
+{
+	for(int step = 0; step < 100000 && !simulation.isGameOver && simulation.lockedPieces < maxPieces; ++step)
+	{
+		simulation.step(Settings::TICK_SECONDS, bot.next(simulation));
+	}
+}
+} // namespace
+
+TEST_CASE("boardFeatures", "[Bot]")
+{
+	// 4 hidden rows on top, column heights 2 0 3 1 & a hole in the third column
+	const Grid field{{4, 8}, {
+	                             0, 0, 0, 0, //
+	                             0, 0, 0, 0, //
+	                             0, 0, 0, 0, //
+	                             0, 0, 0, 0, //
+	                             0, 0, 0, 0, //
+	                             0, 0, 1, 0, //
+	                             1, 0, 0, 0, //
+	                             1, 0, 1, 1, //
+	                         }};
+	const BoardFeatures features = boardFeatures(field);
+	REQUIRE(features.aggregateHeight == 6);
+	REQUIRE(features.holes == 1);
+	REQUIRE(features.bumpiness == 7);
+	REQUIRE(features.wellDepth == 2);
+	REQUIRE(features.hiddenCells == 0);
+	REQUIRE(boardFeatures(Grid{{4, 8}, 1}).hiddenCells == 16);
+}
+
+TEST_CASE("Bot::plan", "[Bot]")
+{
+	const Settings settings;
+	Simulation simulation{settings, 3, pieceColors};
+	const Size size = simulation.playfield.getSize();
+	simulation.playfield.setAt({0, size.height - 4}, Grid{{size.width - 1, 4}, 1});
+	simulation.currentTetromino = *find(simulation.baseTetrominos, TetrominoType::I);
+	Bot bot{settings, BotWeights{}, 0};
+
+	const Bot::Plan plan = bot.plan(simulation);
+	REQUIRE_FALSE(plan.useHold);
+	Grid field = simulation.playfield;
+	field.setAt(plan.target.position, simulation.currentTetromino.collision(plan.target.rotation));
+	REQUIRE(field.eraseFullRows() == 4);
+	REQUIRE(isEmpty(field));
+}
+
+TEST_CASE("Bot::next", "[Bot]")
+{
+	Settings settings;
+	settings.scoringSystem = ScoringSystem::Guideline;
+	Simulation simulation{settings, 11, pieceColors};
+	Bot bot{settings, BotWeights{}, 1};
+	play(simulation, bot, 150);
+	REQUIRE_FALSE(simulation.isGameOver);
+	REQUIRE(simulation.lockedPieces == 150);
+	REQUIRE(std::accumulate(simulation.lineClears.begin() + 1, simulation.lineClears.end(), uint32_t{0}) > 20);
+
+	// spreading the search changes nothing about the choices
+	ThreadPool pool{3};
+	Simulation threaded{settings, 11, pieceColors};
+	Bot threadedBot{settings, BotWeights{}, 1, &pool};
+	play(threaded, threadedBot, 150);
+	requireSameGame(threaded, simulation);
+}
+
+TEST_CASE("Bot rollouts", "[Bot]")
+{
+	for(const ShuffleType shuffleType : {ShuffleType::SingleBag, ShuffleType::TGM35})
+	{
+		Settings settings;
+		settings.shuffleType = shuffleType;
+		const BotRollouts rollouts{8, 3, 3};
+		Simulation simulation{settings, 5, pieceColors};
+		Bot bot{settings, BotWeights{}, 1, nullptr, rollouts};
+		play(simulation, bot, 60);
+		REQUIRE_FALSE(simulation.isGameOver);
+		REQUIRE(simulation.lockedPieces == 60);
+		REQUIRE(std::accumulate(simulation.lineClears.begin() + 1, simulation.lineClears.end(), uint32_t{0}) > 5);
+
+		// the sampled sequences depend on the position only
+		ThreadPool pool{3};
+		Simulation threaded{settings, 5, pieceColors};
+		Bot threadedBot{settings, BotWeights{}, 1, &pool, rollouts};
+		play(threaded, threadedBot, 60);
+		requireSameGame(threaded, simulation);
+	}
+}
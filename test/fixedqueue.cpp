@@ -0,0 +1,37 @@
+#include "fixedqueue.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+using namespace raymino;
+
+TEST_CASE("FixedQueue", "[FixedQueue]")
+{
+	FixedQueue<int, 4> queue;
+
+	STATIC_REQUIRE(std::is_trivially_copyable_v<decltype(queue)>);
+	REQUIRE(queue.empty());
+
+	queue.push_back(1);
+	queue.push_back(2);
+	queue.push_back(3);
+	REQUIRE(queue.size() == 3);
+	REQUIRE(queue.front() == 1);
+
+	queue.pop_front();
+	queue.pop_front();
+	queue.push_back(4);
+	queue.push_back(5);
+	queue.push_back(6);
+	REQUIRE(queue.size() == 4);
+	REQUIRE(queue.front() == 3);
+	REQUIRE(queue[3] == 6);
+	const std::array<int, 4> expected{3, 4, 5, 6};
+	REQUIRE(std::equal(queue.begin(), queue.end(), expected.begin(), expected.end()));
+
+	CHECK_THROWS(queue.push_back(7));
+}
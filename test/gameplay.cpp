@@ -2,6 +2,7 @@
 
 #include "grid.hpp"
 #include "ostream.hpp" //! needs to be included before catch
+#include "smallgrid.hpp"
 #include "types.hpp"
 
 #include <catch2/catch_get_random_seed.hpp>
@@ -9,16 +10,15 @@
 
 #include <algorithm>
 #include <cstddef>
-#include <deque>
+#include <cstdint>
 #include <initializer_list>
 #include <iterator>
-#include <memory>
 #include <random>
 #include <vector>
 
 using namespace raymino;
 
-bool allIndicesValid(const std::deque<size_t>& indices, size_t size)
+bool allIndicesValid(const IndexQueue& indices, size_t size)
 {
 	return std::all_of(indices.begin(), indices.end(),
 	    [size](size_t idx)
@@ -27,6 +27,25 @@ bool allIndicesValid(const std::deque<size_t>& indices, size_t size)
 	    });
 }
 
+TEST_CASE("Tetromino::collision", "[gameplay]")
+{
+	const PieceGrid shape{{3, 3}, {0, 1, 0, 1, 1, 1, 0, 0, 0}};
+	Tetromino tetromino{{}, TetrominoType::T, shape};
+
+	for(int rotation = -5; rotation <= 5; ++rotation)
+	{
+		PieceGrid expected{shape};
+		expected.rotate(rotation);
+		REQUIRE(tetromino.collision(rotation) == expected);
+	}
+
+	tetromino += Offset{{1, 2}, 3};
+	REQUIRE(tetromino.position == XY{1, 2});
+	REQUIRE(tetromino.collision() == tetromino.collision(-1));
+	tetromino -= Offset{{1, 2}, 3};
+	REQUIRE(tetromino.collision() == shape);
+}
+
 TEST_CASE("findTrueSize", "[gameplay]")
 {
 	{
@@ -396,173 +415,181 @@ TEST_CASE("tSpinCheck<Lenient>", "[gameplay][tSpinCheck]")
 	}
 }
 
-TEST_CASE("IScoringSystems", "[gameplay][IScoringSystem]")
+TEST_CASE("attackLines", "[gameplay]")
+{
+	REQUIRE(attackLines(ScoreEvent::LineClear, 1) == 0);
+	REQUIRE(attackLines(ScoreEvent::LineClear, 3) == 2);
+	REQUIRE(attackLines(ScoreEvent::LineClear, 4) == 4);
+	REQUIRE(attackLines(ScoreEvent::MiniTSpin, 1) == 0);
+	REQUIRE(attackLines(ScoreEvent::MiniTSpin, 2) == 1);
+	REQUIRE(attackLines(ScoreEvent::TSpin, 2) == 4);
+	REQUIRE(attackLines(ScoreEvent::PerfectClear, 1) == 10);
+	REQUIRE(attackLines(ScoreEvent::HardDrop, 20) == 0);
+}
+
+TEST_CASE("AnyScoringSystem", "[gameplay][AnyScoringSystem]")
 {
 	{
-		const std::unique_ptr<IScoringSystem> scoreSys = makeScoringSystem<ScoringSystem::BPS>();
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 2, 4) == 100);
-		REQUIRE(scoreSys->process(ScoreEvent::TSpin, 3, 1) == 300);
+		AnyScoringSystem scoreSys = makeScoringSystem<ScoringSystem::BPS>();
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 2, 4) == 100);
+		REQUIRE(scoreSys.process(ScoreEvent::TSpin, 3, 1) == 300);
 	}
 	{
-		const std::unique_ptr<IScoringSystem> scoreSys = makeScoringSystem<ScoringSystem::Sega>();
-		REQUIRE(scoreSys->process(ScoreEvent::PerfectClear, 3, 3) == 0);
-		REQUIRE(scoreSys->process(ScoreEvent::MiniTSpin, 2, 9) == 2000);
-		REQUIRE(scoreSys->process(ScoreEvent::SoftDrop, 7, 2) == 7);
+		AnyScoringSystem scoreSys = makeScoringSystem<ScoringSystem::Sega>();
+		REQUIRE(scoreSys.process(ScoreEvent::PerfectClear, 3, 3) == 0);
+		REQUIRE(scoreSys.process(ScoreEvent::MiniTSpin, 2, 9) == 2000);
+		REQUIRE(scoreSys.process(ScoreEvent::SoftDrop, 7, 2) == 7);
 	}
 	{
-		const std::unique_ptr<IScoringSystem> scoreSys = makeScoringSystem<ScoringSystem::Nintendo>();
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 4, 1) == 1200);
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 2, 3) == 300);
+		AnyScoringSystem scoreSys = makeScoringSystem<ScoringSystem::Nintendo>();
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 4, 1) == 1200);
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 2, 3) == 300);
 	}
 }
 
-TEST_CASE("IScoringSystem<Guideline>", "[gameplay][IScoringSystem]")
+TEST_CASE("AnyScoringSystem<Guideline>", "[gameplay][AnyScoringSystem]")
 {
 	{
-		const std::unique_ptr<IScoringSystem> scoreSys = makeScoringSystem<ScoringSystem::Guideline>();
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 3, 1) == 500);
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 1, 2) == 200 + 100);
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 2, 3) == 900 + 300);
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 0, 4) == 0);
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 4, 5) == 4000);
-	}
-	{
-		const std::unique_ptr<IScoringSystem> scoreSys = makeScoringSystem<ScoringSystem::Guideline>();
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 4, 1) == 800);
-		REQUIRE(scoreSys->process(ScoreEvent::TSpin, 2, 2) == (2400 + 100) + (1200 + 50));
-		REQUIRE(scoreSys->process(ScoreEvent::TSpin, 0, 3) == 1200 + 600);
-		REQUIRE(scoreSys->process(ScoreEvent::MiniTSpin, 0, 4) == 400);
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 4, 5) == 4000);
-	}
-	{
-		const std::unique_ptr<IScoringSystem> scoreSys = makeScoringSystem<ScoringSystem::Guideline>();
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 3, 1) == 500);
-		REQUIRE(scoreSys->process(ScoreEvent::PerfectClear, 3, 1) == 1800);
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 4, 1) == 800 + 50);
-		REQUIRE(scoreSys->process(ScoreEvent::PerfectClear, 4, 1) == 2000);
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 1, 1) == 100 + 100);
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 4, 1) == 800 + 150);
-		REQUIRE(scoreSys->process(ScoreEvent::PerfectClear, 4, 1) == 2000);
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 0, 1) == 0);
-		REQUIRE(scoreSys->process(ScoreEvent::LineClear, 4, 1) == 800);
-		REQUIRE(scoreSys->process(ScoreEvent::PerfectClear, 4, 1) == 3200);
-	}
-	{
-		const std::unique_ptr<IScoringSystem> scoreSys = makeScoringSystem<ScoringSystem::Guideline>();
-		REQUIRE(scoreSys->process(ScoreEvent::SoftDrop, 1, 1) == 1);
-		REQUIRE(scoreSys->process(ScoreEvent::SoftDrop, 2, 2) == 2);
-		REQUIRE(scoreSys->process(ScoreEvent::HardDrop, 3, 1) == 6);
-		REQUIRE(scoreSys->process(ScoreEvent::HardDrop, 2, 3) == 12);
+		AnyScoringSystem scoreSys = makeScoringSystem<ScoringSystem::Guideline>();
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 3, 1) == 500);
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 1, 2) == 200 + 100);
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 2, 3) == 900 + 300);
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 0, 4) == 0);
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 4, 5) == 4000);
+	}
+	{
+		AnyScoringSystem scoreSys = makeScoringSystem<ScoringSystem::Guideline>();
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 4, 1) == 800);
+		REQUIRE(scoreSys.process(ScoreEvent::TSpin, 2, 2) == (2400 + 100) + (1200 + 50));
+		REQUIRE(scoreSys.process(ScoreEvent::TSpin, 0, 3) == 1200 + 600);
+		REQUIRE(scoreSys.process(ScoreEvent::MiniTSpin, 0, 4) == 400);
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 4, 5) == 4000);
+	}
+	{
+		AnyScoringSystem scoreSys = makeScoringSystem<ScoringSystem::Guideline>();
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 3, 1) == 500);
+		REQUIRE(scoreSys.process(ScoreEvent::PerfectClear, 3, 1) == 1800);
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 4, 1) == 800 + 50);
+		REQUIRE(scoreSys.process(ScoreEvent::PerfectClear, 4, 1) == 2000);
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 1, 1) == 100 + 100);
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 4, 1) == 800 + 150);
+		REQUIRE(scoreSys.process(ScoreEvent::PerfectClear, 4, 1) == 2000);
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 0, 1) == 0);
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 4, 1) == 800);
+		REQUIRE(scoreSys.process(ScoreEvent::PerfectClear, 4, 1) == 3200);
+	}
+	{
+		AnyScoringSystem scoreSys = makeScoringSystem<ScoringSystem::Guideline>();
+		REQUIRE(scoreSys.process(ScoreEvent::SoftDrop, 1, 1) == 1);
+		REQUIRE(scoreSys.process(ScoreEvent::SoftDrop, 2, 2) == 2);
+		REQUIRE(scoreSys.process(ScoreEvent::HardDrop, 3, 1) == 6);
+		REQUIRE(scoreSys.process(ScoreEvent::HardDrop, 2, 3) == 12);
 	}
 }
 
-TEST_CASE("IShuffledIndices<Random>", "[gameplay]")
+TEST_CASE("AnyShuffledIndices<Random>", "[gameplay]")
 {
 	std::mt19937_64 rng(Catch::getSeed());
-	std::deque<size_t> indices;
+	IndexQueue indices;
 	const std::vector<Tetromino> baseTetrominos = makeBaseMinos<RotationSystem::Super>();
-	const std::unique_ptr<IShuffledIndices> iShuffledIndices = makeShuffledIndices(ShuffleType::Random)(baseTetrominos);
+	AnyShuffledIndices shuffledIndices = makeShuffledIndices(ShuffleType::Random)(baseTetrominos);
 	for(const size_t indicesToAdd : std::initializer_list<size_t>{7, 1, 3, 12, 14})
 	{
 		const size_t prevSize = indices.size();
 		const size_t targetMinSize = prevSize + indicesToAdd;
 
-		iShuffledIndices->fill(indices, targetMinSize, rng);
+		shuffledIndices.fill(indices, targetMinSize, rng);
 
 		REQUIRE(indices.size() >= targetMinSize);
 		REQUIRE(allIndicesValid(indices, baseTetrominos.size()));
 	}
 }
-TEST_CASE("IShuffledIndices<SingleBag>", "[gameplay]")
+TEST_CASE("AnyShuffledIndices<SingleBag>", "[gameplay]")
 {
 	std::mt19937_64 rng(Catch::getSeed());
-	std::deque<size_t> indices;
+	IndexQueue indices;
 	size_t targetMinSize = 0;
 	const std::vector<Tetromino> baseTetrominos = makeBaseMinos<RotationSystem::Arika>();
-	const std::unique_ptr<IShuffledIndices> iShuffledIndices =
-	    makeShuffledIndices(ShuffleType::SingleBag)(baseTetrominos);
+	AnyShuffledIndices shuffledIndices = makeShuffledIndices(ShuffleType::SingleBag)(baseTetrominos);
 
 	targetMinSize = targetMinSize + 1;
-	iShuffledIndices->fill(indices, targetMinSize, rng);
+	shuffledIndices.fill(indices, targetMinSize, rng);
 	REQUIRE(indices.size() >= targetMinSize);
 	REQUIRE(allIndicesValid(indices, baseTetrominos.size()));
 
 	targetMinSize = targetMinSize + 6;
-	iShuffledIndices->fill(indices, targetMinSize, rng);
+	shuffledIndices.fill(indices, targetMinSize, rng);
 	REQUIRE(indices.size() >= targetMinSize);
 	REQUIRE(allIndicesValid(indices, baseTetrominos.size()));
 
 	targetMinSize = targetMinSize + 14;
-	iShuffledIndices->fill(indices, targetMinSize, rng);
+	shuffledIndices.fill(indices, targetMinSize, rng);
 	REQUIRE(indices.size() >= targetMinSize);
 	REQUIRE(allIndicesValid(indices, baseTetrominos.size()));
 
 	REQUIRE(std::count(indices.begin(), indices.end(), indices.front()) == 3);
 }
-TEST_CASE("IShuffledIndices<DoubleBag>", "[gameplay]")
+TEST_CASE("AnyShuffledIndices<DoubleBag>", "[gameplay]")
 {
 	std::mt19937_64 rng(Catch::getSeed());
-	std::deque<size_t> indices;
+	IndexQueue indices;
 	size_t targetMinSize = 0;
 	const std::vector<Tetromino> baseTetrominos = makeBaseMinos<RotationSystem::Original>();
-	const std::unique_ptr<IShuffledIndices> iShuffledIndices =
-	    makeShuffledIndices(ShuffleType::DoubleBag)(baseTetrominos);
+	AnyShuffledIndices shuffledIndices = makeShuffledIndices(ShuffleType::DoubleBag)(baseTetrominos);
 
 	targetMinSize = targetMinSize + 7;
-	iShuffledIndices->fill(indices, targetMinSize, rng);
+	shuffledIndices.fill(indices, targetMinSize, rng);
 	REQUIRE(indices.size() >= targetMinSize);
 	REQUIRE(allIndicesValid(indices, baseTetrominos.size()));
 
 	targetMinSize = targetMinSize + 20;
-	iShuffledIndices->fill(indices, targetMinSize, rng);
+	shuffledIndices.fill(indices, targetMinSize, rng);
 	REQUIRE(indices.size() >= targetMinSize);
 	REQUIRE(allIndicesValid(indices, baseTetrominos.size()));
 
 	targetMinSize = targetMinSize + 1;
-	iShuffledIndices->fill(indices, targetMinSize, rng);
+	shuffledIndices.fill(indices, targetMinSize, rng);
 	REQUIRE(indices.size() >= targetMinSize);
 	REQUIRE(allIndicesValid(indices, baseTetrominos.size()));
 
 	REQUIRE(std::count(indices.begin(), indices.end(), indices.front()) == 4);
 }
-TEST_CASE("IShuffledIndices<TripleBag>", "[gameplay]")
+TEST_CASE("AnyShuffledIndices<TripleBag>", "[gameplay]")
 {
 	std::mt19937_64 rng(Catch::getSeed());
-	std::deque<size_t> indices;
+	IndexQueue indices;
 	size_t targetMinSize = 0;
 	const std::vector<Tetromino> baseTetrominos = makeBaseMinos<RotationSystem::Sega>();
-	const std::unique_ptr<IShuffledIndices> iShuffledIndices =
-	    makeShuffledIndices(ShuffleType::TripleBag)(baseTetrominos);
+	AnyShuffledIndices shuffledIndices = makeShuffledIndices(ShuffleType::TripleBag)(baseTetrominos);
 
 	targetMinSize = targetMinSize + 16;
-	iShuffledIndices->fill(indices, targetMinSize, rng);
+	shuffledIndices.fill(indices, targetMinSize, rng);
 	REQUIRE(indices.size() >= targetMinSize);
 	REQUIRE(allIndicesValid(indices, baseTetrominos.size()));
 
 	targetMinSize = targetMinSize + 16;
-	iShuffledIndices->fill(indices, targetMinSize, rng);
+	shuffledIndices.fill(indices, targetMinSize, rng);
 	REQUIRE(indices.size() >= targetMinSize);
 	REQUIRE(allIndicesValid(indices, baseTetrominos.size()));
 
 	targetMinSize = targetMinSize + 10;
-	iShuffledIndices->fill(indices, targetMinSize, rng);
+	shuffledIndices.fill(indices, targetMinSize, rng);
 	REQUIRE(indices.size() >= targetMinSize);
 	REQUIRE(allIndicesValid(indices, baseTetrominos.size()));
 
 	REQUIRE(std::count(indices.begin(), indices.end(), indices.front()) == 6);
 }
-TEST_CASE("IShuffledIndices<TGMH4>", "[gameplay]")
+TEST_CASE("AnyShuffledIndices<TGMH4>", "[gameplay]")
 {
 	std::mt19937_64 rng(Catch::getSeed());
 	const std::vector<Tetromino> baseTetrominos = makeBaseMinos<RotationSystem::Arika>();
 
 	for(size_t i = 0; i < 9; ++i)
 	{
-		std::deque<size_t> indices;
-		const std::unique_ptr<IShuffledIndices> iShuffledIndices =
-		    makeShuffledIndices(ShuffleType::TGMH4)(baseTetrominos);
+		IndexQueue indices;
+		AnyShuffledIndices shuffledIndices = makeShuffledIndices(ShuffleType::TGMH4)(baseTetrominos);
 
-		iShuffledIndices->fill(indices, 1, rng);
+		shuffledIndices.fill(indices, 1, rng);
 
 		REQUIRE(!indices.empty());
 		REQUIRE(indices.front() < baseTetrominos.size());
@@ -572,15 +599,15 @@ TEST_CASE("IShuffledIndices<TGMH4>", "[gameplay]")
 		REQUIRE(firstType != TetrominoType::S);
 	}
 
-	std::deque<size_t> indices;
-	const std::unique_ptr<IShuffledIndices> iShuffledIndices = makeShuffledIndices(ShuffleType::TGMH4)(baseTetrominos);
+	IndexQueue indices;
+	AnyShuffledIndices shuffledIndices = makeShuffledIndices(ShuffleType::TGMH4)(baseTetrominos);
 
 	for(const size_t indicesToAdd : std::initializer_list<size_t>{9, 2, 3, 1, 8, 4})
 	{
 		const size_t prevSize = indices.size();
 		const size_t targetMinSize = prevSize + indicesToAdd;
 
-		iShuffledIndices->fill(indices, targetMinSize, rng);
+		shuffledIndices.fill(indices, targetMinSize, rng);
 
 		REQUIRE(indices.size() >= targetMinSize);
 		REQUIRE(allIndicesValid(indices, baseTetrominos.size()));
@@ -594,18 +621,17 @@ TEST_CASE("IShuffledIndices<TGMH4>", "[gameplay]")
 		REQUIRE(historyFound == historyEnd);
 	}
 }
-TEST_CASE("IShuffledIndices<TGM35>", "[gameplay]")
+TEST_CASE("AnyShuffledIndices<TGM35>", "[gameplay]")
 {
 	std::mt19937_64 rng(Catch::getSeed());
 	const std::vector<Tetromino> baseTetrominos = makeBaseMinos<RotationSystem::Arika>();
 
 	for(size_t i = 0; i < 9; ++i)
 	{
-		std::deque<size_t> indices;
-		const std::unique_ptr<IShuffledIndices> iShuffledIndices =
-		    makeShuffledIndices(ShuffleType::TGM35)(baseTetrominos);
+		IndexQueue indices;
+		AnyShuffledIndices shuffledIndices = makeShuffledIndices(ShuffleType::TGM35)(baseTetrominos);
 
-		iShuffledIndices->fill(indices, 1, rng);
+		shuffledIndices.fill(indices, 1, rng);
 
 		REQUIRE(!indices.empty());
 		REQUIRE(indices.front() < baseTetrominos.size());
@@ -615,15 +641,15 @@ TEST_CASE("IShuffledIndices<TGM35>", "[gameplay]")
 		REQUIRE(firstType != TetrominoType::S);
 	}
 
-	std::deque<size_t> indices;
-	const std::unique_ptr<IShuffledIndices> iShuffledIndices = makeShuffledIndices(ShuffleType::TGM35)(baseTetrominos);
+	IndexQueue indices;
+	AnyShuffledIndices shuffledIndices = makeShuffledIndices(ShuffleType::TGM35)(baseTetrominos);
 
 	for(const size_t indicesToAdd : std::initializer_list<size_t>{1, 6, 9, 11, 8, 4})
 	{
 		const size_t prevSize = indices.size();
 		const size_t targetMinSize = prevSize + indicesToAdd;
 
-		iShuffledIndices->fill(indices, targetMinSize, rng);
+		shuffledIndices.fill(indices, targetMinSize, rng);
 
 		REQUIRE(indices.size() >= targetMinSize);
 		REQUIRE(allIndicesValid(indices, baseTetrominos.size()));
@@ -637,25 +663,138 @@ TEST_CASE("IShuffledIndices<TGM35>", "[gameplay]")
 		REQUIRE(historyFound == historyEnd);
 	}
 }
-TEST_CASE("IShuffledIndices<NES>", "[gameplay]")
+TEST_CASE("AnyShuffledIndices<TGM35> long sequences", "[gameplay]")
+{
+	const std::vector<Tetromino> baseTetrominos = makeBaseMinos<RotationSystem::Arika>();
+
+	// the bag drifts towards the pieces in the history, drawing used to hang once it only held those
+	for(uint64_t seed = 0; seed < 50; ++seed)
+	{
+		std::mt19937_64 rng(seed);
+		AnyShuffledIndices shuffledIndices = makeShuffledIndices(ShuffleType::TGM35)(baseTetrominos);
+		std::vector<size_t> drawn;
+		IndexQueue indices;
+		for(size_t i = 0; i < 2000; ++i)
+		{
+			shuffledIndices.fill(indices, 1, rng);
+			drawn.push_back(indices.front());
+			indices.pop_front();
+		}
+
+		REQUIRE(std::all_of(drawn.begin(), drawn.end(), [&](size_t idx) { return idx < baseTetrominos.size(); }));
+		for(size_t i = 4; i < drawn.size(); ++i)
+		{
+			REQUIRE(std::find(drawn.begin() + static_cast<ptrdiff_t>(i - 4), drawn.begin() + static_cast<ptrdiff_t>(i),
+			            drawn[i]) == drawn.begin() + static_cast<ptrdiff_t>(i));
+		}
+	}
+}
+TEST_CASE("AnyShuffledIndices<NES>", "[gameplay]")
 {
 	std::mt19937_64 rng(Catch::getSeed());
 	const std::vector<Tetromino> baseTetrominos = makeBaseMinos<RotationSystem::NintendoRight>();
 
-	std::deque<size_t> indices;
-	const std::unique_ptr<IShuffledIndices> iShuffledIndices = makeShuffledIndices(ShuffleType::NES)(baseTetrominos);
+	IndexQueue indices;
+	AnyShuffledIndices shuffledIndices = makeShuffledIndices(ShuffleType::NES)(baseTetrominos);
 
 	for(const size_t indicesToAdd : std::initializer_list<size_t>{5, 8, 2, 1, 15})
 	{
 		const size_t prevSize = indices.size();
 		const size_t targetMinSize = prevSize + indicesToAdd;
 
-		iShuffledIndices->fill(indices, targetMinSize, rng);
+		shuffledIndices.fill(indices, targetMinSize, rng);
 
 		REQUIRE(indices.size() >= targetMinSize);
 		REQUIRE(allIndicesValid(indices, baseTetrominos.size()));
 	}
 }
+TEST_CASE("AnyShuffledIndices copies", "[gameplay]")
+{
+	const std::vector<Tetromino> baseTetrominos = makeBaseMinos<RotationSystem::Arika>();
+	for(const ShuffleType shuffleType : {ShuffleType::TGMH4, ShuffleType::TGM35, ShuffleType::NES})
+	{
+		std::mt19937_64 rng(Catch::getSeed());
+		IndexQueue indices;
+		AnyShuffledIndices shuffledIndices = makeShuffledIndices(shuffleType)(baseTetrominos);
+		shuffledIndices.fill(indices, 20, rng);
+
+		AnyShuffledIndices copy = shuffledIndices;
+		std::mt19937_64 copyRng = rng;
+		IndexQueue copyIndices = indices;
+		shuffledIndices.fill(indices, 60, rng);
+		copy.fill(copyIndices, 60, copyRng);
+
+		REQUIRE(std::equal(indices.begin(), indices.end(), copyIndices.begin(), copyIndices.end()));
+	}
+	{
+		AnyScoringSystem scoreSys = makeScoringSystem<ScoringSystem::Guideline>();
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 4, 1) == 800);
+
+		AnyScoringSystem copy = scoreSys;
+		REQUIRE(copy.process(ScoreEvent::LineClear, 4, 1) == (800 + 50) * 3 / 2);
+		REQUIRE(scoreSys.process(ScoreEvent::LineClear, 4, 1) == (800 + 50) * 3 / 2);
+	}
+}
+
+TEST_CASE("AnyShuffledIndices::sample", "[gameplay]")
+{
+	const std::vector<Tetromino> baseTetrominos = makeBaseMinos<RotationSystem::Arika>();
+	const size_t visible = 5;
+	for(const ShuffleType shuffleType : {ShuffleType::Random, ShuffleType::SingleBag, ShuffleType::DoubleBag,
+	        ShuffleType::TGMH4, ShuffleType::TGM35, ShuffleType::NES})
+	{
+		std::mt19937_64 rng(Catch::getSeed());
+		IndexQueue indices;
+		AnyShuffledIndices shuffledIndices = makeShuffledIndices(shuffleType)(baseTetrominos);
+		shuffledIndices.fill(indices, visible, rng);
+		const AnyShuffledIndices copy = shuffledIndices;
+
+		std::mt19937_64 sampleRng(Catch::getSeed() + 1);
+		const IndexQueue sampled = shuffledIndices.sample(indices, visible, 30, sampleRng);
+		REQUIRE(sampled.size() >= 30);
+		REQUIRE(allIndicesValid(sampled, baseTetrominos.size()));
+		REQUIRE(std::equal(indices.begin(), indices.begin() + static_cast<ptrdiff_t>(visible), sampled.begin()));
+
+		// the state of the game is left as it was
+		AnyShuffledIndices copied = copy;
+		std::mt19937_64 copyRng = rng;
+		IndexQueue copyIndices = indices;
+		shuffledIndices.fill(indices, 40, rng);
+		copied.fill(copyIndices, 40, copyRng);
+		REQUIRE(std::equal(indices.begin(), indices.end(), copyIndices.begin(), copyIndices.end()));
+
+		if(shuffleType == ShuffleType::TGMH4 || shuffleType == ShuffleType::TGM35)
+		{
+			for(size_t i = 4; i < sampled.size(); ++i)
+			{
+				REQUIRE(std::find(sampled.begin() + static_cast<ptrdiff_t>(i - 4),
+				            sampled.begin() + static_cast<ptrdiff_t>(i),
+				            sampled[i]) == sampled.begin() + static_cast<ptrdiff_t>(i));
+			}
+		}
+	}
+
+	// the rest of the bag keeps its pieces, in an order that does not depend on the real one
+	std::mt19937_64 rng(Catch::getSeed());
+	IndexQueue indices;
+	AnyShuffledIndices shuffledIndices = makeShuffledIndices(ShuffleType::SingleBag)(baseTetrominos);
+	shuffledIndices.fill(indices, visible, rng);
+	REQUIRE(indices.size() == baseTetrominos.size());
+	bool isReordered = false;
+	for(uint64_t seed = 0; seed < 20; ++seed)
+	{
+		std::mt19937_64 sampleRng(seed);
+		const IndexQueue sampled = shuffledIndices.sample(indices, visible, 21, sampleRng);
+		REQUIRE(std::is_permutation(indices.begin(), indices.end(), sampled.begin(), sampled.begin() + 7));
+		for(size_t bag = 7; bag + 7 <= sampled.size(); bag += 7)
+		{
+			REQUIRE(std::is_permutation(indices.begin(), indices.end(), sampled.begin() + static_cast<ptrdiff_t>(bag),
+			    sampled.begin() + static_cast<ptrdiff_t>(bag + 7)));
+		}
+		isReordered = isReordered || !std::equal(indices.begin(), indices.end(), sampled.begin());
+	}
+	REQUIRE(isReordered);
+}
 
 TEST_CASE("levelUp", "[gameplay]")
 {
@@ -1,11 +1,14 @@
 #include "grid.hpp"
 
+#include "smallgrid.hpp"
 #include "types.hpp"
 
 #include <catch2/catch_test_macros.hpp>
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <vector>
 
 using namespace raymino;
@@ -98,6 +101,63 @@ TEST_CASE("Grid::transpose", "[Grid]")
 	REQUIRE(gridR == Grid{{4, 2}, {1, 3, 5, 7, 2, 4, 6, 8}});
 }
 
+TEST_CASE("Grid::transpose/rotate large grids", "[Grid]")
+{
+	// sizes around the tile size & the largest custom playfield
+	const std::vector<Size> sizes{{1, 1}, {1, 40}, {17, 3}, {16, 32}, {33, 47}, {64, 65}, {200, 37}, {255, 255}};
+
+	for(const Size size : sizes)
+	{
+		std::vector<Grid::Cell> cells(size.area());
+		for(size_t idx = 0; idx < cells.size(); ++idx)
+		{
+			cells[idx] = static_cast<Grid::Cell>((idx * 7) % 5);
+		}
+		const Grid source(size, cells);
+		// steps 1-3 are clockwise rotations, 0 stands for transpose
+		const auto atRotated = [&source, size](int steps, XY pos) -> Grid::Cell
+		{
+			switch(steps)
+			{
+			case 1:
+				return source.getAt({pos.y, size.height - 1 - pos.x});
+			case 2:
+				return source.getAt({size.width - 1 - pos.x, size.height - 1 - pos.y});
+			case 3:
+				return source.getAt({size.width - 1 - pos.y, pos.x});
+			default:
+				return source.getAt({pos.y, pos.x});
+			}
+		};
+
+		Grid transposed(source);
+		transposed.transpose();
+		for(int steps = 0; steps < 4; ++steps)
+		{
+			Grid rotated(source);
+			rotated.rotate(steps - 4);
+			const Grid& result = steps == 0 ? transposed : rotated;
+			const Size resultSize = steps == 2 ? size : Size{size.height, size.width};
+			REQUIRE(result.getSize() == resultSize);
+
+			bool matches = true;
+			for(int yPos = 0; yPos < resultSize.height; ++yPos)
+			{
+				for(int xPos = 0; xPos < resultSize.width; ++xPos)
+				{
+					matches = matches && result.getAt({xPos, yPos}) == atRotated(steps, {xPos, yPos});
+				}
+			}
+			REQUIRE(matches);
+		}
+
+		Grid roundTrip(source);
+		roundTrip.rotate(1);
+		roundTrip.rotate(-1);
+		REQUIRE(roundTrip == source);
+	}
+}
+
 TEST_CASE("Grid::reverseRows", "[Grid]")
 {
 	Grid gridS({3, 3}, {1, 2, 3, 4, 5, 6, 7, 8, 9});
@@ -138,4 +198,268 @@ TEST_CASE("Grid::transformCells", "[Grid]")
 		    return cell + 3;
 	    });
 	REQUIRE(grid == Grid{{2, 2}, {4, 5, 6, 7}});
+
+	const Grid::Cell offset = 2;
+	const Grid copy(grid,
+	    [offset](Grid::Cell cell)
+	    {
+		    return static_cast<Grid::Cell>(cell - offset);
+	    });
+	REQUIRE(copy == Grid{{2, 2}, {2, 3, 4, 5}});
+	REQUIRE(grid == Grid{{2, 2}, {4, 5, 6, 7}});
+}
+
+TEST_CASE("Grid::transformOccupied", "[Grid]")
+{
+	Grid grid({3, 2}, {0, 1, 2, 0, 0, 3});
+
+	grid.transformOccupied(
+	    [](Grid::Cell cell)
+	    {
+		    return static_cast<Grid::Cell>(cell * 2);
+	    });
+	REQUIRE(grid == Grid{{3, 2}, {0, 2, 4, 0, 0, 6}});
+
+	grid.recolor(9);
+	REQUIRE(grid == Grid{{3, 2}, {0, 9, 9, 0, 0, 9}});
+	REQUIRE(grid.getRowBits(0) == 0b110);
+	REQUIRE(grid.getColumnTop(0) == 2);
+
+	grid.recolor(0);
+	REQUIRE(grid.isEmpty());
+	REQUIRE(grid.getRowBits(1) == 0);
+	REQUIRE(grid.getColumnTop(2) == 2);
+}
+
+TEST_CASE("Grid::fill", "[Grid]")
+{
+	Grid grid({3, 2}, 0);
+
+	grid.fill(4);
+	REQUIRE(grid == Grid{{3, 2}, 4});
+	REQUIRE(grid.isRowFull(0));
+	REQUIRE(grid.getColumnTop(1) == 0);
+
+	grid.fill(0);
+	REQUIRE(grid.isEmpty());
+	REQUIRE(grid.getColumnTop(1) == 2);
+}
+
+TEST_CASE("Grid::getRowBits", "[Grid]")
+{
+	Grid grid({3, 3}, {0, 0, 0, 1, 0, 1, 1, 1, 1});
+
+	REQUIRE(grid.hasRowBits() == true);
+	REQUIRE(grid.fullRowBits() == 0b111);
+	REQUIRE(grid.getRowBits(0) == 0);
+	REQUIRE(grid.getRowBits(1) == 0b101);
+	REQUIRE(grid.getRowBits(2) == 0b111);
+	REQUIRE(grid.getRowBits(-1) == 0);
+	REQUIRE(grid.getRowBits(3) == 0);
+
+	grid.setAt({1, 0}, Grid({1, 2}, {2, 2}));
+	REQUIRE(grid.getRowBits(0) == 0b010);
+	REQUIRE(grid.getRowBits(1) == 0b111);
+
+	REQUIRE(Grid({Grid::rowBitsWidth + 1, 1}, 1).hasRowBits() == false);
+}
+
+TEST_CASE("Grid::placedRowBits", "[Grid]")
+{
+	const Grid grid({4, 4}, 0);
+	const Grid other({2, 2}, {2, 0, 2, 2});
+
+	REQUIRE(grid.placedRowBits({0, 0}, other, 0) == 0b0001);
+	REQUIRE(grid.placedRowBits({0, 0}, other, 1) == 0b0011);
+	REQUIRE(grid.placedRowBits({0, 0}, other, 2) == 0);
+	REQUIRE(grid.placedRowBits({3, 1}, other, 2) == 0b1000);
+	REQUIRE(grid.placedRowBits({-1, 1}, other, 2) == 0b0001);
+}
+
+TEST_CASE("Grid::eraseFullRows", "[Grid]")
+{
+	Grid grid({3, 4}, {1, 1, 1, 0, 2, 0, 3, 3, 3, 0, 0, 4});
+
+	REQUIRE(grid.eraseFullRows() == 2);
+	REQUIRE(grid == Grid{{3, 4}, {0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 4}});
+	REQUIRE(grid.getRowBits(2) == 0b010);
+	REQUIRE(grid.getRowBits(3) == 0b100);
+	REQUIRE(grid.eraseFullRows() == 0);
+
+	const int wide = Grid::rowBitsWidth + 2;
+	std::vector<Grid::Cell> wideCells(static_cast<size_t>(wide * 2), 1);
+	wideCells[0] = 0;
+	Grid wideGrid({wide, 2}, wideCells);
+	REQUIRE(wideGrid.eraseFullRows() == 1);
+	REQUIRE(std::count(wideGrid.begin(), wideGrid.end(), 0) == static_cast<ptrdiff_t>(wide + 1));
+}
+
+TEST_CASE("Grid::pushUp", "[Grid]")
+{
+	Grid grid({3, 4}, {0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 3, 0});
+
+	REQUIRE_FALSE(grid.pushUp(2, 9, 1));
+	REQUIRE(grid == Grid{{3, 4}, {0, 2, 0, 3, 3, 0, 9, 0, 9, 9, 0, 9}});
+	REQUIRE(grid.getRowBits(3) == 0b101);
+	REQUIRE(grid.getColumnTop(0) == 1);
+	REQUIRE(grid.getColumnTop(1) == 0);
+
+	REQUIRE(grid.pushUp(1, 9, 2));
+	REQUIRE(grid == Grid{{3, 4}, {3, 3, 0, 9, 0, 9, 9, 0, 9, 9, 9, 0}});
+	REQUIRE_FALSE(grid.pushUp(0, 9, 0));
+}
+
+TEST_CASE("Grid::getHash", "[Grid]")
+{
+	const auto rehashed = [](const Grid& grid)
+	{
+		return Grid{grid, [](Grid::Cell cell)
+		    {
+			    return cell;
+		    }}.getHash();
+	};
+	const Grid empty({4, 6}, 0);
+	REQUIRE(empty.getHash() == 0);
+
+	SECTION("independent of colors & order")
+	{
+		Grid first = empty;
+		first.setAt({0, 4}, Grid{{2, 2}, {1, 1, 1, 0}});
+		first.setAt({2, 5}, PieceGrid{{2, 1}, {2, 2}});
+		Grid second = empty;
+		second.setAt({2, 5}, PieceGrid{{2, 1}, {5, 5}});
+		second.setAt({0, 4}, Grid{{2, 2}, {6, 6, 6, 0}});
+		REQUIRE(first.getHash() != 0);
+		REQUIRE(first.getHash() == second.getHash());
+		REQUIRE(first.getHash() == rehashed(first));
+
+		second.recolor(3);
+		REQUIRE(first.getHash() == second.getHash());
+		second.setAt({3, 0}, PieceGrid{{1, 1}, {1}});
+		REQUIRE(first.getHash() != second.getHash());
+	}
+	SECTION("eraseFullRows")
+	{
+		Grid grid({4, 6}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1, 0, 1, 1, 0, 1, 1, 1, 1});
+		REQUIRE(grid.eraseFullRows() == 2);
+		REQUIRE(grid.getHash() == rehashed(grid));
+		const Grid cleared({4, 6}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0});
+		REQUIRE(grid.getHash() == cleared.getHash());
+		grid.setAt({0, 5}, PieceGrid{{1, 1}, {1}});
+		grid.setAt({3, 5}, PieceGrid{{1, 1}, {1}});
+		REQUIRE(grid.eraseFullRows() == 1);
+		REQUIRE(grid.getHash() == rehashed(grid));
+		REQUIRE(grid.eraseFullRows() == 0);
+		REQUIRE(grid.getHash() == rehashed(grid));
+	}
+	SECTION("pushUp & snapshots")
+	{
+		Grid grid = empty;
+		grid.setAt({1, 5}, PieceGrid{{2, 1}, {1, 1}});
+		GridSnapshot<4, 6> snapshot;
+		grid.save(snapshot);
+		const uint64_t saved = grid.getHash();
+		REQUIRE_FALSE(grid.pushUp(2, 9, 0));
+		REQUIRE(grid.getHash() == rehashed(grid));
+		REQUIRE(grid.getHash() != saved);
+		grid.restore(snapshot);
+		REQUIRE(grid.getHash() == saved);
+	}
+}
+
+TEST_CASE("Grid::overlapAt row bits", "[Grid]")
+{
+	const Grid narrow({4, 4}, {0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1, 1});
+	const Grid wide({Grid::rowBitsWidth + 4, 4}, 0);
+	const Grid other({2, 2}, {0, 2, 2, 2});
+
+	REQUIRE(narrow.overlapAt({1, 1}, other) == 0);
+	REQUIRE(narrow.overlapAt({0, 1}, other) == 3);
+	REQUIRE(narrow.overlapAt({-1, 0}, other) == 3);
+	REQUIRE(narrow.overlapAt({3, 0}, other) == 2);
+	REQUIRE(narrow.overlapAt({1, 3}, other) == 2);
+	REQUIRE(wide.overlapAt({0, 0}, other) == 0);
+	REQUIRE(wide.overlapAt({-1, 0}, other) == 3);
+}
+
+TEST_CASE("Grid::getColumnTop", "[Grid]")
+{
+	Grid grid({3, 4}, {0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 0});
+
+	REQUIRE(grid.getColumnTop(0) == 3);
+	REQUIRE(grid.getColumnTop(1) == 1);
+	REQUIRE(grid.getColumnTop(2) == 4);
+	REQUIRE(grid.getColumnTop(-1) == 0);
+	REQUIRE(grid.getColumnTop(3) == 0);
+
+	grid.setAt({1, 1}, Grid({2, 2}, {0, 2, 0, 2}));
+	REQUIRE(grid.getColumnTop(2) == 1);
+
+	grid.setAt({0, 3}, Grid({3, 1}, {0, 0, 3}));
+	REQUIRE(grid.eraseFullRows() == 1);
+	REQUIRE(grid.getColumnTop(0) == 4);
+	REQUIRE(grid.getColumnTop(1) == 2);
+	REQUIRE(grid.getColumnTop(2) == 2);
+}
+
+TEST_CASE("Grid::dropDistance", "[Grid]")
+{
+	const Grid grid({4, 6}, {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 1});
+	const Grid other({2, 2}, {2, 2, 2, 0});
+
+	REQUIRE(grid.dropDistance({2, 0}, other) == 3);
+	REQUIRE(grid.dropDistance({0, 0}, other) == 0);
+	REQUIRE(grid.dropDistance({1, 0}, other) == 0);
+	// below the overhang in row 2
+	REQUIRE(grid.dropDistance({0, 3}, other) == 0);
+	REQUIRE(grid.dropDistance({1, 3}, other) == 1);
+
+	for(int xPos = -1; xPos < 4; ++xPos)
+	{
+		for(int yPos = -1; yPos < 6; ++yPos)
+		{
+			if(grid.overlapAt({xPos, yPos}, other) != 0)
+			{
+				continue;
+			}
+			int expected = 0;
+			while(grid.overlapAt({xPos, yPos + expected + 1}, other) == 0)
+			{
+				++expected;
+			}
+			REQUIRE(grid.dropDistance({xPos, yPos}, other) == expected);
+		}
+	}
+}
+
+TEST_CASE("Grid fixed kernels", "[Grid]")
+{
+	const Size standard{10, 24};
+	Grid fixed(standard, 0);
+	Grid dynamic({10, 25}, 0);
+
+	REQUIRE(fixed.hasFixedKernels() == true);
+	REQUIRE(dynamic.hasFixedKernels() == false);
+	REQUIRE(fixed.isEmpty() == true);
+
+	const PieceGrid piece({3, 2}, {1, 1, 1, 0, 1, 0});
+	for(int yPos = 0; yPos < 24; yPos += 2)
+	{
+		for(int xPos = -1; xPos < 10; ++xPos)
+		{
+			REQUIRE(fixed.overlapAt({xPos, yPos}, piece) == dynamic.overlapAt({xPos, yPos + 1}, piece));
+			if(fixed.overlapAt({xPos, yPos}, piece) == 0)
+			{
+				fixed.setAt({xPos, yPos}, piece);
+				dynamic.setAt({xPos, yPos + 1}, piece);
+			}
+		}
+	}
+	REQUIRE(fixed.isEmpty() == false);
+	REQUIRE(fixed.eraseFullRows() == dynamic.eraseFullRows());
+	REQUIRE(std::equal(fixed.begin(), fixed.end(), std::next(dynamic.begin(), 10), dynamic.end()));
+
+	Grid transposed(standard, 0);
+	transposed.transpose();
+	REQUIRE(transposed.hasFixedKernels() == false);
 }
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "placement.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "types.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+
+namespace raymino::testing
+{
+inline const PieceColors pieceColors{1, 2, 3, 4, 5, 6, 7};
+
+/**
+ * @brief require two simulations to be in the same game state
+ */
+inline void requireSameGame(const Simulation& lhs, const Simulation& rhs)
+{
+	REQUIRE(lhs.playfield == rhs.playfield);
+	REQUIRE(lhs.score == rhs.score);
+	REQUIRE(lhs.lockedPieces == rhs.lockedPieces);
+	REQUIRE(lhs.isGameOver == rhs.isGameOver);
+	REQUIRE(lhs.pendingGarbage == rhs.pendingGarbage);
+	REQUIRE(lhs.linesSent == rhs.linesSent);
+	REQUIRE(lhs.currentTetromino.position == rhs.currentTetromino.position);
+	REQUIRE(lhs.currentTetromino.type == rhs.currentTetromino.type);
+	REQUIRE(lhs.holdPieceIdx == rhs.holdPieceIdx);
+	REQUIRE(std::equal(lhs.nextTetrominoIndices.begin(), lhs.nextTetrominoIndices.end(),
+	    rhs.nextTetrominoIndices.begin(), rhs.nextTetrominoIndices.end()));
+}
+
+/**
+ * @brief apply path to tetromino with the runtime selected rules, independent of the search
+ * @param path range of PlacementMove
+ * @param hardDrop drop the piece after the last move, else it rests where the path leaves it
+ */
+template<typename Path>
+Offset followPath(const Settings& settings, const Grid& field, Tetromino tetromino, const Path& path, bool hardDrop)
+{
+	const auto rotate = basicRotation(settings.rotationSystem);
+	const auto kick = wallKick(settings.wallKicks);
+	tetromino.rotation &= 0b11;
+	for(const PlacementMove move : path)
+	{
+		switch(move)
+		{
+		case PlacementMove::MoveLeft:
+		case PlacementMove::MoveRight:
+		{
+			const XY step{move == PlacementMove::MoveLeft ? -1 : 1, 0};
+			REQUIRE(field.overlapAt(tetromino.position + step, tetromino.collision()) == 0);
+			tetromino.position += step;
+			break;
+		}
+		case PlacementMove::RotateRight:
+		case PlacementMove::RotateLeft:
+		{
+			Offset rotation = rotate(tetromino, move == PlacementMove::RotateRight ? 1 : -1);
+			tetromino += rotation;
+			if(field.overlapAt(tetromino.position, tetromino.collision()) != 0)
+			{
+				tetromino -= rotation;
+				rotation = kick(field, tetromino, rotation);
+				tetromino += rotation;
+			}
+			tetromino.rotation &= 0b11;
+			break;
+		}
+		case PlacementMove::SoftDrop:
+			tetromino.position.y += field.dropDistance(tetromino.position, tetromino.collision());
+			break;
+		}
+	}
+	if(hardDrop)
+	{
+		tetromino.position.y += field.dropDistance(tetromino.position, tetromino.collision());
+	}
+	return tetromino;
+}
+} // namespace raymino::testing
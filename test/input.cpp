@@ -0,0 +1,85 @@
+#include "input.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace raymino;
+
+namespace
+{
+InputSnapshot makeInput(bool isDown, bool isPressed, bool isReleased, InputSnapshot::Button button)
+{
+	InputSnapshot input;
+	input.set(button, isDown, isPressed, isReleased);
+	return input;
+}
+} // namespace
+
+TEST_CASE("InputSnapshot", "[input]")
+{
+	InputSnapshot input;
+	input.set(InputSnapshot::Hold, true, true, false);
+	input.set(InputSnapshot::MoveLeft, false, false, true);
+
+	REQUIRE(input.isDown(InputSnapshot::Hold));
+	REQUIRE(input.isPressed(InputSnapshot::Hold));
+	REQUIRE_FALSE(input.isReleased(InputSnapshot::Hold));
+	REQUIRE(input.isReleased(InputSnapshot::MoveLeft));
+	REQUIRE_FALSE(input.isDown(InputSnapshot::MoveLeft));
+	REQUIRE_FALSE(input.isDown(InputSnapshot::MoveRight));
+
+	const InputSnapshot tapped = InputSnapshot::tap(InputSnapshot::HardDrop);
+	REQUIRE(tapped == InputSnapshot{InputSnapshot::HardDrop, InputSnapshot::HardDrop, 0});
+}
+
+TEST_CASE("InputSnapshot::merge", "[input]")
+{
+	InputSnapshot pending = makeInput(true, true, false, InputSnapshot::HardDrop);
+	pending.merge(makeInput(false, false, true, InputSnapshot::HardDrop));
+
+	// a press & release between two steps still reaches the next step
+	REQUIRE(pending.isPressed(InputSnapshot::HardDrop));
+	REQUIRE(pending.isReleased(InputSnapshot::HardDrop));
+	REQUIRE_FALSE(pending.isDown(InputSnapshot::HardDrop));
+
+	pending.merge(makeInput(true, false, false, InputSnapshot::MoveLeft));
+	REQUIRE(pending.isDown(InputSnapshot::MoveLeft));
+	REQUIRE(pending.isPressed(InputSnapshot::HardDrop));
+
+	pending.consumeEdges();
+	REQUIRE(pending.pressed == 0);
+	REQUIRE(pending.released == 0);
+	REQUIRE(pending.isDown(InputSnapshot::MoveLeft));
+}
+
+TEST_CASE("KeyAction::tick", "[input]")
+{
+	const float repeatDelay = 0.25f;
+	const float repeatRate = 0.125f;
+	KeyAction action{repeatDelay, repeatRate, InputSnapshot::MoveRight, InputSnapshot::MoveLeft};
+	const InputSnapshot pressRight = makeInput(true, true, false, InputSnapshot::MoveRight);
+	const InputSnapshot holdRight = makeInput(true, false, false, InputSnapshot::MoveRight);
+	const InputSnapshot releaseRight = makeInput(false, false, true, InputSnapshot::MoveRight);
+	const InputSnapshot pressLeft = makeInput(true, true, false, InputSnapshot::MoveLeft);
+
+	KeyAction::Return result = action.tick(0.0f, pressRight);
+	REQUIRE(result.state == KeyAction::State::Pressed);
+	REQUIRE(result.value == 1);
+
+	// repeats only once repeatDelay + repeatRate passed
+	REQUIRE(action.tick(0.25f, holdRight).state == KeyAction::State::None);
+	result = action.tick(0.125f, holdRight);
+	REQUIRE(result.state == KeyAction::State::Repeated);
+	REQUIRE(result.value == 1);
+	REQUIRE(action.tick(0.0625f, holdRight).state == KeyAction::State::None);
+	REQUIRE(action.tick(0.0625f, holdRight).state == KeyAction::State::Repeated);
+
+	result = action.tick(0.0f, releaseRight);
+	REQUIRE(result.state == KeyAction::State::Released);
+	REQUIRE(result.value == 1);
+
+	result = action.tick(0.0f, pressLeft);
+	REQUIRE(result.state == KeyAction::State::Pressed);
+	REQUIRE(result.value == -1);
+
+	REQUIRE(action.tick(1.0f, InputSnapshot{}).state == KeyAction::State::None);
+}
@@ -0,0 +1,183 @@
+#include "perfectclear.hpp"
+
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "helpers.hpp"
+#include "placement.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "threadpool.hpp"
+#include "types.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+using namespace raymino;
+using namespace raymino::testing;
+
+namespace
+{
+/**
+ * @brief make the current piece & the queue of simulation pieces
+ */
+void setPieces(Simulation& simulation, std::initializer_list<TetrominoType> pieces)
+{
+	const auto* type = pieces.begin();
+	simulation.currentTetromino = simulation.baseTetrominos[static_cast<size_t>(*type)];
+	IndexQueue queue;
+	for(++type; type != pieces.end(); ++type)
+	{
+		queue.push_back(static_cast<size_t>(*type));
+	}
+	simulation.nextTetrominoIndices = queue;
+}
+
+/**
+ * @brief place steps in order, swapping pieces like Simulation does on hold
+ * @return true if the playfield is empty afterwards
+ */
+bool playSteps(const Simulation& simulation, const std::vector<PerfectClearStep>& steps)
+{
+	Grid field = simulation.playfield;
+	size_t current = static_cast<size_t>(simulation.currentTetromino.type);
+	size_t held = simulation.holdPieceIdx;
+	size_t position = 0;
+	for(const PerfectClearStep& step : steps)
+	{
+		if(step.useHold)
+		{
+			if(held == Simulation::NO_HOLD_PIECE)
+			{
+				held = current;
+				current = simulation.nextTetrominoIndices[position++];
+			}
+			else
+			{
+				std::swap(held, current);
+			}
+		}
+		REQUIRE(step.pieceIdx == current);
+		const Tetromino& tetromino = simulation.baseTetrominos[current];
+		REQUIRE(followPath(simulation.settings, field, tetromino, step.path, true) == step.target);
+		const PieceGrid& collision = tetromino.collision(step.target.rotation);
+		REQUIRE(field.overlapAt(step.target.position, collision) == 0);
+		REQUIRE(field.dropDistance(step.target.position, collision) == 0);
+		field.setAt(step.target.position, collision);
+		field.eraseFullRows();
+		if(position < simulation.nextTetrominoIndices.size())
+		{
+			current = simulation.nextTetrominoIndices[position++];
+		}
+	}
+	return field.isEmpty();
+}
+
+/**
+ * @param rows cells from the bottom row up, '#' for occupied & '.' for empty
+ */
+void fillRows(Grid& field, std::initializer_list<const char*> rows)
+{
+	const Size size = field.getSize();
+	int yPos = size.height - 1;
+	for(const char* row : rows)
+	{
+		for(int xPos = 0; xPos < size.width; ++xPos)
+		{
+			if(row[xPos] == '#')
+			{
+				field.setAt({xPos, yPos}, PieceGrid{{1, 1}, {8}});
+			}
+		}
+		--yPos;
+	}
+}
+} // namespace
+
+TEST_CASE("PerfectClearSolver::solve", "[PerfectClearSolver]")
+{
+	const Settings settings;
+	Simulation simulation{settings, 1, pieceColors};
+	PerfectClearSolver solver{settings};
+
+	SECTION("single piece")
+	{
+		fillRows(simulation.playfield, {"######...."});
+		setPieces(simulation, {TetrominoType::I, TetrominoType::O});
+		REQUIRE(solver.solve(simulation, 0).empty());
+		const std::vector<PerfectClearStep> steps = solver.solve(simulation, 1);
+		REQUIRE(steps.size() == 1);
+		REQUIRE_FALSE(steps.front().useHold);
+		REQUIRE(playSteps(simulation, steps));
+	}
+	SECTION("hold")
+	{
+		fillRows(simulation.playfield, {"####..####", "####..####"});
+		setPieces(simulation, {TetrominoType::T, TetrominoType::O});
+		std::vector<PerfectClearStep> steps = solver.solve(simulation, 3);
+		REQUIRE(steps.size() == 1);
+		REQUIRE(steps.front().useHold);
+		REQUIRE(playSteps(simulation, steps));
+
+		simulation.holdPieceLocked = true;
+		REQUIRE(solver.solve(simulation, 3).empty());
+		simulation.holdPieceLocked = false;
+
+		simulation.playfield.fill(0);
+		fillRows(simulation.playfield, {"######....", "######...."});
+		setPieces(simulation, {TetrominoType::O, TetrominoType::J, TetrominoType::J});
+		steps = solver.solve(simulation, 3);
+		REQUIRE(steps.size() == 2);
+		REQUIRE(steps.front().useHold);
+		REQUIRE(playSteps(simulation, steps));
+	}
+	SECTION("column parity")
+	{
+		fillRows(simulation.playfield, {".#########", ".#########", ".#########", ".#########"});
+		setPieces(simulation, {TetrominoType::O, TetrominoType::S, TetrominoType::Z, TetrominoType::T});
+		REQUIRE(solver.solve(simulation, 4).empty());
+		setPieces(simulation, {TetrominoType::O, TetrominoType::I});
+		REQUIRE(playSteps(simulation, solver.solve(simulation, 4)));
+	}
+	SECTION("empty playfield")
+	{
+		setPieces(simulation, {TetrominoType::I, TetrominoType::O, TetrominoType::J, TetrominoType::J,
+		                          TetrominoType::I, TetrominoType::S, TetrominoType::Z});
+		const std::vector<PerfectClearStep> steps = solver.solve(simulation, 7);
+		REQUIRE(steps.size() == 5);
+		REQUIRE(playSteps(simulation, steps));
+	}
+}
+
+TEST_CASE("PerfectClearSolver threads", "[PerfectClearSolver]")
+{
+	const Settings settings;
+	ThreadPool pool{4};
+	PerfectClearSolver single{settings};
+	PerfectClearSolver threaded{settings, &pool};
+	size_t solved = 0;
+	for(uint64_t seed = 1; seed <= 8; ++seed)
+	{
+		Simulation simulation{settings, seed, pieceColors};
+		fillRows(simulation.playfield, {"###....###", "##....####"});
+		const std::vector<PerfectClearStep> steps = single.solve(simulation, 7);
+		const std::vector<PerfectClearStep> threadedSteps = threaded.solve(simulation, 7);
+		REQUIRE(steps.size() == threadedSteps.size());
+		for(size_t idx = 0; idx < steps.size(); ++idx)
+		{
+			REQUIRE(steps[idx].useHold == threadedSteps[idx].useHold);
+			REQUIRE(steps[idx].target == threadedSteps[idx].target);
+			REQUIRE(steps[idx].path == threadedSteps[idx].path);
+		}
+		if(!steps.empty())
+		{
+			++solved;
+			REQUIRE(playSteps(simulation, steps));
+		}
+	}
+	REQUIRE(solved > 0);
+}
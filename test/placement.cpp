@@ -0,0 +1,105 @@
+#include "placement.hpp"
+
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "helpers.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "smallgrid.hpp"
+#include "types.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+using namespace raymino;
+using namespace raymino::testing;
+
+namespace
+{
+size_t expectedOnEmpty(TetrominoType type)
+{
+	switch(type)
+	{
+	case TetrominoType::O:
+		return 9;
+	case TetrominoType::I:
+	case TetrominoType::S:
+	case TetrominoType::Z:
+		return 17;
+	default:
+		return 34;
+	}
+}
+} // namespace
+
+TEST_CASE("PlacementSearch::search", "[PlacementSearch]")
+{
+	SECTION("empty playfield")
+	{
+		for(const RotationSystem rotationSystem : {RotationSystem::Super, RotationSystem::Arika,
+		        RotationSystem::Original, RotationSystem::NintendoRight})
+		{
+			Settings settings;
+			settings.rotationSystem = rotationSystem;
+			const Simulation simulation{settings, 1, pieceColors};
+			PlacementSearch search{settings};
+
+			for(const Tetromino& tetromino : simulation.baseTetrominos)
+			{
+				const std::vector<Placement>& placements = search.search(simulation.playfield, tetromino);
+				REQUIRE(placements.size() == expectedOnEmpty(tetromino.type));
+				for(const Placement& placement : placements)
+				{
+					const Offset reached =
+					    followPath(settings, simulation.playfield, tetromino, search.path(placement), false);
+					REQUIRE(reached == placement.offset);
+					const PieceGrid& collision = tetromino.collision(reached.rotation);
+					REQUIRE(simulation.playfield.dropDistance(reached.position, collision) == 0);
+				}
+				REQUIRE(std::is_sorted(placements.begin(), placements.end(),
+				    [](const Placement& lhs, const Placement& rhs)
+				    {
+					    return lhs.pathLength < rhs.pathLength;
+				    }));
+			}
+		}
+	}
+	SECTION("tuck under an overhang")
+	{
+		const Settings settings;
+		Simulation simulation{settings, 1, pieceColors};
+		const Size size = simulation.playfield.getSize();
+		simulation.playfield.setAt({0, size.height - 2}, Grid{{6, 1}, {1, 1, 1, 1, 1, 1}});
+		const Tetromino& iPiece = *find(simulation.baseTetrominos, TetrominoType::I);
+		PlacementSearch search{settings};
+		const std::vector<Placement>& placements = search.search(simulation.playfield, iPiece);
+
+		const auto tucked = std::find_if(placements.begin(), placements.end(),
+		    [&](const Placement& placement)
+		    {
+			    const Rect cells = findTrueSize(iPiece.collision(placement.offset.rotation));
+			    return placement.offset.position.x + cells.x == 0 &&
+			           placement.offset.position.y + cells.y == size.height - 1 && cells.width == 4;
+		    });
+		REQUIRE(tucked != placements.end());
+		const PlacementPath path = search.path(*tucked);
+		REQUIRE(std::find(path.begin(), path.end(), PlacementMove::SoftDrop) <
+		        std::find(path.begin(), path.end(), PlacementMove::MoveLeft));
+		REQUIRE(followPath(settings, simulation.playfield, iPiece, path, false) == tucked->offset);
+	}
+	SECTION("blocked spawn")
+	{
+		const Settings settings;
+		Simulation simulation{settings, 1, pieceColors};
+		const Tetromino& tetromino = simulation.baseTetrominos.front();
+		const Rect cells = findTrueSize(tetromino.collision());
+		const XY bottomLeft{cells.x, cells.y + cells.height - 1};
+		simulation.playfield.setAt(tetromino.position + bottomLeft, PieceGrid{{1, 1}, {1}});
+		PlacementSearch search{settings};
+		REQUIRE(search.search(simulation.playfield, tetromino).empty());
+	}
+}
@@ -0,0 +1,97 @@
+#include "playback.hpp"
+
+#include "grid.hpp"
+#include "helpers.hpp"
+#include "input.hpp"
+#include "replay.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+#include "types.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <random>
+
+using namespace raymino;
+using namespace raymino::testing;
+
+namespace
+{
+/**
+ * @brief plays a game with random button presses & returns its recording
+ */
+Replay recordGame(const Settings& settings, uint64_t seed, int frames)
+{
+	Simulation simulation{settings, seed, pieceColors};
+	Replay replay{seed, settings};
+	std::mt19937_64 rng{seed};
+	std::uniform_int_distribution<int> roll{0, 30};
+	for(int frame = 0; frame < frames; ++frame)
+	{
+		InputSnapshot input;
+		if(const int button = roll(rng); button < 7)
+		{
+			input.set(static_cast<InputSnapshot::Button>(1U << static_cast<unsigned>(button)), true, true, false);
+		}
+		replay.record(input);
+		simulation.step(Settings::TICK_SECONDS, input);
+	}
+	return replay;
+}
+} // namespace
+
+TEST_CASE("Playback::advance", "[Playback]")
+{
+	Settings settings;
+	settings.shuffleType = ShuffleType::TGM35;
+	const Replay replay = recordGame(settings, 3, 5000);
+	Playback playback{replay, pieceColors};
+
+	REQUIRE(playback.length() == 5000);
+	REQUIRE(playback.position() == 0);
+	REQUIRE(playback.duration() > 20.8);
+	REQUIRE(playback.duration() < 20.9);
+
+	REQUIRE(playback.advanceTime(1.0) == Settings::TICK_RATE);
+	REQUIRE(playback.advance(40) == 40);
+	REQUIRE(playback.position() == Settings::TICK_RATE + 40);
+	REQUIRE(playback.advance(10000) == 5000 - Settings::TICK_RATE - 40);
+	REQUIRE(playback.isFinished());
+	REQUIRE(playback.advanceTime(1.0) == 0);
+
+	Simulation linear{settings, 3, pieceColors};
+	Replay::Reader reader = replay.reader();
+	InputSnapshot input;
+	while(reader.next(input))
+	{
+		linear.step(Settings::TICK_SECONDS, input);
+	}
+	requireSameGame(playback.simulation(), linear);
+}
+
+TEST_CASE("Playback::seek", "[Playback]")
+{
+	for(const ShuffleType shuffleType : {ShuffleType::SingleBag, ShuffleType::TGM35, ShuffleType::NES})
+	{
+		Settings settings;
+		settings.shuffleType = shuffleType;
+		settings.scoringSystem = ScoringSystem::Guideline;
+		const Replay replay = recordGame(settings, 11, 4000);
+		Playback playback{replay, pieceColors};
+
+		for(const uint32_t target : {3999U, 0U, 1800U, 1799U, 1801U, 600U, 2500U, 12U, 4000U, 5000U, 2U})
+		{
+			playback.seek(target);
+			const uint32_t clamped = std::min(target, replay.info().steps);
+			REQUIRE(playback.position() == clamped);
+
+			Playback linear{replay, pieceColors};
+			linear.advance(clamped);
+			requireSameGame(playback.simulation(), linear.simulation());
+			REQUIRE(playback.elapsed() == linear.elapsed());
+		}
+	}
+}
@@ -0,0 +1,257 @@
+#include "replay.hpp"
+
+#include "grid.hpp"
+#include "helpers.hpp"
+#include "input.hpp"
+#include "savefile.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace raymino;
+using namespace raymino::testing;
+
+namespace
+{
+/**
+ * @brief sparse button changes, some with edges not following from down bits
+ */
+std::vector<InputSnapshot> makeSteps(size_t count, uint64_t seed)
+{
+	std::mt19937_64 rng{seed};
+	std::uniform_int_distribution<int> roll{0, 99};
+	std::vector<InputSnapshot> steps;
+	uint8_t down = 0;
+	for(size_t idx = 0; idx < count; ++idx)
+	{
+		InputSnapshot input{down, 0, 0};
+		const int event = roll(rng);
+		if(event < 5)
+		{
+			const auto button = static_cast<InputSnapshot::Button>(1U << static_cast<unsigned>(roll(rng) % 7));
+			const bool isDown = input.isDown(button);
+			input.down = static_cast<uint8_t>(input.down ^ button);
+			input.pressed = isDown ? 0 : button;
+			input.released = isDown ? button : 0;
+		}
+		else if(event == 5)
+		{
+			input.pressed = static_cast<uint8_t>(roll(rng) & 0x7F);
+		}
+		down = input.down;
+		steps.push_back(input);
+	}
+	return steps;
+}
+
+/**
+ * @brief player like input, one button at a time held for a few ticks, about 4 actions a second
+ */
+std::vector<InputSnapshot> makePlay(size_t count, uint64_t seed)
+{
+	std::mt19937_64 rng{seed};
+	std::uniform_int_distribution<int> buttonRoll{0, 6};
+	std::uniform_int_distribution<size_t> holdRoll{Settings::TICK_RATE / 20, Settings::TICK_RATE / 4};
+	std::uniform_int_distribution<size_t> gapRoll{Settings::TICK_RATE / 30, Settings::TICK_RATE / 6};
+	std::vector<InputSnapshot> steps;
+	steps.reserve(count);
+	while(steps.size() < count)
+	{
+		const auto button = static_cast<InputSnapshot::Button>(1U << static_cast<unsigned>(buttonRoll(rng)));
+		const size_t hold = holdRoll(rng);
+		for(size_t tick = 0; tick < hold && steps.size() < count; ++tick)
+		{
+			steps.push_back(InputSnapshot{button, static_cast<uint8_t>(tick == 0 ? button : 0), 0});
+		}
+		if(steps.size() < count)
+		{
+			steps.push_back(InputSnapshot{0, 0, button});
+		}
+		const size_t gap = gapRoll(rng);
+		for(size_t tick = 0; tick < gap && steps.size() < count; ++tick)
+		{
+			steps.push_back(InputSnapshot{});
+		}
+	}
+	return steps;
+}
+
+void record(Replay& replay, const std::vector<InputSnapshot>& steps)
+{
+	for(const InputSnapshot& input : steps)
+	{
+		replay.record(input);
+	}
+}
+
+void requirePlayback(const Replay& replay, const std::vector<InputSnapshot>& recorded)
+{
+	Replay::Reader reader = replay.reader();
+	InputSnapshot input;
+	for(const InputSnapshot& step : recorded)
+	{
+		REQUIRE(reader.next(input));
+		REQUIRE(input.down == step.down);
+		REQUIRE(input.pressed == step.pressed);
+		REQUIRE(input.released == step.released);
+	}
+	REQUIRE_FALSE(reader.next(input));
+	REQUIRE(reader.position() == recorded.size());
+}
+
+/**
+ * @brief copy of a serialized replay with its Info chunk edited & the last input bytes cut off
+ */
+SaveFile edited(const SaveFile& save, const std::function<void(Replay::Info&)>& editInfo, size_t cutInputBytes = 0)
+{
+	SaveFile copy{3, save.size()};
+	for(const SaveFile::Chunk::Header& chunkHeader : save)
+	{
+		if(chunkHeader.type == Replay::ChunkType::Info)
+		{
+			Replay::Info info = *SaveFile::Chunk::DataRange<const Replay::Info>(chunkHeader).begin();
+			editInfo(info);
+			copy.appendChunkValue(info, chunkHeader.type);
+		}
+		else
+		{
+			const SaveFile::Chunk::DataRange<const uint8_t> range(chunkHeader);
+			const size_t cut = chunkHeader.type == Replay::ChunkType::Inputs ? cutInputBytes : 0;
+			copy.appendChunkRange(range.begin(), range.end() - static_cast<std::ptrdiff_t>(cut), chunkHeader.type);
+		}
+	}
+	return copy;
+}
+} // namespace
+
+TEST_CASE("Replay::record", "[Replay]")
+{
+	Replay replay{42, Settings{}};
+	const std::vector<InputSnapshot> steps = makeSteps(5000, 1);
+	record(replay, steps);
+	REQUIRE(replay.info().steps == steps.size());
+	REQUIRE(replay.info().seed == 42);
+	REQUIRE(replay.info().tickRate == Settings::TICK_RATE);
+	requirePlayback(replay, steps);
+}
+
+TEST_CASE("Replay::serialize/deserialize", "[Replay]")
+{
+	Settings settings;
+	settings.shuffleType = ShuffleType::TGM35;
+	settings.previewCount = 3;
+	Replay replay{1234, settings};
+	const std::vector<InputSnapshot> recorded = makeSteps(2000, 2);
+	record(replay, recorded);
+
+	const Replay loaded = Replay::deserialize(replay.serialize());
+	REQUIRE(loaded.info().seed == 1234);
+	REQUIRE(loaded.info().settings == settings);
+	REQUIRE(loaded.info().steps == recorded.size());
+	REQUIRE(loaded.encodedBytes() == replay.encodedBytes());
+	requirePlayback(loaded, recorded);
+
+	SECTION("recording continues after loading")
+	{
+		Replay continued = Replay::deserialize(replay.serialize());
+		const std::vector<InputSnapshot> more = makeSteps(100, 3);
+		record(continued, more);
+		std::vector<InputSnapshot> moreRecorded = recorded;
+		moreRecorded.insert(moreRecorded.end(), more.begin(), more.end());
+		requirePlayback(continued, moreRecorded);
+	}
+	SECTION("missing & truncated data")
+	{
+		REQUIRE_THROWS_AS(Replay::deserialize(SaveFile{0, 0}), std::runtime_error);
+
+		// the last change of input cut off, the steps claim more changes than encoded
+		REQUIRE_THROWS_AS(Replay::deserialize(edited(replay.serialize(), [](Replay::Info&) {}, 1)), std::range_error);
+	}
+	SECTION("other tick rate")
+	{
+		REQUIRE_THROWS_AS(Replay::deserialize(edited(replay.serialize(),
+		                      [](Replay::Info& info)
+		                      {
+			                      info.tickRate = 60;
+		                      })),
+		    std::runtime_error);
+	}
+}
+
+TEST_CASE("Replay reproduces a Simulation", "[Replay]")
+{
+	Settings settings;
+	settings.holdPiece = true;
+	Simulation original{settings, 99, pieceColors};
+	Replay replay{99, settings};
+	std::mt19937_64 rng{5};
+	std::uniform_int_distribution<int> roll{0, 40};
+	uint8_t down = 0;
+	for(int frame = 0; frame < 20000 && !original.isGameOver; ++frame)
+	{
+		InputSnapshot input{down, 0, 0};
+		if(const int button = roll(rng); button < 7)
+		{
+			const auto pressed = static_cast<InputSnapshot::Button>(1U << static_cast<unsigned>(button));
+			input = InputSnapshot{};
+			input.set(pressed, true, true, false);
+			input.released = static_cast<uint8_t>(down & ~pressed);
+		}
+		else if(button < 14)
+		{
+			input = InputSnapshot{0, 0, down};
+		}
+		down = input.down;
+		replay.record(input);
+		original.step(Settings::TICK_SECONDS, input);
+	}
+
+	const Replay loaded = Replay::deserialize(replay.serialize());
+	Simulation replayed{loaded.info().settings, loaded.info().seed, pieceColors};
+	Replay::Reader reader = loaded.reader();
+	InputSnapshot input;
+	while(reader.next(input))
+	{
+		replayed.step(Settings::TICK_SECONDS, input);
+	}
+	requireSameGame(replayed, original);
+}
+
+TEST_CASE("Replay size of a 10 minute game", "[Replay]")
+{
+	Replay replay{1, Settings{}};
+	const std::vector<InputSnapshot> steps = makePlay(size_t{Settings::TICK_RATE} * 60 * 10, 4);
+	record(replay, steps);
+	requirePlayback(replay, steps);
+
+	// about 2 bytes per press & release, held & idle ticks only extend the runs between them
+	REQUIRE(replay.encodedBytes() < 12 * 1024);
+}
+
+TEST_CASE("Replay records past its reserve", "[Replay]")
+{
+	Replay replay{1, Settings{}};
+	// 20 minutes of steps outgrow the reserved input bytes
+	const std::vector<InputSnapshot> recorded = makeSteps(size_t{Settings::TICK_RATE} * 60 * 20, 5);
+	size_t grown = 0;
+	for(const InputSnapshot& input : recorded)
+	{
+		if(!replay.canRecord())
+		{
+			REQUIRE(replay.reserveAhead());
+			REQUIRE(replay.canRecord());
+			++grown;
+		}
+		replay.record(input);
+	}
+	REQUIRE(grown >= 2);
+	requirePlayback(replay, recorded);
+}
@@ -0,0 +1,83 @@
+#include "rowscan.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+using namespace raymino;
+
+namespace
+{
+constexpr size_t maxCells = 200;
+constexpr size_t maxOffset = 7;
+
+std::array<uint8_t, maxCells + maxOffset> makeCells(uint8_t seed)
+{
+	std::array<uint8_t, maxCells + maxOffset> cells{};
+	uint32_t state = seed + 1U;
+	for(uint8_t& cell : cells)
+	{
+		state = state * 1103515245U + 12345U;
+		cell = static_cast<uint8_t>((state >> 16U) % 3U);
+	}
+	return cells;
+}
+} // namespace
+
+TEST_CASE("rowOccupancyBits", "[rowscan]")
+{
+	for(uint8_t seed = 0; seed < 4; ++seed)
+	{
+		const auto cells = makeCells(seed);
+		for(size_t offset = 0; offset < maxOffset; ++offset)
+		{
+			for(int width = 0; width <= 64; ++width)
+			{
+				uint64_t expected = 0;
+				for(int xPos = 0; xPos < width; ++xPos)
+				{
+					expected |= static_cast<uint64_t>(cells[offset + static_cast<size_t>(xPos)] != 0)
+					            << static_cast<unsigned>(xPos);
+				}
+				REQUIRE(rowOccupancyBits(&cells[offset], width) == expected);
+			}
+		}
+	}
+}
+
+TEST_CASE("allCellsSet/allCellsClear", "[rowscan]")
+{
+	std::array<uint8_t, maxCells + maxOffset> set{};
+	std::array<uint8_t, maxCells + maxOffset> clear{};
+	set.fill(1);
+
+	for(size_t offset = 0; offset < maxOffset; ++offset)
+	{
+		for(size_t count = 0; count <= maxCells; ++count)
+		{
+			REQUIRE(allCellsSet(&set[offset], count));
+			REQUIRE(allCellsClear(&clear[offset], count));
+
+			// flip each position once, the kernels need to see it in the vector body & the scalar tail
+			for(size_t idx = 0; idx < count; ++idx)
+			{
+				set[offset + idx] = 0;
+				clear[offset + idx] = 9;
+				REQUIRE_FALSE(allCellsSet(&set[offset], count));
+				REQUIRE_FALSE(allCellsClear(&clear[offset], count));
+				set[offset + idx] = 1;
+				clear[offset + idx] = 0;
+			}
+		}
+	}
+
+	// cells past count are not looked at
+	set[5] = 0;
+	clear[5] = 1;
+	REQUIRE(allCellsSet(set.data(), 5));
+	REQUIRE(allCellsClear(clear.data(), 5));
+	REQUIRE(std::count(set.begin(), set.end(), 0) == 1);
+}
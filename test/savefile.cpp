@@ -124,6 +124,25 @@ TEST_CASE("SaveFile::appendChunkEmpty", "[SaveFile]")
 	REQUIRE(range.begin() == range.end());
 }
 
+TEST_CASE("SaveFile unaligned chunk sizes", "[SaveFile]")
+{
+	SaveFile save(3, 32);
+	const std::array<uint8_t, 5> bytes{1, 2, 3, 4, 5};
+	save.appendChunkRange(bytes, 1);
+	save.appendChunkValue(uint64_t{1337}, 2);
+	save.appendChunkRange(bytes.begin(), std::next(bytes.begin()), 3);
+
+	REQUIRE(save.size() == sizeof(SaveFile::Header) + (3 * sizeof(SaveFile::Chunk::Header)) + 8 + 8 + 8);
+	std::vector<uint16_t> types;
+	for(const SaveFile::Chunk::Header& header : save)
+	{
+		types.push_back(header.type);
+	}
+	REQUIRE(types == std::vector<uint16_t>{1, 2, 3});
+	const SaveFile::Chunk::DataRange<const uint64_t> range(*++save.begin());
+	REQUIRE(*range.begin() == 1337);
+}
+
 TEST_CASE("SaveFile::appendChunkValue", "[SaveFile]")
 {
 	SaveFile save(2, 16);
@@ -0,0 +1,266 @@
+#include "simulation.hpp"
+
+#include "gameplay.hpp"
+#include "grid.hpp"
+#include "helpers.hpp"
+#include "input.hpp"
+#include "settings.hpp"
+#include "timer.hpp"
+#include "types.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+
+using namespace raymino;
+using namespace raymino::testing;
+
+namespace
+{
+constexpr float FRAME_TIME = 1.0f / 60.0f;
+
+/**
+ * @brief scripted input that moves, rotates & drops pieces in a repeating pattern
+ */
+InputSnapshot scriptedInput(int frame)
+{
+	switch(frame % 12)
+	{
+	case 1:
+		return InputSnapshot::tap((frame / 12) % 2 == 0 ? InputSnapshot::MoveLeft : InputSnapshot::MoveRight);
+	case 4:
+		return InputSnapshot::tap((frame / 24) % 2 == 0 ? InputSnapshot::RotateRight : InputSnapshot::RotateLeft);
+	case 7:
+		return frame % 60 == 7 ? InputSnapshot::tap(InputSnapshot::Hold) : InputSnapshot{};
+	case 10:
+		return InputSnapshot::tap(InputSnapshot::HardDrop);
+	default:
+		return InputSnapshot{};
+	}
+}
+} // namespace
+
+TEST_CASE("Simulation is deterministic", "[Simulation]")
+{
+	for(const ShuffleType shuffleType : {ShuffleType::Random, ShuffleType::SingleBag, ShuffleType::DoubleBag,
+	        ShuffleType::TripleBag, ShuffleType::TGMH4, ShuffleType::TGM35, ShuffleType::NES})
+	{
+		Settings settings;
+		settings.shuffleType = shuffleType;
+		Simulation lhs{settings, 1234, pieceColors};
+		Simulation rhs{settings, 1234, pieceColors};
+
+		REQUIRE(std::equal(lhs.nextTetrominoIndices.begin(), lhs.nextTetrominoIndices.end(),
+		    rhs.nextTetrominoIndices.begin(), rhs.nextTetrominoIndices.end()));
+
+		int frame = 0;
+		for(; frame < 20000 && !lhs.isGameOver; ++frame)
+		{
+			lhs.step(FRAME_TIME, scriptedInput(frame));
+			rhs.step(FRAME_TIME, scriptedInput(frame));
+		}
+		REQUIRE(lhs.isGameOver);
+		requireSameGame(lhs, rhs);
+		REQUIRE(lhs.score > 0);
+
+		// stepping a finished game changes nothing
+		const int64_t finalScore = lhs.score;
+		lhs.step(1.0f, InputSnapshot::tap(InputSnapshot::HardDrop));
+		REQUIRE(lhs.score == finalScore);
+	}
+}
+
+TEST_CASE("Simulation::save", "[Simulation]")
+{
+	for(const ShuffleType shuffleType : {ShuffleType::Random, ShuffleType::TGM35, ShuffleType::NES})
+	{
+		Settings settings;
+		settings.shuffleType = shuffleType;
+		settings.scoringSystem = ScoringSystem::Guideline;
+		Simulation simulation{settings, 99, pieceColors};
+		for(int frame = 0; frame < 120; ++frame)
+		{
+			simulation.step(FRAME_TIME, scriptedInput(frame));
+		}
+		const Simulation::Snapshot snapshot = simulation.save();
+		const Simulation saved{simulation};
+		REQUIRE_FALSE(saved.isGameOver);
+
+		for(int frame = 120; frame < 360; ++frame)
+		{
+			simulation.step(FRAME_TIME, scriptedInput(frame));
+		}
+		const Simulation played{simulation};
+		REQUIRE_FALSE(simulation.playfield == saved.playfield);
+
+		simulation.restore(snapshot);
+		REQUIRE(simulation.playfield == saved.playfield);
+		REQUIRE(simulation.score == saved.score);
+		REQUIRE(simulation.lockedPieces == saved.lockedPieces);
+		for(int frame = 120; frame < 360; ++frame)
+		{
+			simulation.step(FRAME_TIME, scriptedInput(frame));
+		}
+		requireSameGame(simulation, played);
+		REQUIRE(simulation.lineClears == played.lineClears);
+		for(int yPos = 0; yPos < simulation.playfield.getSize().height; ++yPos)
+		{
+			REQUIRE(simulation.playfield.getRowBits(yPos) == played.playfield.getRowBits(yPos));
+		}
+	}
+	{
+		Settings settings;
+		settings.fieldWidth = Settings::MAX_FIELD_WIDTH + 1;
+		REQUIRE_THROWS_AS((Simulation{settings, 1, pieceColors}), std::length_error);
+	}
+}
+
+TEST_CASE("Simulation::queueGarbage", "[Simulation]")
+{
+	const Settings settings;
+	Simulation simulation{settings, 3, pieceColors, 9};
+	InputSnapshot drop;
+	drop.set(InputSnapshot::HardDrop, true, true, false);
+
+	simulation.queueGarbage(3);
+	simulation.step(FRAME_TIME, drop);
+	REQUIRE(simulation.pendingGarbage == 0);
+	const Size size = simulation.playfield.getSize();
+	for(int yPos = size.height - 3; yPos < size.height; ++yPos)
+	{
+		int gaps = 0;
+		for(int xPos = 0; xPos < size.width; ++xPos)
+		{
+			gaps += simulation.playfield.getAt({xPos, yPos}) == 0 ? 1 : 0;
+		}
+		REQUIRE(gaps == 1);
+	}
+	REQUIRE_FALSE(simulation.isGameOver);
+
+	simulation.queueGarbage(static_cast<uint32_t>(size.height));
+	simulation.step(FRAME_TIME, drop);
+	REQUIRE(simulation.isGameOver);
+}
+
+TEST_CASE("Simulation::positionHash", "[Simulation]")
+{
+	const Settings settings;
+	Simulation simulation{settings, 5, pieceColors};
+	const uint64_t spawned = simulation.positionHash();
+	REQUIRE(spawned == Simulation{settings, 5, pieceColors}.positionHash());
+
+	simulation.step(FRAME_TIME, InputSnapshot::tap(InputSnapshot::MoveLeft));
+	simulation.step(FRAME_TIME, InputSnapshot{});
+	REQUIRE(simulation.positionHash() != spawned);
+	simulation.step(FRAME_TIME, InputSnapshot::tap(InputSnapshot::MoveRight));
+	simulation.step(FRAME_TIME, InputSnapshot{});
+	REQUIRE(simulation.positionHash() == spawned);
+
+	const Simulation::Snapshot snapshot = simulation.save();
+	simulation.step(FRAME_TIME, InputSnapshot::tap(InputSnapshot::Hold));
+	const uint64_t held = simulation.positionHash();
+	REQUIRE(held != spawned);
+	simulation.step(FRAME_TIME, InputSnapshot{});
+	simulation.step(FRAME_TIME, InputSnapshot::tap(InputSnapshot::HardDrop));
+	REQUIRE(simulation.positionHash() != held);
+
+	simulation.restore(snapshot);
+	REQUIRE(simulation.positionHash() == spawned);
+}
+
+TEST_CASE("Simulation rule policies", "[Simulation]")
+{
+	for(const RotationSystem rotationSystem : {RotationSystem::Original, RotationSystem::Super, RotationSystem::Arika,
+	        RotationSystem::Sega, RotationSystem::NintendoLeft, RotationSystem::NintendoRight})
+	{
+		for(const WallKicks wallKicks : {WallKicks::None, WallKicks::Arika, WallKicks::Super})
+		{
+			Settings settings;
+			settings.rotationSystem = rotationSystem;
+			settings.wallKicks = wallKicks;
+			Simulation simulation{settings, 7, pieceColors};
+			const Tetromino first = simulation.currentTetromino;
+
+			simulation.step(0, InputSnapshot::tap(InputSnapshot::RotateRight));
+			Tetromino expected = first;
+			expected += basicRotation(rotationSystem)(first, 1);
+			REQUIRE(simulation.currentTetromino.position == expected.position);
+			REQUIRE(simulation.currentTetromino.collision() == expected.collision());
+		}
+	}
+}
+
+TEST_CASE("Timer::step", "[Simulation]")
+{
+	Timer timer{0.25f};
+	REQUIRE(timer.step(0.2f) == 0);
+	REQUIRE(timer.step(0.1f) == 1);
+	REQUIRE(timer.step(1.2f) == 5);
+	REQUIRE(timer.elapsed >= 0);
+	REQUIRE(timer.elapsed < timer.delay);
+
+	Timer fastest{DELAYS.back()};
+	REQUIRE(fastest.step(1.0f / 60) == 20);
+	for(int frame = 0; frame < 59; ++frame)
+	{
+		REQUIRE(fastest.step(1.0f / 60) >= 19);
+	}
+	REQUIRE(fastest.elapsed >= 0);
+	REQUIRE(fastest.elapsed < fastest.delay);
+}
+
+TEST_CASE("Simulation::step", "[Simulation]")
+{
+	const Settings settings;
+	Simulation simulation{settings, 42, pieceColors};
+	const Tetromino first = simulation.currentTetromino;
+
+	SECTION("gravity")
+	{
+		simulation.step(1.0f, InputSnapshot{});
+		REQUIRE(simulation.currentTetromino.position.y > first.position.y);
+		REQUIRE(isEmpty(simulation.playfield));
+	}
+	SECTION("multi row gravity")
+	{
+		simulation.levelState.currentLevel = 20;
+		simulation.step(DELAYS[20] * 10.5f, InputSnapshot{});
+		REQUIRE(simulation.currentTetromino.position == first.position + XY{0, 10});
+		REQUIRE(simulation.gravity.elapsed < simulation.gravity.delay);
+	}
+	SECTION("20G")
+	{
+		simulation.levelState.currentLevel = MAX_SPEED_LEVEL;
+		simulation.step(0, InputSnapshot::tap(InputSnapshot::MoveLeft));
+		const Tetromino& current = simulation.currentTetromino;
+		REQUIRE(current.position.x == first.position.x - 1);
+		REQUIRE(simulation.playfield.dropDistance(current.position, current.collision()) == 0);
+		REQUIRE(isEmpty(simulation.playfield));
+	}
+	SECTION("move")
+	{
+		simulation.step(FRAME_TIME, InputSnapshot::tap(InputSnapshot::MoveLeft));
+		REQUIRE(simulation.currentTetromino.position == first.position - XY{1, 0});
+	}
+	SECTION("hard drop")
+	{
+		simulation.step(FRAME_TIME, InputSnapshot::tap(InputSnapshot::HardDrop));
+		REQUIRE_FALSE(isEmpty(simulation.playfield));
+		REQUIRE(simulation.score > 0);
+		REQUIRE(simulation.playfield.getAt({first.position.x + 1, simulation.playfield.getSize().height - 1}) ==
+		        pieceColors[static_cast<size_t>(first.type)]);
+	}
+	SECTION("hold")
+	{
+		simulation.step(FRAME_TIME, InputSnapshot::tap(InputSnapshot::Hold));
+		REQUIRE(simulation.holdPieceIdx == static_cast<size_t>(first.type));
+		const Tetromino second = simulation.currentTetromino;
+
+		simulation.step(FRAME_TIME, InputSnapshot::tap(InputSnapshot::Hold));
+		REQUIRE(simulation.holdPieceIdx == static_cast<size_t>(first.type));
+		REQUIRE(simulation.currentTetromino.type == second.type);
+	}
+}
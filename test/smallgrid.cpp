@@ -0,0 +1,102 @@
+#include "smallgrid.hpp"
+
+#include "grid.hpp"
+#include "ostream.hpp" //! needs to be included before catch
+#include "types.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+using namespace raymino;
+
+TEST_CASE("SmallGrid(Size,Cell)", "[SmallGrid]")
+{
+	const Size size{2, 3};
+	const PieceGrid::Cell fill = 7;
+
+	const PieceGrid grid(size, fill);
+
+	STATIC_REQUIRE(std::is_trivially_copyable_v<PieceGrid>);
+	REQUIRE(grid.isSquare() == false);
+	REQUIRE(grid.getSize() == size);
+	REQUIRE(std::count(grid.begin(), grid.end(), fill) == static_cast<ptrdiff_t>(size.area()));
+	REQUIRE(grid.getRowBits(2) == 0b11);
+
+	CHECK_THROWS(PieceGrid({5, 1}, fill));
+}
+
+TEST_CASE("SmallGrid(Size,initializer_list)", "[SmallGrid]")
+{
+	const PieceGrid grid({3, 2}, {1, 2, 3, 4, 0, 6});
+
+	REQUIRE(grid.getAt({0, 0}) == 1);
+	REQUIRE(grid.getAt({2, 1}) == 6);
+	REQUIRE(grid.getAt({3, 1}) == PieceGrid::oobVal);
+	REQUIRE(grid.getAt({0, -1}, 0) == 0);
+	REQUIRE(grid.getRowBits(1) == 0b101);
+	REQUIRE(grid.getRowBits(2) == 0);
+
+	CHECK_THROWS(PieceGrid({4, 2}, {1, 2, 3}));
+}
+
+TEST_CASE("SmallGrid::rotate", "[SmallGrid]")
+{
+	PieceGrid grid({3, 2}, {1, 2, 3, 4, 5, 6});
+
+	grid.rotate(1);
+	REQUIRE(grid == PieceGrid{{2, 3}, {4, 1, 5, 2, 6, 3}});
+
+	grid.rotate(-1);
+	REQUIRE(grid == PieceGrid{{3, 2}, {1, 2, 3, 4, 5, 6}});
+
+	grid.rotate(2);
+	REQUIRE(grid == PieceGrid{{3, 2}, {6, 5, 4, 3, 2, 1}});
+}
+
+TEST_CASE("SmallGrid::recolor", "[SmallGrid]")
+{
+	PieceGrid grid({2, 2}, {0, 1, 1, 0});
+
+	grid.recolor(5);
+	REQUIRE(grid == PieceGrid{{2, 2}, {0, 5, 5, 0}});
+	REQUIRE(grid.getRowBits(1) == 0b01);
+
+	grid.recolor(0);
+	REQUIRE(grid == PieceGrid{{2, 2}, 0});
+	REQUIRE(grid.getRowBits(0) == 0);
+
+	grid.fill(3);
+	REQUIRE(grid.getRowBits(1) == 0b11);
+}
+
+TEST_CASE("SmallGrid matches Grid", "[SmallGrid]")
+{
+	const std::vector<Grid::Cell> cells{0, 1, 0, 1, 1, 1, 0, 0, 0};
+	Grid grid({3, 3}, cells);
+	PieceGrid piece({3, 3}, {0, 1, 0, 1, 1, 1, 0, 0, 0});
+	const Grid field({4, 4}, {0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 0, 1});
+
+	for(int steps = 0; steps < 4; ++steps)
+	{
+		for(int yPos = -1; yPos < 4; ++yPos)
+		{
+			for(int xPos = -2; xPos < 4; ++xPos)
+			{
+				REQUIRE(field.overlapAt({xPos, yPos}, piece) == field.overlapAt({xPos, yPos}, grid));
+
+				Grid placedGrid{field};
+				Grid placedPiece{field};
+				placedGrid.setAt({xPos, yPos}, grid);
+				placedPiece.setAt({xPos, yPos}, piece);
+				REQUIRE(placedPiece == placedGrid);
+			}
+		}
+		REQUIRE(std::equal(piece.begin(), piece.end(), grid.begin(), grid.end()));
+		grid.rotate(1);
+		piece.rotate(1);
+	}
+}
@@ -0,0 +1,79 @@
+#include "threadpool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace raymino;
+
+TEST_CASE("ThreadPool::parallelFor", "[ThreadPool]")
+{
+	ThreadPool pool{4};
+	REQUIRE(pool.size() == 4);
+
+	for(const size_t grain : {size_t{0}, size_t{1}, size_t{7}, size_t{5000}})
+	{
+		std::vector<size_t> results(1000, 0);
+		pool.parallelFor(results.size(), grain,
+		    [&results](size_t index)
+		    {
+			    results[index] += index * 2;
+		    });
+		std::vector<size_t> expected(results.size());
+		std::iota(expected.begin(), expected.end(), size_t{0});
+		for(size_t& value : expected)
+		{
+			value *= 2;
+		}
+		REQUIRE(results == expected);
+	}
+
+	pool.parallelFor(0, 0,
+	    []([[maybe_unused]] size_t index)
+	    {
+		    FAIL("no indices to run");
+	    });
+}
+
+TEST_CASE("ThreadPool::submit", "[ThreadPool]")
+{
+	ThreadPool pool{3};
+	std::atomic<size_t> sum{0};
+
+	// tasks queueing more tasks, these get stolen by the idle workers
+	for(size_t outer = 0; outer < 10; ++outer)
+	{
+		pool.submit(
+		    [&pool, &sum]
+		    {
+			    for(size_t inner = 0; inner < 10; ++inner)
+			    {
+				    pool.submit(
+				        [&sum]
+				        {
+					        sum += 1;
+				        });
+			    }
+		    });
+	}
+	pool.wait();
+	REQUIRE(sum == 100);
+
+	pool.submit(
+	    []
+	    {
+		    throw std::runtime_error("task failed");
+	    });
+	pool.submit(
+	    [&sum]
+	    {
+		    sum += 1;
+	    });
+	REQUIRE_THROWS_AS(pool.wait(), std::runtime_error);
+	REQUIRE(sum == 101);
+	REQUIRE_NOTHROW(pool.wait());
+}
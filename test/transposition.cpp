@@ -0,0 +1,60 @@
+#include "transposition.hpp"
+
+#include "threadpool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+using namespace raymino;
+
+TEST_CASE("TranspositionTable", "[TranspositionTable]")
+{
+	TranspositionTable<float> table{1000};
+	REQUIRE(table.capacity() == 1024);
+	REQUIRE_FALSE(table.find(0).has_value());
+	REQUIRE_FALSE(table.find(42).has_value());
+
+	table.store(0, 1.5f);
+	table.store(42, -2.0f);
+	REQUIRE(table.find(0) == std::optional{1.5f});
+	REQUIRE(table.find(42) == std::optional{-2.0f});
+	// same slot, the later store replaces the earlier one
+	table.store(42 + 1024, 3.0f);
+	REQUIRE_FALSE(table.find(42).has_value());
+	REQUIRE(table.find(42 + 1024) == std::optional{3.0f});
+
+	table.clear();
+	REQUIRE_FALSE(table.find(0).has_value());
+	REQUIRE_FALSE(table.find(42 + 1024).has_value());
+}
+
+TEST_CASE("TranspositionTable concurrent stores", "[TranspositionTable]")
+{
+	// few slots & many keys, so workers keep overwriting the slots others read
+	TranspositionTable<uint32_t> table{16};
+	const auto valueOf = [](uint64_t key)
+	{
+		return static_cast<uint32_t>((key * 2654435761U) >> 7U);
+	};
+	std::atomic<size_t> mismatches{0};
+	ThreadPool pool{4};
+	pool.parallelFor(4, 1,
+	    [&](size_t worker)
+	    {
+		    for(uint64_t round = 0; round < 20000; ++round)
+		    {
+			    const uint64_t key = (round * 4) + worker;
+			    table.store(key, valueOf(key));
+			    const uint64_t other = key ^ 5U;
+			    if(const std::optional<uint32_t> found = table.find(other); found && *found != valueOf(other))
+			    {
+				    ++mismatches;
+			    }
+		    }
+	    });
+	REQUIRE(mismatches == 0);
+}
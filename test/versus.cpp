@@ -0,0 +1,131 @@
+#include "versus.hpp"
+
+#include "helpers.hpp"
+#include "input.hpp"
+#include "settings.hpp"
+#include "simulation.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <random>
+
+using namespace raymino;
+using namespace raymino::testing;
+
+namespace
+{
+/**
+ * @brief random buttons, held for a while so predictions are right some of the time
+ */
+InputSnapshot randomInput(std::mt19937_64& rng, InputSnapshot previous)
+{
+	std::uniform_int_distribution<int> roll{0, 40};
+	InputSnapshot input;
+	input.down = previous.down;
+	if(const int button = roll(rng); button < 7)
+	{
+		const auto pressed = static_cast<InputSnapshot::Button>(1U << static_cast<unsigned>(button));
+		input.set(pressed, true, true, false);
+	}
+	else if(button < 10)
+	{
+		input.released = input.down;
+		input.down = 0;
+	}
+	return input;
+}
+} // namespace
+
+TEST_CASE("VersusSession rollback", "[VersusSession]")
+{
+	constexpr uint32_t LATENCY = 24;
+	constexpr uint32_t TICKS = 4000;
+	const Settings settings;
+	VersusSession immediate{settings, 5, 2, pieceColors, 9};
+	VersusSession delayed{settings, 5, 2, pieceColors, 9};
+	LoopbackTransport transport{LATENCY};
+	std::mt19937_64 rng{17};
+	InputSnapshot first;
+	InputSnapshot second;
+	uint32_t maxResimulated = 0;
+
+	for(uint32_t tick = 0; tick <= TICKS; ++tick)
+	{
+		first = randomInput(rng, first);
+		second = randomInput(rng, second);
+		REQUIRE(immediate.addInput(0, tick, first));
+		REQUIRE(immediate.addInput(1, tick, second));
+		REQUIRE(immediate.advance());
+
+		REQUIRE(delayed.addInput(0, tick, first));
+		transport.send({1, tick, second});
+		// everything still in flight arrives before the last tick
+		const uint32_t now = tick == TICKS ? tick + LATENCY : tick;
+		LoopbackTransport::Packet packet{};
+		while(transport.receive(now, packet))
+		{
+			REQUIRE(delayed.addInput(packet.player, packet.tick, packet.input));
+		}
+		REQUIRE_FALSE(delayed.isStalled());
+		REQUIRE(delayed.advance());
+		maxResimulated = std::max(maxResimulated, delayed.resimulatedTicks());
+	}
+
+	REQUIRE(maxResimulated >= LATENCY);
+	REQUIRE(immediate.tick() == delayed.tick());
+	for(size_t player = 0; player < 2; ++player)
+	{
+		requireSameGame(immediate.player(player), delayed.player(player));
+	}
+	REQUIRE(immediate.player(0).lockedPieces > 10);
+}
+
+TEST_CASE("VersusSession stalls", "[VersusSession]")
+{
+	VersusSession session{Settings{}, 1, 2, pieceColors, 9};
+
+	REQUIRE_FALSE(session.addInput(0, 1, InputSnapshot{}));
+	REQUIRE_FALSE(session.addInput(2, 0, InputSnapshot{}));
+	for(uint32_t tick = 0; tick < VersusSession::ROLLBACK_TICKS; ++tick)
+	{
+		REQUIRE(session.addInput(0, tick, InputSnapshot{}));
+		REQUIRE(session.advance());
+	}
+	REQUIRE(session.isStalled());
+	REQUIRE_FALSE(session.advance());
+	REQUIRE(session.tick() == VersusSession::ROLLBACK_TICKS);
+	REQUIRE_FALSE(session.addInput(1, VersusSession::ROLLBACK_TICKS * 2, InputSnapshot{}));
+
+	REQUIRE(session.addInput(1, 0, InputSnapshot{}));
+	REQUIRE_FALSE(session.isStalled());
+	REQUIRE_FALSE(session.isFinished());
+}
+
+TEST_CASE("VersusSession finishes with late inputs", "[VersusSession]")
+{
+	constexpr uint32_t LATENCY = 24;
+	VersusSession session{Settings{}, 3, 2, pieceColors, 9};
+	LoopbackTransport transport{LATENCY};
+	InputSnapshot hardDrop;
+	hardDrop.set(InputSnapshot::HardDrop, true, true, false);
+
+	// the second player hard drops every other tick & tops out long before gravity stacks up the first one
+	for(uint32_t tick = 0; tick < Settings::TICK_RATE * 60 && !session.isFinished(); ++tick)
+	{
+		LoopbackTransport::Packet packet{};
+		while(transport.receive(tick, packet))
+		{
+			REQUIRE(session.addInput(packet.player, packet.tick, packet.input));
+		}
+		REQUIRE(session.addInput(0, tick, InputSnapshot{}));
+		transport.send({1, tick, tick % 2 == 0 ? hardDrop : InputSnapshot{}});
+		REQUIRE(session.advance());
+	}
+
+	REQUIRE(session.isFinished());
+	REQUIRE(session.winner() == 0);
+	REQUIRE(session.player(1).isGameOver);
+	REQUIRE_FALSE(session.player(0).isGameOver);
+	REQUIRE(session.confirmedTick(1) < session.tick());
+}